@@ -28,6 +28,7 @@
 #include "nas_ndi_1d_bridge.h"
 #include "interface/nas_interface_vxlan.h"
 #include "bridge/nas_interface_bridge_com.h"
+#include "bridge/nas_interface_bridge_flood.h"
 
 #include <iostream>
 #include <map>
@@ -37,21 +38,17 @@
 #include <stdlib.h>
 
 #define DEFAULT_UNTAGGED_VLAN_ID 1
-#define INVALID_L2MC_GROUP_ID ((ndi_obj_id_t) ~0x0)
 class NAS_DOT1D_BRIDGE : public NAS_BRIDGE {
     private:
          nas_bridge_id_t bridge_id; /*  .1D bridge ID created in the NPU */
-         ndi_obj_id_t    uc_l2mc_group_id; /*  L2MC group created for the .1D bridge */
-         ndi_obj_id_t    mc_l2mc_group_id; /*  L2MC group created for the .1D bridge */
-         ndi_obj_id_t    bc_l2mc_group_id; /*  L2MC group created for the .1D bridge */
+         NAS_BRIDGE_FLOOD_GROUPS flood_groups; /*  L2MC flood groups created for the .1D bridge */
+         bool            flood_deferred;  /*  Remote endpoint flooding is staged, flushed by the caller */
 
          memberlist_t    _vxlan_members;
-         using l2mc_member_map = std::unordered_set<ndi_obj_id_t>;
-         l2mc_member_map uc_l2mc_members;
-         l2mc_member_map mc_l2mc_members;
-         l2mc_member_map bc_l2mc_members;
          hal_vlan_id_t   untagged_vlan_id;
 
+         t_std_error nas_bridge_stage_remote_endpoint_flooding(remote_endpoint_t *rm_endpoint);
+
     public:
         /** Constructor */
         NAS_DOT1D_BRIDGE(std::string name,
@@ -61,10 +58,8 @@ class NAS_DOT1D_BRIDGE : public NAS_BRIDGE {
                                                            idx)
                                                            {
                                                                bridge_id = NAS_INVALID_BRIDGE_ID;
-                                                               uc_l2mc_group_id = INVALID_L2MC_GROUP_ID;
-                                                               mc_l2mc_group_id = INVALID_L2MC_GROUP_ID;
-                                                               bc_l2mc_group_id = INVALID_L2MC_GROUP_ID;
                                                                untagged_vlan_id = DEFAULT_UNTAGGED_VLAN_ID;
+                                                               flood_deferred = false;
                                                             }
         virtual ~NAS_DOT1D_BRIDGE(){}
         t_std_error nas_bridge_npu_create();
@@ -91,7 +86,7 @@ class NAS_DOT1D_BRIDGE : public NAS_BRIDGE {
         t_std_error nas_bridge_set_flooding(remote_endpoint_t *rm_endpoint); /* Sets flooding in NPU */
 
         nas_bridge_id_t bridge_id_get(void) {return bridge_id;}
-        ndi_obj_id_t l2mc_group_id_get(void) {return uc_l2mc_group_id;}
+        ndi_obj_id_t l2mc_group_id_get(void) {return flood_groups.uc_group_get();}
         t_std_error nas_bridge_set_learning_disable(bool disable);
         void nas_bridge_untagged_vlan_id_set(hal_vlan_id_t untagged_vlan) { untagged_vlan_id = untagged_vlan;}
 
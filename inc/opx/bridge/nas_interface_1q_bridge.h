@@ -35,6 +35,7 @@
 #include <iostream>
 #include <map>
 #include <string>
+#include <vector>
 #include <stdlib.h>
 
 #define MIN_VLAN_ID         1
@@ -42,6 +43,16 @@
 #define SYSTEM_DEFAULT_VLAN 1
 #define NAS_VLAN_ID_INVALID 0
 
+/*  Members of one list update grouped by NPU target, each group is programmed in one call */
+typedef struct nas_bridge_npu_batch_s {
+    std::vector<const std::string *> names;         /* NPU members, in step with intfs */
+    std::vector<NAS_INTERFACE *> objs;
+    std::vector<interface_ctrl_t> intfs;
+    std::map<npu_id_t, std::vector<ndi_port_t>> ports;
+    std::vector<ndi_obj_id_t> lags;
+    std::vector<const std::string *> kernel_only;   /* Management members */
+} nas_bridge_npu_batch_t;
+
 class NAS_DOT1Q_BRIDGE : public NAS_BRIDGE {
 
     public:
@@ -66,10 +77,21 @@ class NAS_DOT1Q_BRIDGE : public NAS_BRIDGE {
         t_std_error nas_bridge_npu_update_all_untagged_members(void);
         t_std_error nas_bridge_intf_cntrl_block_register(hal_intf_reg_op_type_t op);
         cps_api_return_code_t nas_bridge_fill_info(cps_api_object_t obj);
+        cps_api_return_code_t nas_bridge_fill_summary(cps_api_object_t obj);
         void nas_bridge_vlan_id_set(hal_vlan_id_t vlan_id) { bridge_vlan_id = vlan_id;}
         hal_vlan_id_t nas_bridge_vlan_id_get(void) {return bridge_vlan_id;}
         BASE_IF_VLAN_TYPE_t nas_bridge_sub_type_get(void) { return bridge_sub_type;}
         void nas_bridge_sub_type_set(BASE_IF_VLAN_TYPE_t type ) {bridge_sub_type = type;}
         t_std_error nas_bridge_set_learning_disable(bool disable);
+
+    private:
+        void nas_bridge_npu_add_untagged_port_list(npu_id_t npu, std::vector<interface_ctrl_t> &members);
+        void nas_bridge_npu_add_untagged_lag_list(std::vector<interface_ctrl_t> &members);
+        t_std_error nas_bridge_add_remove_each_member(memberlist_t & m_list, nas_port_mode_t port_mode, bool add);
+        t_std_error nas_bridge_npu_batch_get(memberlist_t & m_list, nas_port_mode_t port_mode,
+                                             nas_bridge_npu_batch_t &batch);
+        t_std_error nas_bridge_npu_batch_apply(nas_bridge_npu_batch_t &batch, nas_port_mode_t port_mode, bool add);
+        void nas_bridge_npu_batch_masters_update(nas_bridge_npu_batch_t &batch, nas_port_mode_t port_mode, bool add);
+        void nas_bridge_npu_batch_finish(nas_bridge_npu_batch_t &batch, nas_port_mode_t port_mode, bool add);
 };
 #endif /* _NAS_INTERFACE_1Q_BRIDGE_H */
@@ -40,6 +40,7 @@
 #include "nas_ndi_vlan.h"
 #include "nas_ndi_lag.h"
 #include "nas_ndi_port.h"
+#include "interface/nas_interface_id.h"
 
 #include <stdint.h>
 #include <iostream>
@@ -50,6 +51,8 @@
 #include <unordered_set>
 
 typedef std::unordered_set<std::string> memberlist_t;
+/* Bridge membership is stored as interned interface ids */
+typedef nas_intf_id_set member_id_list_t;
 
 typedef enum {
     BRIDGE_MODEL,
@@ -80,9 +83,9 @@ class NAS_BRIDGE {
 
         hal_ifindex_t         if_index;
         npu_id_t              npu_id;
-        memberlist_t          tagged_members;
-        memberlist_t          untagged_members;
-        memberlist_t          attached_vlans;
+        member_id_list_t      tagged_members;
+        member_id_list_t      untagged_members;
+        member_id_list_t      attached_vlans;
         std::string           bridge_name;
         std::string           parent_bridge; // In case if this is created as vlan bridge then it can be attached to
                                              /// parent bridge along with all its members.
@@ -110,8 +113,12 @@ class NAS_BRIDGE {
         virtual t_std_error nas_bridge_npu_add_remove_member(std::string &mem_name, nas_int_type_t mem_type, bool add_member) = 0;
         virtual t_std_error nas_bridge_intf_cntrl_block_register(hal_intf_reg_op_type_t op) = 0;
         virtual cps_api_return_code_t nas_bridge_fill_info(cps_api_object_t obj) = 0;
+        /* Same as nas_bridge_fill_info without the member lists */
+        virtual cps_api_return_code_t nas_bridge_fill_summary(cps_api_object_t obj) {
+            return nas_bridge_fill_com_info(obj, false);
+        }
         virtual t_std_error nas_bridge_associate_npu_port(std::string &mem_name, ndi_port_t *port, nas_port_mode_t port_mode, bool associate) = 0;
-        void nas_bridge_for_each_member(std::function <void (std::string mem_name, nas_port_mode_t port_mode)> fn);
+        void nas_bridge_for_each_member(std::function <void (const std::string &mem_name, nas_port_mode_t port_mode)> fn);
         bool nas_bridge_multiple_vlans_present(void);
         bool nas_bridge_tagged_member_present(void);
         bool nas_bridge_untagged_member_present(void);
@@ -119,18 +126,18 @@ class NAS_BRIDGE {
         t_std_error nas_bridge_update_member_list(memberlist_t &memlist, nas_port_mode_t port_mode, bool add_member);
         t_std_error nas_bridge_get_member_list(nas_port_mode_t port_mode, memberlist_t &m_list);
         t_std_error nas_bridge_memberlist_clear(void) { tagged_members.clear(); untagged_members.clear(); return STD_ERR_OK;}
-        t_std_error nas_bridge_check_tagged_membership(std::string mem_name, bool *present);
-        t_std_error nas_bridge_check_untagged_membership(std::string mem_name, bool *present);
-        t_std_error nas_bridge_check_membership(std::string mem_name, bool *present);
-        t_std_error nas_bridge_add_vlan_in_attached_list(std::string mem_name);
-        t_std_error nas_bridge_add_tagged_member_in_list(std::string mem_name);
-        t_std_error nas_bridge_add_untagged_member_in_list(std::string mem_name);
-        t_std_error nas_bridge_remove_vlan_member_from_attached_list(std::string mem_name);
-        t_std_error nas_bridge_remove_tagged_member_from_list(std::string mem_name);
-        t_std_error nas_bridge_remove_untagged_member_from_list(std::string mem_name);
+        t_std_error nas_bridge_check_tagged_membership(const std::string &mem_name, bool *present);
+        t_std_error nas_bridge_check_untagged_membership(const std::string &mem_name, bool *present);
+        t_std_error nas_bridge_check_membership(const std::string &mem_name, bool *present);
+        t_std_error nas_bridge_add_vlan_in_attached_list(const std::string &mem_name);
+        t_std_error nas_bridge_add_tagged_member_in_list(const std::string &mem_name);
+        t_std_error nas_bridge_add_untagged_member_in_list(const std::string &mem_name);
+        t_std_error nas_bridge_remove_vlan_member_from_attached_list(const std::string &mem_name);
+        t_std_error nas_bridge_remove_tagged_member_from_list(const std::string &mem_name);
+        t_std_error nas_bridge_remove_untagged_member_from_list(const std::string &mem_name);
         t_std_error nas_bridge_set_tag_untag_drop(hal_ifindex_t ifx, ndi_port_t *port); /* For ethernet port */
         t_std_error nas_bridge_set_lag_tag_untag_drop(npu_id_t npu_id, ndi_obj_id_t lag_id ,hal_ifindex_t ifx);
-        cps_api_return_code_t nas_bridge_fill_com_info(cps_api_object_t obj);
+        cps_api_return_code_t nas_bridge_fill_com_info(cps_api_object_t obj, bool with_members = true);
 
 
         bool is_source_cps (void) { return source_cps;}
@@ -161,19 +168,20 @@ class NAS_BRIDGE {
         }
         void nas_bridge_publish_event(cps_api_operation_types_t op);
         void nas_bridge_publish_member_event(std::string &mem_name, cps_api_operation_types_t op);
-        void nas_bridge_publish_memberlist_event(memberlist_t &memlist, cps_api_operation_types_t op);
+        void nas_bridge_publish_memberlist_event(const memberlist_t &memlist, cps_api_operation_types_t op);
         t_std_error nas_bridge_add_member_in_os(std::string & mem_name);
         t_std_error nas_bridge_remove_member_from_os(std::string & mem_name);
         t_std_error nas_bridge_set_attribute(cps_api_object_t obj,cps_api_object_it_t & it);
         t_std_error nas_bridge_os_add_remove_member(std::string & mem_name, nas_port_mode_t port_mode, bool add);
-        t_std_error nas_bridge_os_add_remove_memberlist(memberlist_t & memlist, nas_port_mode_t port_mode, bool add);
+        t_std_error nas_bridge_os_add_remove_memberlist(const memberlist_t & memlist, nas_port_mode_t port_mode, bool add);
 
     private:
+        t_std_error nas_bridge_os_member_obj_fill(cps_api_object_t obj, const std::string &mem_name, nas_port_mode_t port_mode);
         t_std_error nas_bridge_set_admin_status(cps_api_object_t obj, cps_api_object_it_t & it);
         t_std_error nas_bridge_set_mac_address(cps_api_object_t obj, cps_api_object_it_t & it);
         t_std_error nas_bridge_set_mtu(cps_api_object_t obj, cps_api_object_it_t & it);
-        cps_api_return_code_t nas_bridge_fill_bridge_model_com_info(cps_api_object_t obj);
-        cps_api_return_code_t nas_bridge_fill_vlan_intf_model_com_info(cps_api_object_t obj);
+        cps_api_return_code_t nas_bridge_fill_bridge_model_com_info(cps_api_object_t obj, bool with_members);
+        cps_api_return_code_t nas_bridge_fill_vlan_intf_model_com_info(cps_api_object_t obj, bool with_members);
 
 };
 
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+
+/*
+ * filename: nas_interface_bridge_flood.h
+ */
+
+#ifndef _NAS_INTERFACE_BRIDGE_FLOOD_H
+#define _NAS_INTERFACE_BRIDGE_FLOOD_H
+
+#include "ds_common_types.h"
+#include "hal_if_mapping.h"
+#include "std_error_codes.h"
+#include "nas_ndi_common.h"
+#include "nas_ndi_1d_bridge.h"
+
+#include <stdint.h>
+#include <map>
+#include <set>
+
+#define INVALID_L2MC_GROUP_ID ((ndi_obj_id_t) ~0x0)
+
+/*  Flood group flags. Multicast and broadcast flooding always share one group */
+#define NAS_FLOOD_GRP_UC  0x1
+#define NAS_FLOOD_GRP_MC  0x2
+
+typedef enum {
+    NAS_FLOOD_MEM_PORT,
+    NAS_FLOOD_MEM_LAG,
+    NAS_FLOOD_MEM_TUNNEL,
+} nas_flood_mem_type_t;
+
+/*
+ * Flood group membership of a .1D bridge. Callers stage the desired groups of each sub-port,
+ * LAG sub-port or tunnel and flush once; only the difference against what is programmed is
+ * sent to the NPU. While every member floods both unicast and multicast, unknown unicast is
+ * pointed at the multicast group and unicast group additions are deferred, so converging a
+ * bridge with many remote VTEPs programs one group instead of two. When the sets diverge the
+ * unicast group is brought up to date and unknown unicast is pointed back at it.
+ */
+class NAS_BRIDGE_FLOOD_GROUPS {
+        struct mem_key_t {
+            nas_flood_mem_type_t type;
+            ndi_obj_id_t         id;
+            hal_vlan_id_t        vlan_id;
+            bool operator<(const mem_key_t &rhs) const {
+                if (type != rhs.type) return type < rhs.type;
+                if (id != rhs.id) return id < rhs.id;
+                return vlan_id < rhs.vlan_id;
+            }
+        };
+        struct mem_info_t {
+            npu_id_t       npu_id;
+            hal_ip_addr_t  remote_ip;
+            uint8_t        desired;     /*  NAS_FLOOD_GRP_xx flags requested */
+            uint8_t        committed;   /*  desired flags as of the last successful flush */
+            uint8_t        programmed;  /*  NAS_FLOOD_GRP_xx flags present in the NPU */
+        };
+
+        npu_id_t         npu_id;
+        nas_bridge_id_t  bridge_id;
+        ndi_obj_id_t     uc_group_id;
+        ndi_obj_id_t     mc_group_id;
+        bool             uc_shared;      /*  Unknown unicast floods on the multicast group */
+        size_t           diverged_cnt;   /*  Members whose desired uc and mc flags differ */
+
+        std::map<mem_key_t, mem_info_t> members;
+        std::set<mem_key_t>             dirty;
+
+        static bool diverged(uint8_t flags) {
+            return (((flags & NAS_FLOOD_GRP_UC) != 0) != ((flags & NAS_FLOOD_GRP_MC) != 0));
+        }
+        t_std_error program(const mem_key_t &key, mem_info_t &info, uint8_t grp, bool add);
+        t_std_error sync_member(const mem_key_t &key, mem_info_t &info);
+        t_std_error set_uc_flood_group(ndi_obj_id_t group_id);
+        void set_desired(mem_info_t &info, uint8_t groups);
+        void rollback_pending(void);
+
+    public:
+        NAS_BRIDGE_FLOOD_GROUPS() : npu_id(0), bridge_id(0), uc_group_id(INVALID_L2MC_GROUP_ID),
+                                    mc_group_id(INVALID_L2MC_GROUP_ID), uc_shared(false), diverged_cnt(0) {}
+
+        t_std_error create(npu_id_t npu, nas_bridge_id_t br_id);
+        t_std_error destroy(void);
+
+        ndi_obj_id_t uc_group_get(void) const { return uc_group_id; }
+        ndi_obj_id_t mc_group_get(void) const { return mc_group_id; }
+        bool valid(void) const {
+            return ((uc_group_id != INVALID_L2MC_GROUP_ID) && (mc_group_id != INVALID_L2MC_GROUP_ID));
+        }
+
+        /*  Stage the groups a member should be part of, 0 to remove it from all groups */
+        void stage(nas_flood_mem_type_t type, npu_id_t npu, ndi_obj_id_t id, hal_vlan_id_t vlan_id,
+                   const hal_ip_addr_t *remote_ip, uint8_t groups);
+        /*  Program all staged changes. On failure all staged changes are rolled back */
+        t_std_error flush(void);
+};
+
+#endif /* _NAS_INTERFACE_BRIDGE_FLOOD_H */
@@ -28,29 +28,126 @@
 #include "nas_interface_bridge_cps.h"
 #include "nas_interface_bridge_utils.h"
 #include "cps_api_object.h"
+#include "std_mutex_lock.h"
 #include <unordered_map>
+#include <map>
+#include <functional>
 #include <string>
+#include <string.h>
 #include <stdlib.h>
 
-typedef std::unordered_map<std::string, class NAS_BRIDGE *> bridge_map_s;
-typedef std::pair<std::string, class NAS_BRIDGE *> pair_t;
-typedef std::pair<bridge_map_s::iterator, bool> ret_t;
+/*
+ * Bridge registry. Each bridge name owns one entry which is indexed by name, by
+ * bridge ifindex and by the VLAN id bound to it. All three indexes are updated
+ * together under the registry lock, so a bridge found through one index is always
+ * reachable through the others.
+ *
+ * The name index is keyed by a pointer to the name stored in the entry, which lets
+ * lookups take a plain C string without building a temporary std::string.
+ */
+typedef struct {
+    const char *name;
+} bridge_name_key_t;
+
+struct bridge_name_key_hash {
+    size_t operator()(const bridge_name_key_t &key) const {
+        /* FNV-1a */
+        size_t h = 2166136261u;
+        for (const char *p = key.name; *p; ++p) {
+            h = (h ^ (unsigned char)*p) * 16777619u;
+        }
+        return h;
+    }
+};
+
+struct bridge_name_key_equal {
+    bool operator()(const bridge_name_key_t &lhs, const bridge_name_key_t &rhs) const {
+        return strcmp(lhs.name, rhs.name) == 0;
+    }
+};
+
+struct bridge_name_key_less {
+    bool operator()(const bridge_name_key_t &lhs, const bridge_name_key_t &rhs) const {
+        return strcmp(lhs.name, rhs.name) < 0;
+    }
+};
+
+typedef struct {
+    std::string    name;
+    NAS_BRIDGE     *obj;        /* nullptr while only a VLAN binding exists for the name */
+    hal_ifindex_t  if_index;
+    hal_vlan_id_t  vlan_id;     /* NAS_VLAN_ID_INVALID if not bound */
+} bridge_map_entry_t;
+
+typedef std::unordered_map<bridge_name_key_t, bridge_map_entry_t *,
+                           bridge_name_key_hash, bridge_name_key_equal> bridge_name_index_t;
+/* Name order of all entries, used to resume a dump after a given bridge name */
+typedef std::map<bridge_name_key_t, bridge_map_entry_t *, bridge_name_key_less> bridge_name_order_t;
+typedef std::unordered_map<hal_ifindex_t, bridge_map_entry_t *> bridge_ifindex_index_t;
+typedef std::unordered_map<hal_vlan_id_t, bridge_map_entry_t *> bridge_vlan_index_t;
 
 class bridge_map_t {
+        bridge_name_index_t    by_name;     /* owns the entries */
+        bridge_name_order_t    name_order;
+        bridge_ifindex_index_t by_ifindex;
+        bridge_vlan_index_t    by_vlan;
+
+        bridge_map_entry_t *entry_get(const char *name);
+        bridge_map_entry_t *entry_create(const char *name);
+        void entry_release(bridge_map_entry_t *entry);
+
     public:
-        bridge_map_s bmap;
         bridge_map_t(){}
-        t_std_error insert(std::string name, NAS_BRIDGE *obj);
-        t_std_error remove(std::string name);
-        t_std_error find(std::string name, bool *present);
-        t_std_error get(std::string name, NAS_BRIDGE **ptr);
+        t_std_error insert(const char *name, NAS_BRIDGE *obj);
+        t_std_error remove(const char *name);
+        t_std_error find(const char *name, bool *present);
+        t_std_error get(const char *name, NAS_BRIDGE **ptr);
+        t_std_error get_by_ifindex(hal_ifindex_t if_index, NAS_BRIDGE **ptr);
+        t_std_error get_by_vlan(hal_vlan_id_t vlan_id, NAS_BRIDGE **ptr);
+        t_std_error vlan_bind(hal_vlan_id_t vlan_id, const char *name);
+        t_std_error vlan_unbind(hal_vlan_id_t vlan_id);
+        t_std_error vlan_name_get(hal_vlan_id_t vlan_id, std::string &name);
+        void for_each(std::function<void (const std::string &, NAS_BRIDGE *)> fn);
+        /*
+         * Visit bridges in name order starting after the bridge named after (from the first
+         * bridge if empty) until fn returns false. Returns the name of the last bridge visited.
+         */
+        std::string for_each_after(const char *after, std::function<bool (const std::string &, NAS_BRIDGE *)> fn);
         t_std_error show();
 };
 
-t_std_error nas_bridge_map_obj_add(std::string name, NAS_BRIDGE *br_obj);
-t_std_error nas_bridge_map_obj_remove(std::string name, NAS_BRIDGE **br_obj);
-t_std_error nas_bridge_map_obj_get(std::string name, NAS_BRIDGE **br_obj);
-cps_api_return_code_t nas_bridge_fill_info(std::string br_name, cps_api_object_t obj);
+t_std_error nas_bridge_map_obj_add(const std::string &name, NAS_BRIDGE *br_obj);
+t_std_error nas_bridge_map_obj_remove(const std::string &name, NAS_BRIDGE **br_obj);
+t_std_error nas_bridge_map_obj_get(const std::string &name, NAS_BRIDGE **br_obj);
+t_std_error nas_bridge_map_obj_get(const char *name, NAS_BRIDGE **br_obj);
+t_std_error nas_bridge_map_obj_get_by_ifindex(hal_ifindex_t if_index, NAS_BRIDGE **br_obj);
+t_std_error nas_bridge_map_obj_get_by_vlan(hal_vlan_id_t vlan_id, NAS_BRIDGE **br_obj);
+t_std_error nas_bridge_map_vlan_bind(hal_vlan_id_t vlan_id, const std::string &name);
+t_std_error nas_bridge_map_vlan_unbind(hal_vlan_id_t vlan_id);
+t_std_error nas_bridge_map_vlan_name_get(hal_vlan_id_t vlan_id, std::string &name);
+cps_api_return_code_t nas_bridge_fill_info(const std::string &br_name, cps_api_object_t obj, bool with_members = true);
 cps_api_return_code_t nas_fill_all_bridge_info(cps_api_object_list_t *list, model_type_t model, bool get_state = false);
 
+/*
+ * Paginated bridge dump. Up to max_count bridges (0 for no limit) of the model sorted by
+ * name and following the cursor bridge name (empty to start from the first) are added to
+ * the list. Members are left out unless with_members is set. On return cursor holds the
+ * name of the last bridge added, or is cleared once the dump is complete. Each page of
+ * NAS_BRIDGE_DUMP_PAGE_SIZE bridges is filled under one short hold of the bridge lock.
+ */
+#define NAS_BRIDGE_DUMP_PAGE_SIZE  64
+
+/*
+ * Projection of bridge and VLAN interface gets. A paged get, one with get-next or an
+ * entry count set through cps_api_object_tools.h, returns the objects without their
+ * member lists unless the filter carries the member list attribute of the model:
+ * BRIDGE_DOMAIN_BRIDGE_MEMBER_INTERFACE, or DELL_IF_IF_INTERFACES_INTERFACE_TAGGED_PORTS
+ * or _UNTAGGED_PORTS. Other gets return the full objects.
+ */
+bool nas_bridge_get_filter_with_members(cps_api_object_t filt, model_type_t model);
+
+cps_api_return_code_t nas_fill_bridge_info_page(cps_api_object_list_t list, model_type_t model,
+                                                std::string &cursor, size_t max_count,
+                                                bool with_members, bool get_state = false);
+
 #endif /* _NAS_INTERFACE_BRIDGE_MAP_H */
@@ -62,8 +62,10 @@ t_std_error nas_bridge_utils_set_learning_disable(const char *br_name, bool disa
 
 /*  APIs to create and delete bridge  and its memberlist in the kernel  */
 t_std_error nas_bridge_utils_os_create_bridge(const char *br_name, hal_ifindex_t *idx);
+/*  Create the VLAN bridge in the kernel from a VLAN interface object, if-index is added to the object */
+t_std_error nas_bridge_utils_os_create_vlan(const char *br_name, cps_api_object_t obj, hal_ifindex_t *if_index);
 t_std_error nas_bridge_utils_os_delete_bridge(const char *br_name);
-t_std_error nas_bridge_utils_os_add_remove_memberlist(const char *br_name, memberlist_t & memlist, nas_port_mode_t port_mode, bool add);
+t_std_error nas_bridge_utils_os_add_remove_memberlist(const char *br_name, const memberlist_t & memlist, nas_port_mode_t port_mode, bool add);
 /*  Generic API to delete bridge completly in the kernel and in the NPU along with all of its members */
 t_std_error nas_bridge_delete_bridge(const char *br_name);
 
@@ -73,6 +75,9 @@ t_std_error nas_bridge_utils_create_obj(const char *name, BASE_IF_BRIDGE_MODE_t
 t_std_error nas_create_bridge(const char *name, BASE_IF_BRIDGE_MODE_t br_type, hal_ifindex_t idx, NAS_BRIDGE **bridge_obj);
 t_std_error nas_bridge_create_vlan(const char *br_name, hal_vlan_id_t vlan_id, cps_api_object_t obj,
                                     NAS_BRIDGE **bridge_obj = nullptr);
+/*  Create the VLAN bridge object and program it in the NPU for a bridge already created in the kernel */
+t_std_error nas_bridge_npu_create_vlan(const char *br_name, hal_vlan_id_t vlan_id, hal_ifindex_t if_index,
+                                        NAS_BRIDGE **bridge_obj = nullptr);
 t_std_error nas_bridge_utils_validate_bridge_mem_list(const char *br_name,
                                                 std::list <std::string> &intf_list,
                                                 std::list <std::string>&mem_list);
@@ -100,8 +105,11 @@ void nas_bridge_utils_publish_member_event(std::string bridge_name, std::string
 bool nas_bridge_is_empty(const std::string & bridge_name);
 t_std_error nas_bridge_utils_set_untagged_vlan(const char * bridge_name, hal_vlan_id_t vlan_id);
 
-void nas_bridge_utils_publish_memberlist_event(std::string bridge_name, memberlist_t &memlist, cps_api_operation_types_t op);
+void nas_bridge_utils_publish_memberlist_event(const std::string &bridge_name, const memberlist_t &memlist, cps_api_operation_types_t op);
 void nas_bridge_utils_publish_vlan_intf_event(const char * bridge_name, cps_api_operation_types_t op);
+/*  Publish VLAN member changes for internal components like nas-l2  */
+t_std_error nas_bridge_utils_internal_pub_mem_update(const char *br_name, memberlist_t &list, nas_port_mode_t port_mode,
+                                                    cps_api_operation_types_t op);
 
 /*  APIs for VLAN attach and Detach to a parent bridge */
 t_std_error nas_bridge_utils_detach_vlan(const char *vlan_intf, const char *parent_bridge);
@@ -115,4 +123,6 @@ t_std_error nas_bridge_utils_associate_npu_port(const char * br_name, const char
                                                     nas_port_mode_t mode, bool associate);
 
 t_std_error nas_bridge_utils_check_membership(const char *br_name, const char *mem_name , bool *present);
+/*  True if tagged membership of the bridge is kept in the VLAN scale bitmaps  */
+bool nas_bridge_utils_vlan_scale_managed(const char *br_name);
 #endif /* _NAS_INTERFACE_BRIDGE_UTILS_H */
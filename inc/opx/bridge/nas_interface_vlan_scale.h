@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+
+/*
+ * filename: nas_interface_vlan_scale.h
+ */
+
+#ifndef _NAS_INTERFACE_VLAN_SCALE_H
+#define _NAS_INTERFACE_VLAN_SCALE_H
+
+#include "ds_common_types.h"
+#include "std_error_codes.h"
+#include "cps_api_object.h"
+#include "nas_interface_bridge.h"
+
+#include <bitset>
+#include <string>
+
+#define NAS_VLAN_BITMAP_BITS 4096
+
+typedef std::bitset<NAS_VLAN_BITMAP_BITS> nas_vlan_bitmap_t;
+
+/*
+ * Tagged VLAN membership in VLAN scale mode. Each member port or LAG keeps one 4096 bit
+ * VLAN bitmap which is the source of truth for its tagged membership; VLAN bridges do not
+ * keep tagged member lists and no per VLAN sub interface objects exist for L2 VLANs.
+ * A membership change is turned into a bitmap difference and programmed in the NPU with
+ * one NDI call per VLAN, NPU and member type. Kernel VLAN devices are created only while
+ * the VLAN bridge is in L3 mode.
+ *
+ * All members are parent port or LAG names, not VLAN sub interface names.
+ */
+
+/*  True if tagged membership of this bridge is kept in the VLAN bitmaps  */
+bool nas_vlan_scale_bridge_managed(NAS_BRIDGE *br_obj);
+
+/*  Replace the tagged members of a VLAN. cur_members, when given, receives the previous members */
+t_std_error nas_vlan_scale_vlan_members_set(hal_vlan_id_t vlan_id, const memberlist_t &members,
+                                            memberlist_t *cur_members = nullptr);
+
+void nas_vlan_scale_vlan_members_get(hal_vlan_id_t vlan_id, memberlist_t &members);
+/*  True if the member is tagged in the VLAN  */
+bool nas_vlan_scale_member_vlan_test(const std::string &mem, hal_vlan_id_t vlan_id);
+bool nas_vlan_scale_vlan_has_members(hal_vlan_id_t vlan_id);
+
+/*  Remove the VLAN from every member, used when the VLAN is deleted  */
+t_std_error nas_vlan_scale_vlan_clear(hal_vlan_id_t vlan_id);
+
+/*  Drop the VLAN bitmap of a port or LAG being deleted, its NPU membership goes with it  */
+void nas_vlan_scale_member_clear(const std::string &mem);
+
+/*  Create or delete the kernel VLAN devices of the VLAN members on L3 mode change  */
+t_std_error nas_vlan_scale_os_members_update(hal_vlan_id_t vlan_id, bool create);
+
+/*  Add the tagged members of the VLAN to a VLAN interface object  */
+void nas_vlan_scale_fill_tagged_members(hal_vlan_id_t vlan_id, cps_api_object_t obj);
+
+#endif /* _NAS_INTERFACE_VLAN_SCALE_H */
@@ -120,6 +120,27 @@ t_std_error nas_if_get_assigned_mac(const char *if_type,
                                     const char *if_name, hal_vlan_id_t vlan_id,
                                     char *mac_addr, size_t mac_buf_size);
 
+/**
+ * Request entry for bulk assigned MAC address lookup. if_name is used for
+ * all interface types except L2VLAN, which is keyed by vlan_id.
+ */
+typedef struct {
+    const char *if_type;
+    const char *if_name;
+    hal_vlan_id_t vlan_id;
+    char mac_addr[MAC_STRING_SZ];
+    t_std_error rc;
+} nas_if_mac_req_t;
+
+/**
+ * Get the assigned MAC address for a list of interfaces. Entries not found in
+ * the local MAC cache are resolved together in a single CPS transaction.
+ * @param req_list list of requests, mac_addr and rc are filled per entry
+ * @param count number of entries in req_list
+ * @return STD_ERR_OK if every entry was resolved
+ */
+t_std_error nas_if_get_assigned_mac_bulk(nas_if_mac_req_t *req_list, size_t count);
+
 t_std_error hal_int_name_to_if_index(hal_ifindex_t *if_index, const char *name);
 
 /**
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+
+/*
+ * filename: nas_interface_id.h
+ */
+
+#ifndef _NAS_INTERFACE_ID_H
+#define _NAS_INTERFACE_ID_H
+
+#include "hal_if_mapping.h"
+#include "ds_common_types.h"
+#include "std_error_codes.h"
+#include "nas_ndi_common.h"
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <iterator>
+#include <cstddef>
+
+/*
+ * Interface names are interned once into small dense ids. The id of a name never
+ * changes for the life of the process, so containers can hold 4 byte ids instead
+ * of strings. The hardware details (ifindex, type, npu port or LAG id) are
+ * resolved on first use and cached beside the id until the interface is removed.
+ */
+typedef uint32_t nas_intf_id_t;
+
+#define NAS_INTF_ID_INVALID  ((nas_intf_id_t) ~0)
+
+/* Return the id of an interface name, interning the name if not seen before */
+nas_intf_id_t nas_intf_id_intern(const std::string &if_name);
+
+/* Return the id of an interface name or NAS_INTF_ID_INVALID without interning it */
+nas_intf_id_t nas_intf_id_lookup(const std::string &if_name);
+
+/* Return the interned name of an id. Reference stays valid for the process lifetime */
+const std::string & nas_intf_id_name(nas_intf_id_t id);
+
+/*
+ * Fill if_name, if_index, int_type, npu_id, port_id and lag_id of intf_ctrl for the
+ * interface. Served from the cache when resolved earlier, otherwise queried through
+ * dn_hal_get_interface_info by name and cached.
+ */
+t_std_error nas_intf_id_resolve(nas_intf_id_t id, interface_ctrl_t *intf_ctrl);
+t_std_error nas_intf_id_resolve(const std::string &if_name, interface_ctrl_t *intf_ctrl);
+
+/* Drop the cached hardware details of an interface, called when it is created or removed */
+void nas_intf_id_invalidate(const std::string &if_name);
+
+/*
+ * Set of interned interface ids kept as a sorted vector. Iterators dereference to the
+ * interface name so it can be used where a set of names is expected.
+ */
+class nas_intf_id_set {
+        std::vector<nas_intf_id_t> ids;
+
+    public:
+        class const_iterator {
+                std::vector<nas_intf_id_t>::const_iterator _it;
+            public:
+                typedef std::forward_iterator_tag iterator_category;
+                typedef std::string value_type;
+                typedef std::ptrdiff_t difference_type;
+                typedef const std::string * pointer;
+                typedef const std::string & reference;
+
+                const_iterator() {}
+                explicit const_iterator(std::vector<nas_intf_id_t>::const_iterator it) : _it(it) {}
+                const std::string & operator*() const { return nas_intf_id_name(*_it); }
+                const std::string * operator->() const { return &nas_intf_id_name(*_it); }
+                const_iterator & operator++() { ++_it; return *this; }
+                const_iterator operator++(int) { const_iterator tmp = *this; ++_it; return tmp; }
+                bool operator==(const const_iterator &rhs) const { return _it == rhs._it; }
+                bool operator!=(const const_iterator &rhs) const { return _it != rhs._it; }
+                nas_intf_id_t id() const { return *_it; }
+                std::vector<nas_intf_id_t>::const_iterator base() const { return _it; }
+        };
+        typedef const_iterator iterator;
+
+        const_iterator begin() const { return const_iterator(ids.begin()); }
+        const_iterator end() const { return const_iterator(ids.end()); }
+        bool empty() const { return ids.empty(); }
+        size_t size() const { return ids.size(); }
+        void clear() { ids.clear(); }
+
+        const_iterator find(nas_intf_id_t id) const;
+        const_iterator find(const std::string &if_name) const {
+            return find(nas_intf_id_lookup(if_name));
+        }
+        bool contains(nas_intf_id_t id) const { return find(id) != end(); }
+        bool insert(nas_intf_id_t id);
+        bool insert(const std::string &if_name) {
+            return insert(nas_intf_id_intern(if_name));
+        }
+        const_iterator erase(const_iterator it) {
+            return const_iterator(ids.erase(ids.begin() + (it.base() - ids.begin())));
+        }
+        size_t erase(const std::string &if_name);
+};
+
+#endif /* _NAS_INTERFACE_ID_H */
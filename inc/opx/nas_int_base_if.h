@@ -31,9 +31,14 @@
 #include <unordered_map>
 #include <memory>
 #include <list>
+#include <vector>
 #include <utility>
 
 using master_fn_type = std::function< void (if_master_info_t)>;
+using master_find_fn_type = std::function< bool (const if_master_info_t &)>;
+
+/* Masters of an interface beyond which their positions are indexed, e.g. trunk ports */
+#define NAS_INTF_MASTER_INDEX_MIN 16
 
 class nas_intf_obj {
 
@@ -41,7 +46,14 @@ class nas_intf_obj {
     std::string    m_if_name;
     int tagged_cnt = 0;
     int untagged_cnt = 0;
-    std::list<if_master_info_t> m_list;
+    // LAG masters first, then the others. Deleting a non LAG master moves the last one in its place
+    std::vector<if_master_info_t> m_list;
+    // Position of each master in m_list, only kept once there are NAS_INTF_MASTER_INDEX_MIN masters
+    std::unordered_map<hal_ifindex_t, size_t> m_index;
+
+    size_t nas_intf_obj_master_pos(hal_ifindex_t m_if_idx) const;
+    void nas_intf_obj_index_rebuild(void);
+    void nas_intf_obj_count_update(const if_master_info_t &m_info, int delta);
 
 public:
     nas_intf_obj(hal_ifindex_t if_idx, const char* if_name):
@@ -51,16 +63,24 @@ public:
 
     bool nas_intf_obj_master_delete(if_master_info_t m_info);
 
-    void nas_intf_obj_for_each_master(master_fn_type fn) {
-        for (auto ix: m_list) fn(ix);
+    void nas_intf_obj_for_each_master(const master_fn_type &fn) const {
+        for (const auto &ix: m_list) fn(ix);
+    }
+
+    // Visit masters in place until fn returns true, returns true if it did
+    bool nas_intf_obj_find_master(const master_find_fn_type &fn) const {
+        for (const auto &ix: m_list) {
+            if (fn(ix)) return true;
+        }
+        return false;
     }
 
     //Return a copy of master_list
     std::list<if_master_info_t> nas_intf_obj_master_list(void) const {
-        return m_list;
+        return std::list<if_master_info_t>(m_list.begin(), m_list.end());
     }
     // Return tagged / untagged count
-    std::pair<int, int> nas_intf_obj_untag_tag_cnt(void);
+    std::pair<int, int> nas_intf_obj_untag_tag_cnt(void) const;
 
     bool nas_intf_obj_is_mlist_empty(void) const {
         return m_list.empty();
@@ -92,7 +112,8 @@ public:
     bool nas_intf_del_master(hal_ifindex_t ifx, if_master_info_t m_info, BASE_IF_MODE_t *new_mode, bool *mode_change);
     bool nas_intf_update_master(hal_ifindex_t ifx, if_master_info_t m_info, bool add, BASE_IF_MODE_t *new_mode,
                                                                             bool *mode_change);
-    void nas_intf_master_callbk(hal_ifindex_t ifx, master_fn_type fn);
+    void nas_intf_master_callbk(hal_ifindex_t ifx, const master_fn_type &fn);
+    bool nas_intf_master_find(hal_ifindex_t ifx, const master_find_fn_type &fn);
     std::list<if_master_info_t> nas_intf_get_master_list(hal_ifindex_t ifx);
     std::pair<int,int> nas_intf_get_untag_tag_cnt(hal_ifindex_t ifx);
     BASE_IF_MODE_t nas_intf_get_mode(hal_ifindex_t ifx);
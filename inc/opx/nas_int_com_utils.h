@@ -47,7 +47,14 @@ bool nas_intf_add_master(hal_ifindex_t ifx, if_master_info_t m_info, BASE_IF_MOD
 bool nas_intf_del_master(hal_ifindex_t ifx, if_master_info_t m_info);
 bool nas_intf_del_master(hal_ifindex_t ifx, if_master_info_t m_info, BASE_IF_MODE_t *new_mode, bool *mode_change);
 void nas_intf_master_callback(hal_ifindex_t ifx, std::function< void (if_master_info_t)> fn);
+/*
+ * Visit the masters of an interface in place until fn returns true. Runs under the
+ * master table read lock, so fn must not take locks or change masters.
+ */
+bool nas_intf_master_find(hal_ifindex_t ifx, std::function< bool (const if_master_info_t &)> fn);
 std::list<if_master_info_t> nas_intf_get_master(hal_ifindex_t ifx);
+/* Generation of the master table, changes after every master add or delete */
+uint64_t nas_intf_master_gen(void);
 BASE_IF_MODE_t nas_intf_get_mode(hal_ifindex_t ifx);
 bool nas_intf_handle_intf_mode_change(hal_ifindex_t ifx, BASE_IF_MODE_t mode);
 bool nas_intf_handle_intf_mode_change (const char *if_name, BASE_IF_MODE_t mode);
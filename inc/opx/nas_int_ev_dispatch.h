@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+
+
+/*
+ * filename: nas_int_ev_dispatch.h
+ */
+
+#ifndef _NAS_INT_EV_DISPATCH_H
+#define _NAS_INT_EV_DISPATCH_H
+
+#include "cps_api_object.h"
+#include "std_error_codes.h"
+
+#include <stdint.h>
+#include <vector>
+
+/*
+ * OS interface events are handed from the CPS event thread to a small pool of
+ * workers. Every event has an ordering key, usually the ifindex of the object it
+ * changes; events with the same key run in arrival order on the same worker.
+ * An event may also depend on the keys of other objects, it then waits until the
+ * events queued earlier for those keys are done. Events for unrelated interfaces
+ * are processed in parallel.
+ *
+ * An attribute update that is still queued absorbs a later update with the same
+ * merge id if nothing else was queued for the key in between. The attributes of
+ * the later update replace those of the queued one, so the handler runs once with
+ * the net change.
+ *
+ * Events with a batch handler are handed to it together with the events queued
+ * right after them for the same key and with the same batch handler. When such
+ * an event is the last one queued, its worker waits up to the batch window for
+ * more to arrive, so a burst like the slave ports of a new bond is applied at once.
+ *
+ * Handlers that change state shared between interfaces without a lock of their own
+ * (LAG masters and port modes, the bridge and sub-interface object map) mark their
+ * events shared. Shared events all run on the worker of NAS_INT_EV_SHARED_KEY, in
+ * arrival order; a dependency on an object handled there uses that key.
+ */
+#define NAS_INT_EV_DISPATCH_DEF_WORKERS  4
+#define NAS_INT_EV_SHARED_KEY            0
+#define NAS_INT_EV_BATCH_WINDOW_MS       20
+#define NAS_INT_EV_BATCH_MAX             64
+
+typedef void (*nas_int_ev_dispatch_fn_t)(cps_api_object_t obj);
+typedef void (*nas_int_ev_batch_fn_t)(const std::vector<cps_api_object_t> &objs);
+
+typedef struct nas_int_ev_order_s {
+    uint32_t              key;
+    std::vector<uint32_t> deps;
+    bool                  dep_all;  /* wait for every event queued before this one */
+    bool                  shared;   /* run on the worker of NAS_INT_EV_SHARED_KEY */
+    uint64_t              merge_id; /* 0 or id of an attribute update that can be merged */
+    nas_int_ev_batch_fn_t batch_fn; /* nullptr or handler of a run of events for the key */
+} nas_int_ev_order_t;
+
+/* Start the workers. 0 picks a count from the number of CPUs, capped at the default */
+t_std_error nas_int_ev_dispatch_init(size_t workers);
+
+/*
+ * Queue a copy of obj to be passed to fn. The caller keeps ownership of obj.
+ * If the workers are not running fn is called inline, fn must then also handle
+ * the events that have a batch handler.
+ */
+void nas_int_ev_dispatch(const nas_int_ev_order_t &order, cps_api_object_t obj,
+                         nas_int_ev_dispatch_fn_t fn);
+
+#endif /* _NAS_INT_EV_DISPATCH_H */
@@ -32,4 +32,7 @@ t_std_error nas_intf_admin_state_get(hal_ifindex_t if_index, bool *admin_state);
 t_std_error nas_intf_admin_state_set(hal_ifindex_t if_index, bool admin_state);
 bool nas_base_to_ietf_state_speed(BASE_IF_SPEED_t speed, uint64_t *ietf_speed);
 
+/* Update the OS interface attribute store from an OS interface event */
+void nas_int_os_if_store_update(cps_api_object_t obj);
+
 #endif //NAS_INTERFACE_INC_NAS_INT_LOGICAL_H_
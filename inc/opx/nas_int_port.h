@@ -32,6 +32,15 @@ static inline IF_INTERFACES_STATE_INTERFACE_OPER_STATUS_t ndi_to_cps_oper_type(n
             IF_INTERFACES_STATE_INTERFACE_OPER_STATUS_DOWN : IF_INTERFACES_STATE_INTERFACE_OPER_STATUS_UP;
 }
 
+/* What NAS knows about the port a packet was received on */
+typedef struct nas_int_port_rx_info_s {
+    hal_ifindex_t ifindex;
+    hal_ifindex_t lag_ifindex;   /* 0 if the port is not a LAG member */
+    hal_vlan_id_t untagged_vlan; /* 0 if the port (or its LAG) is not an untagged VLAN member */
+    uint32_t      vrf_id;
+    char          if_name[HAL_IF_NAME_SZ];
+} nas_int_port_rx_info_t;
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -50,6 +59,8 @@ t_std_error nas_int_port_init(void);
 
 bool nas_int_port_ifindex (npu_id_t npu, port_t port, hal_ifindex_t *ifindex);
 
+bool nas_int_port_rx_info (npu_id_t npu, port_t port, nas_int_port_rx_info_t *info);
+
 t_std_error nas_int_update_npu_port(const char *name, npu_id_t npu, port_t port,
                                     bool connect);
 
@@ -29,11 +29,30 @@
 #include "std_error_codes.h"
 #include "nas_ndi_common.h"
 #include "std_socket_tools.h"
+#include "hal_if_mapping.h"
+#include "nas_packet_meta.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/* Receive context of a packet, built at most once per packet for the meta-data */
+typedef struct _nas_pkt_rx_meta_t {
+    nas_pkt_meta_fixed_t meta;
+    char                 rx_if_name[HAL_IF_NAME_SZ];
+} nas_pkt_rx_meta_t;
+
+/**
+ * @brief : Build the receive context of an in-bound packet
+ * @param pkt : pointer to packet buffer
+ * @param pkt_len : packet buffer length
+ * @param p_attr : packet attribute pointer
+ * @param rx_meta : receive context filled in
+ * @return true if the rx port has an interface, false otherwise
+ */
+bool nas_pkt_rx_meta_fill (const uint8_t *pkt, uint32_t pkt_len,
+                           const ndi_packet_attr_t *p_attr, nas_pkt_rx_meta_t *rx_meta);
+
 typedef union _pf_match_value_t{
     hal_mac_addr_t  mac;
     hal_ip_addr_t   ip;
@@ -51,8 +51,65 @@ typedef enum {
     NAS_PKT_META_PKT_LEN, /* value type - uint32_t */
 
     NAS_PKT_META_TRAP_ID, /* value type - uint64_t */
+
+    NAS_PKT_META_LAYOUT, /* value type - uint32_t, see nas_pkt_meta_fixed_encode */
+
+    NAS_PKT_META_RX_LAG, /* value type - uint32_t, ifindex of the LAG of RX_PORT */
+
+    NAS_PKT_META_RX_VLAN, /* value type - uint32_t */
+
+    NAS_PKT_META_RX_TIMESTAMP, /* value type - uint64_t, ns since the epoch */
+
+    NAS_PKT_META_VRF_ID, /* value type - uint32_t */
+
+    NAS_PKT_META_RULE_ID, /* value type - uint64_t, matched packet filter rule */
+
+    NAS_PKT_META_RX_IF_NAME, /* value type - NUL terminated string */
 } nas_pkt_meta_attr_type_t;
 
+/**
+ * Fixed layout versions carried in the NAS_PKT_META_LAYOUT attribute
+ */
+#define NAS_PKT_META_LAYOUT_V1  1
+#define NAS_PKT_META_LAYOUT_V2  2   /* V1 plus RX_LAG, RX_VLAN, VRF_ID, RX_TIMESTAMP, RULE_ID */
+#define NAS_PKT_META_LAYOUT_V3  3   /* V2 with only the fields present, their
+                                       NAS_PKT_META_F_* mask in bits 8 and up */
+
+#define NAS_PKT_META_LAYOUT_VERSION_MASK  0xff
+#define NAS_PKT_META_LAYOUT_FIELDS_SHIFT  8
+
+/**
+ * Presence bits of the fixed layout fields, in layout order
+ */
+#define NAS_PKT_META_F_RX_PORT       (1 << 0)
+#define NAS_PKT_META_F_TX_PORT       (1 << 1)
+#define NAS_PKT_META_F_PKT_LEN       (1 << 2)
+#define NAS_PKT_META_F_SAMPLE_COUNT  (1 << 3)
+#define NAS_PKT_META_F_TRAP_ID       (1 << 4)
+#define NAS_PKT_META_F_RX_LAG        (1 << 5)
+#define NAS_PKT_META_F_RX_VLAN       (1 << 6)
+#define NAS_PKT_META_F_VRF_ID        (1 << 7)
+#define NAS_PKT_META_F_RX_TIMESTAMP  (1 << 8)
+#define NAS_PKT_META_F_RULE_ID       (1 << 9)
+
+/**
+ * Meta-data fields of the fixed layout. Only the fields whose NAS_PKT_META_F_* bit
+ * is set in fields are encoded, fields not present are decoded as 0.
+ */
+typedef struct _nas_pkt_meta_fixed_s {
+    uint32_t fields;
+    uint32_t rx_port;
+    uint32_t tx_port;
+    uint32_t pkt_len;
+    uint64_t sample_count;
+    uint64_t trap_id;
+    uint32_t rx_lag;
+    uint32_t rx_vlan;
+    uint32_t vrf_id;
+    uint64_t rx_timestamp;
+    uint64_t rule_id;
+} nas_pkt_meta_fixed_t;
+
 /**
  * Packet meta-data attribute iterator.
  */
@@ -185,6 +242,64 @@ bool nas_pkt_meta_add_u32 (nas_pkt_meta_attr_it_t *pos,
 bool nas_pkt_meta_add_u64 (nas_pkt_meta_attr_it_t *pos,
                            nas_pkt_meta_attr_type_t type, uint64_t val);
 
+/**
+ * Add attribute containing binary data at the specified position.
+ *
+ * @param[in/out] pos  indicates buffer pos at which to add current attribute
+ *                     this will be moved forward after adding attribute
+ * @param[in]    type  attribute type
+ * @param[in]    data  attribute data
+ * @param[in]     len  length of the data
+ * @return     true if attribute successfully added
+ */
+bool nas_pkt_meta_add_bin (nas_pkt_meta_attr_it_t *pos,
+                           nas_pkt_meta_attr_type_t type, const void *data, size_t len);
+
+/**
+ * Add attribute containing a string, including its terminating NUL, at the
+ * specified position.
+ *
+ * @param[in/out] pos  indicates buffer pos at which to add current attribute
+ *                     this will be moved forward after adding attribute
+ * @param[in]    type  attribute type
+ * @param[in]     str  attribute data
+ * @return     true if attribute successfully added
+ */
+bool nas_pkt_meta_add_str (nas_pkt_meta_attr_it_t *pos,
+                           nas_pkt_meta_attr_type_t type, const char *str);
+
+/**
+ * Encode the meta-data header in the fixed layout.
+ *
+ * The fixed layout is a regular TLV header whose first attribute is NAS_PKT_META_LAYOUT
+ * carrying the mask of the fields present, followed by those fields in a fixed order,
+ * so the offset of each value follows from the mask. The attribute headers are copied
+ * from prebuilt templates and the values are stored in place. Receivers using the
+ * attribute iterator keep working unchanged.
+ *
+ * @param[in]     buf  buffer for the meta-data header
+ * @param[in] buf_len  total available bytes in the buffer
+ * @param[in]    meta  field values
+ * @param[out]    pos  buffer position after the fixed attributes, more attributes
+ *                     can be added there with nas_pkt_meta_add_u32/u64
+ * @return     true if the header fits in the buffer
+ */
+bool nas_pkt_meta_fixed_encode (uint8_t* buf, size_t buf_len, const nas_pkt_meta_fixed_t* meta,
+                                nas_pkt_meta_attr_it_t* pos);
+
+/**
+ * Decode the meta-data fields of a received buffer.
+ *
+ * A header in the fixed layout is read by offset. Any other header is decoded by
+ * walking the attributes. The fields found are flagged in meta->fields, fields not
+ * present are returned as 0.
+ *
+ * @param[in]   buf  received buffer containing the meta-data and actual packet
+ * @param[out] meta  field values
+ * @return     false if the buffer has no meta-data header
+ */
+bool nas_pkt_meta_fixed_decode (uint8_t* buf, nas_pkt_meta_fixed_t* meta);
+
 #ifdef __cplusplus
 }
 #endif
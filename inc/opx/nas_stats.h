@@ -57,6 +57,38 @@ t_std_error get_stat_ids_len(nas_stat_type_t type, unsigned int * len);
 t_std_error port_stat_list_get(uint64_t * list, unsigned int *len);
 t_std_error vlan_stat_list_get(uint64_t *list, unsigned int *len);
 
+/* Default seconds between reads of all the port counters into the table, sampler is off */
+#define NAS_STATS_SHM_DEF_INTERVAL_SECS 0
+
+/* Interface statistics shared memory export, see nas_stats_shm.h */
+t_std_error nas_stats_shm_init(const uint64_t *ids, size_t n_ids);
+void nas_stats_shm_update(hal_ifindex_t ifindex, const char *if_name, const uint64_t *values, size_t n);
+/*
+ * Read the counters ids of a port. The values in the shared memory table are returned
+ * if they are at most max_age_ms old, else the NPU is read and the table updated.
+ */
+bool nas_stats_shm_port_read(hal_ifindex_t ifindex, const char *if_name, npu_id_t npu, npu_port_t port,
+                        const uint64_t *ids, uint64_t *values, size_t n, uint64_t max_age_ms);
+
+/*
+ * Interface statistics streaming subscription. Every interval_secs one interface
+ * statistics event is published with the counter deltas of the interfaces.
+ * n_cnt 0 streams all port counters. thresholds is NULL or, for each counter,
+ * the delta per interval that publishes an event for the interface, 0 for none.
+ */
+typedef struct {
+    const char * const *if_names;
+    size_t             n_if;
+    const uint64_t     *cnt_ids;
+    const uint64_t     *thresholds;
+    size_t             n_cnt;
+    unsigned int       interval_secs;
+} nas_stats_stream_sub_t;
+
+t_std_error nas_stats_stream_init(cps_api_operation_handle_t handle, const uint64_t *ids, size_t n_ids);
+t_std_error nas_stats_stream_subscribe(const nas_stats_stream_sub_t *sub, uint32_t *sub_id);
+t_std_error nas_stats_stream_unsubscribe(uint32_t sub_id);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+
+/*
+ * filename: nas_stats_shm.h
+ */
+
+/**
+ * nas_stats_shm.h - Interface statistics shared memory export
+ *
+ * The stats subsystem keeps the counters of each interface in a shared memory
+ * table, refreshed periodically and on every statistics get. Local readers map
+ * the table and copy the entries they need; an entry is updated under its own
+ * sequence lock so a copy is always consistent.
+ */
+
+#ifndef _NAS_STATS_SHM_H_
+#define _NAS_STATS_SHM_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define NAS_STATS_SHM_NAME        "/opx_nas_if_stats"
+#define NAS_STATS_SHM_MAGIC       0x4e534853
+#define NAS_STATS_SHM_VERSION     1
+
+#define NAS_STATS_SHM_MAX_IF      1024 /* interface entries in the table */
+#define NAS_STATS_SHM_MAX_CNT     160  /* counters per entry */
+#define NAS_STATS_SHM_IF_NAME_SZ  32
+
+/**
+ * Table header. The counter ids are the CPS attribute ids of the interface
+ * statistics, the n-th counter of every entry has the n-th id.
+ */
+typedef struct {
+    uint32_t magic;     /* NAS_STATS_SHM_MAGIC once the table is ready */
+    uint32_t version;
+    uint32_t max_if;
+    uint32_t max_cnt;
+    uint32_t n_cnt;     /* counters in use in each entry */
+    uint32_t n_if;      /* entries in use are below this one */
+    uint64_t cnt_ids[NAS_STATS_SHM_MAX_CNT];
+} nas_stats_shm_hdr_t;
+
+/**
+ * Counters of one interface. seq is odd while the entry is being written.
+ * An entry with if_index 0 is free.
+ */
+typedef struct {
+    uint32_t seq;
+    int32_t  if_index;
+    char     if_name[NAS_STATS_SHM_IF_NAME_SZ];
+    uint64_t time_stamp;    /* CLOCK_MONOTONIC ns of the counter read */
+    uint64_t cnt[NAS_STATS_SHM_MAX_CNT];
+} nas_stats_shm_entry_t;
+
+typedef struct {
+    nas_stats_shm_hdr_t   hdr;
+    nas_stats_shm_entry_t entry[NAS_STATS_SHM_MAX_IF];
+} nas_stats_shm_t;
+
+/**
+ * Map the statistics table read only.
+ * @return the table or NULL if it is not available
+ */
+const nas_stats_shm_t *nas_stats_shm_open(void);
+
+/**
+ * Unmap a table returned by nas_stats_shm_open
+ */
+void nas_stats_shm_close(const nas_stats_shm_t *shm);
+
+/**
+ * Get the counter ids of the table entries
+ * @param shm the table
+ * @param[out] ids the counter ids
+ * @return number of counters in each entry
+ */
+size_t nas_stats_shm_counters(const nas_stats_shm_t *shm, const uint64_t **ids);
+
+/**
+ * Get the number of entries to scan, entries at and above it are free
+ */
+size_t nas_stats_shm_entries(const nas_stats_shm_t *shm);
+
+/**
+ * Take a consistent copy of an entry
+ * @param shm the table
+ * @param ix entry index, below nas_stats_shm_entries
+ * @param[out] entry the copy, only the counters in use are copied
+ * @return true if the entry is in use and was copied
+ */
+bool nas_stats_shm_read(const nas_stats_shm_t *shm, size_t ix, nas_stats_shm_entry_t *entry);
+
+/**
+ * Take a consistent copy of the entry of an interface
+ * @param shm the table
+ * @param if_index interface index
+ * @param[out] entry the copy, only the counters in use are copied
+ * @return true if the interface has an entry
+ */
+bool nas_stats_shm_read_if(const nas_stats_shm_t *shm, int32_t if_index, nas_stats_shm_entry_t *entry);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _NAS_STATS_SHM_H_ */
@@ -23,12 +23,25 @@
 #define NAS_VRF_H_
 
 #include "std_error_codes.h"
+#include "ds_common_types.h"
 #include "cps_api_operation.h"
 
 #define NAS_VRF_LOG_ERR(ID, ...) EV_LOGGING(VRF, ERR, ID, __VA_ARGS__)
 #define NAS_VRF_LOG_INFO(ID, ...) EV_LOGGING(VRF, INFO, ID, __VA_ARGS__)
 #define NAS_VRF_LOG_DEBUG(ID, ...) EV_LOGGING(VRF, DEBUG, ID, __VA_ARGS__)
 
+/* Default number of virtual routers kept pre-created for VRF create, pool is off */
+#define NAS_VRF_VR_POOL_DEF_DEPTH 0
+
+typedef struct {
+    size_t   depth;     /* configured pool depth, 0 disables the pool */
+    size_t   available; /* VRs currently in the pool */
+    uint64_t hits;      /* VRF creates served from the pool */
+    uint64_t misses;    /* VRF creates that created the VR inline */
+    uint64_t created;   /* VRs created by the pool refill */
+    uint64_t released;  /* VRs deleted on VRF delete */
+} nas_vrf_vr_pool_stats_t;
+
 t_std_error nas_vrf_object_vrf_init(cps_api_operation_handle_t nas_vrf_cps_handle );
 t_std_error nas_vrf_object_vrf_intf_init(cps_api_operation_handle_t nas_vrf_cps_handle );
 
@@ -38,6 +51,12 @@ cps_api_return_code_t nas_intf_bind_vrf_rpc_handler (void * context, cps_api_tra
 bool nas_vrf_update_vrf_id(const char *vrf_name, bool is_add);
 cps_api_return_code_t nas_vrf_get_intf_info(cps_api_object_list_t list, const char *vrf_name,
                                             const char *if_name);
+cps_api_return_code_t nas_vrf_get_all_intf_info(cps_api_object_list_t list, const char *vrf_name);
 cps_api_return_code_t nas_vrf_get_router_intf_info(cps_api_object_list_t list, const char *if_name);
 t_std_error nas_vrf_create_publish_handle();
+
+t_std_error nas_vrf_vr_pool_init(void);
+t_std_error nas_vrf_vr_alloc(nas_obj_id_t *vr_id);
+t_std_error nas_vrf_vr_free(nas_obj_id_t vr_id);
+void nas_vrf_vr_pool_stats_get(nas_vrf_vr_pool_stats_t *stats);
 #endif /* NAS_VRF_H_ */
@@ -61,6 +61,8 @@ def usage():
     print '-s, --show: show the VLAN parameter, when no VLAN ID given show all'
     print '-t, --tagged: If user want to add the port as tagged port, default untagged\n'
     print '--vlantype : Type of vlan (data<1>/management<2>)'
+    print '--bulk    : Create all VLANs in the given range with the same ports'
+    print '--range   : VLAN id range(s) for bulk creation, e.g. 100-200,300'
 
     print 'Example:'
     print 'cps_config_vlan.py  --add --id 100 --vlantype 1 --port e101-001-0,e101-004-0'
@@ -68,6 +70,7 @@ def usage():
     print 'cps_config_vlan.py  --addport --name br100 --port e101-001-0,e101-004-0'
     print 'cps_config_vlan.py  --addmac  --name br100 --mac 90:b1:1c:f4:a8:b1'
     print 'cps_config_vlan.py  --show    [--name br100]'
+    print 'cps_config_vlan.py  --bulk    --range 2-4094 --tagged --port e101-001-0,bond1'
     sys.exit(1)
 
 
@@ -89,6 +92,47 @@ def _port_name_list(ports):
         l.append((port.strip()))
     return l
 
+def _vlan_id_list(ranges):
+    l = []
+    for r in str.split(ranges, ","):
+        bounds = str.split(r.strip(), "-")
+        first = int(bounds[0])
+        last = int(bounds[-1])
+        l.extend(range(first, last + 1))
+    return l
+
+def _vlan_bulk_results(change):
+    ''' Split the per VLAN results of a bulk reply into created and failed VLAN ids '''
+    created = []
+    failed = []
+    entries = change['data'].get(vlan_attr_id, {})
+    if not isinstance(entries, dict):
+        return created, failed
+    for ix in sorted(entries.keys(), key=int):
+        entry = entries[ix]
+        vid = cps_object.types.from_data(vlan_attr_id, entry[vlan_attr_id])
+        if name_attr_id in entry:
+            created.append(vid)
+        else:
+            failed.append(vid)
+    return created, failed
+
+def nas_vlan_bulk_op(data_dict):
+    obj = cps_object.CPSObject(vlan_obj_id, data=data_dict)
+    tr = cps_utils.CPSTransaction([('action', obj.get())])
+    ret = tr.commit()
+    if ret == False:
+        print 'Bulk VLAN creation failed'
+        return False
+    rc = True
+    for entry in ret:
+        created, failed = _vlan_bulk_results(entry['change'])
+        print 'Bulk VLAN creation: %d VLANs created, %d failed' % (len(created), len(failed))
+        if len(failed) != 0:
+            print 'Failed VLANs: %s' % ','.join(str(vid) for vid in failed)
+            rc = False
+    return rc
+
 def main(argv):
     ''' The main function will read the user input from the
     command line argument and  process the request  '''
@@ -100,12 +144,14 @@ def main(argv):
     if_name = ''
     port_type = untagged_port_attr_id
     mac_id = ''
+    vlan_range = ''
 
     try:
         opts, args = getopt.getopt(argv, "hadtsp:i:m:v:",
                                    ["help", "add", "del", "tagged", "port=",
                                     "show", "id=", "name=", "addport",
-                                    "delport", "mac=", "addmac", "vlantype="
+                                    "delport", "mac=", "addmac", "vlantype=",
+                                    "bulk", "range="
                                     ]
         )
 
@@ -152,12 +198,26 @@ def main(argv):
         elif opt == '--vlantype':
             vlan_type = arg
 
+        elif opt == '--bulk':
+            choice = 'bulk'
+
+        elif opt == '--range':
+            vlan_range = arg
+
     if choice == 'add' and vlan_id != '':
         ifname_list = []
         if ports != '':
             ifname_list = _port_name_list(ports)
         nas_vlan_op("create", {vlan_attr_id: vlan_id, type_attr_id:vlan_if_type, port_type: ifname_list, vlan_type_attr_id: vlan_type})
 
+    elif choice == 'bulk' and vlan_range != '':
+        data = {vlan_attr_id: _vlan_id_list(vlan_range), type_attr_id: vlan_if_type}
+        if ports != '':
+            data[port_type] = _port_name_list(ports)
+        if vlan_type != '':
+            data[vlan_type_attr_id] = vlan_type
+        nas_vlan_bulk_op(data)
+
     elif choice == 'del' and if_name != '':
         nas_vlan_op("delete", {name_attr_id: if_name})
 
@@ -62,39 +62,11 @@ t_std_error NAS_DOT1D_BRIDGE::nas_bridge_l2mc_create(){
     t_std_error rc = STD_ERR_OK;
 
     /*  Create L2 MC groups add add flood control on bridge */
-    if ((rc = ndi_l2mc_group_create(npu_id, &uc_l2mc_group_id)) != STD_ERR_OK) {
-        EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE", "Failed to create unicast L2MC group for %s",
+    if ((rc = flood_groups.create(npu_id, bridge_id)) != STD_ERR_OK) {
+        EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE", "Failed to create L2MC flood groups for %s",
                   bridge_name.c_str());
         return rc;
     }
-
-    if ((rc = ndi_l2mc_group_create(npu_id, &mc_l2mc_group_id)) != STD_ERR_OK) {
-        EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE", "Failed to create multicast L2MC group for %s",
-                  bridge_name.c_str());
-        return rc;
-    }
-
-    if ((rc = ndi_flood_control_1d_bridge(npu_id, bridge_id, uc_l2mc_group_id,
-                                NDI_BRIDGE_PKT_UNICAST, true)) != STD_ERR_OK) {
-        EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE", " Failed to set L2MC group %llu and "
-                "unicast flooding on bridge %s",uc_l2mc_group_id, bridge_name.c_str());
-        return rc;
-    }
-
-    if ((rc = ndi_flood_control_1d_bridge(npu_id, bridge_id, mc_l2mc_group_id,
-                                NDI_BRIDGE_PKT_MULTICAST, true)) != STD_ERR_OK) {
-            EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE", " Failed to set L2MC group %llu and "
-                    "multicast flooding on bridge %s",mc_l2mc_group_id, bridge_name.c_str());
-        return rc;
-    }
-
-    if ((rc = ndi_flood_control_1d_bridge(npu_id, bridge_id, mc_l2mc_group_id,
-                                NDI_BRIDGE_PKT_BROADCAST, true)) != STD_ERR_OK) {
-        EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE", " Failed to set L2MC group %llu and "
-                "broadcast flooding on bridge %s",mc_l2mc_group_id, bridge_name.c_str());
-        return rc;
-    }
-
     return rc;
 }
 
@@ -125,39 +97,11 @@ t_std_error NAS_DOT1D_BRIDGE::nas_bridge_l2mc_delete(){
     t_std_error rc = STD_ERR_OK;
 
     /* Delete L2 MC group   */
-    if ((rc = ndi_flood_control_1d_bridge(npu_id, bridge_id, uc_l2mc_group_id,
-                                    NDI_BRIDGE_PKT_UNICAST, false)) != STD_ERR_OK) {
-        EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE", " Failed to remove L2MC group %llu and "
-                    "unicast flooding on bridge %s",uc_l2mc_group_id, bridge_name.c_str());
-        return rc;
-    }
-
-    if ((rc = ndi_flood_control_1d_bridge(npu_id, bridge_id, mc_l2mc_group_id,
-                                NDI_BRIDGE_PKT_MULTICAST, false)) != STD_ERR_OK) {
-            EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE", " Failed to remove L2MC group %llu and "
-                    "multicast flooding on bridge %s",mc_l2mc_group_id, bridge_name.c_str());
-        return rc;
-    }
-
-    if ((rc = ndi_flood_control_1d_bridge(npu_id, bridge_id, mc_l2mc_group_id,
-                                NDI_BRIDGE_PKT_BROADCAST, false)) != STD_ERR_OK) {
-        EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE", " Failed to remove L2MC group %llu and "
-                "broadcast flooding on bridge %s",mc_l2mc_group_id, bridge_name.c_str());
-        return rc;
-    }
-
-    if ((rc =  ndi_l2mc_group_delete(npu_id, uc_l2mc_group_id)) != STD_ERR_OK) {
-        EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE", " Failed to delete unicast L2MC group for %s",
+    if ((rc = flood_groups.destroy()) != STD_ERR_OK) {
+        EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE", " Failed to delete L2MC flood groups for %s",
                    bridge_name.c_str());
         return rc;
-    };
-
-    if ((rc =  ndi_l2mc_group_delete(npu_id, mc_l2mc_group_id)) != STD_ERR_OK) {
-            EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE", " Failed to delete multicast L2MC group for %s",
-                       bridge_name.c_str());
-        return rc;
-    };
-
+    }
     return rc;
 }
 
@@ -191,8 +135,7 @@ t_std_error NAS_DOT1D_BRIDGE::nas_bridge_npu_delete()
 
 /* TODO: this function args needs to be reduced */
 static t_std_error _nas_npu_add_remove_port_member( hal_ifindex_t ifx, ndi_port_t *port, nas_bridge_id_t bridge_id ,
-                                                   ndi_obj_id_t uc_l2mc_group_id,
-                                                   ndi_obj_id_t mc_l2mc_group_id, hal_vlan_id_t vlan_id,
+                                                   NAS_BRIDGE_FLOOD_GROUPS &flood_groups, hal_vlan_id_t vlan_id,
                                                    nas_port_mode_t port_mode,  bool add_member)
 {
 
@@ -232,32 +175,21 @@ static t_std_error _nas_npu_add_remove_port_member( hal_ifindex_t ifx, ndi_port_
                         port->npu_port, bridge_id);
             return rc;
         }
-        rc = ndi_l2mc_handle_subport_add (port->npu_id, uc_l2mc_group_id, port->npu_port, vlan_id, add_member);
-        if (rc != STD_ERR_OK) {
-            EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE", " Failed to add port %d to the to uc_l2mc group %x in the NPU",
-                        port->npu_port, uc_l2mc_group_id);
-            return rc;
-        }
-
-
-        rc = ndi_l2mc_handle_subport_add (port->npu_id, mc_l2mc_group_id, port->npu_port, vlan_id, add_member);
+        flood_groups.stage(NAS_FLOOD_MEM_PORT, port->npu_id, port->npu_port, vlan_id, NULL,
+                           NAS_FLOOD_GRP_UC | NAS_FLOOD_GRP_MC);
+        rc = flood_groups.flush();
         if (rc != STD_ERR_OK) {
-            EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE", " Failed to add port %d to the to mc_l2mc group %x in the NPU",
-                        port->npu_port, mc_l2mc_group_id);
+            EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE", " Failed to add port %d to the L2MC flood groups in the NPU",
+                        port->npu_port);
             return rc;
         }
 
     } else {
-        rc = ndi_l2mc_handle_subport_add (port->npu_id, uc_l2mc_group_id, port->npu_port, vlan_id, add_member);
-        if(rc != STD_ERR_OK){
-            EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE", " Failed to delete port %d from the uc_l2mc group %x in the NPU",
-                        port->npu_port, uc_l2mc_group_id);
-            return rc;
-        }
-        rc = ndi_l2mc_handle_subport_add (port->npu_id, mc_l2mc_group_id, port->npu_port, vlan_id, add_member);
+        flood_groups.stage(NAS_FLOOD_MEM_PORT, port->npu_id, port->npu_port, vlan_id, NULL, 0);
+        rc = flood_groups.flush();
         if(rc != STD_ERR_OK){
-            EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE", " Failed to delete port %d from mc_l2mc group %x in the NPU",
-                        port->npu_port, mc_l2mc_group_id);
+            EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE", " Failed to delete port %d from the L2MC flood groups in the NPU",
+                        port->npu_port);
             return rc;
         }
 
@@ -273,7 +205,7 @@ static t_std_error _nas_npu_add_remove_port_member( hal_ifindex_t ifx, ndi_port_
 
 /* TOD :REDUCE ARGS IN THIS FUNCT */
 static t_std_error _nas_npu_add_remove_lag_member(npu_id_t npu_id, ndi_obj_id_t lag_id,hal_ifindex_t ifx, nas_bridge_id_t bridge_id ,
-                                                  ndi_obj_id_t uc_l2mc_group_id,ndi_obj_id_t mc_l2mc_group_id,
+                                                  NAS_BRIDGE_FLOOD_GROUPS &flood_groups,
                                                   hal_vlan_id_t vlan_id, nas_port_mode_t port_mode, bool add_member)
 {
 
@@ -311,31 +243,21 @@ static t_std_error _nas_npu_add_remove_lag_member(npu_id_t npu_id, ndi_obj_id_t
                        lag_id, bridge_id);
             return rc;
         }
-        rc = ndi_l2mc_handle_lagport_add (npu_id, uc_l2mc_group_id, lag_id, vlan_id, add_member);
-        if (rc != STD_ERR_OK) {
-            EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE", " Failed to add lag %lu to the to uc_l2mc group %x in the NPU",
-                        lag_id, uc_l2mc_group_id);
-            return rc;
-        }
-
-        rc = ndi_l2mc_handle_lagport_add (npu_id, mc_l2mc_group_id, lag_id, vlan_id, add_member);
+        flood_groups.stage(NAS_FLOOD_MEM_LAG, npu_id, lag_id, vlan_id, NULL,
+                           NAS_FLOOD_GRP_UC | NAS_FLOOD_GRP_MC);
+        rc = flood_groups.flush();
         if (rc != STD_ERR_OK) {
-            EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE", " Failed to add lag %lu to the to mc_l2mc group %x in the NPU",
-                        lag_id, mc_l2mc_group_id);
+            EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE", " Failed to add lag %lu to the L2MC flood groups in the NPU",
+                        lag_id);
             return rc;
         }
 
     } else {
-        rc = ndi_l2mc_handle_lagport_add (npu_id, uc_l2mc_group_id,lag_id, vlan_id, add_member);
+        flood_groups.stage(NAS_FLOOD_MEM_LAG, npu_id, lag_id, vlan_id, NULL, 0);
+        rc = flood_groups.flush();
         if(rc != STD_ERR_OK){
-            EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE", " Failed to delete lag %lu from the uc_l2mc group %x in the NPU",
-                        lag_id, uc_l2mc_group_id);
-            return rc;
-        }
-        rc = ndi_l2mc_handle_lagport_add (npu_id, mc_l2mc_group_id,lag_id, vlan_id, add_member);
-        if(rc != STD_ERR_OK){
-            EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE", " Failed to delete lag %lu from the mc_l2mc group %x in the NPU",
-                        lag_id, mc_l2mc_group_id);
+            EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE", " Failed to delete lag %lu from the L2MC flood groups in the NPU",
+                        lag_id);
             return rc;
         }
 
@@ -433,7 +355,7 @@ t_std_error NAS_DOT1D_BRIDGE::nas_bridge_npu_add_remove_member(std::string &mem_
         return STD_ERR(INTERFACE, FAIL, 0);
     }
 
-    if((rc= dn_hal_get_interface_info(&intf_ctrl)) != STD_ERR_OK) {
+    if((rc= nas_intf_id_resolve(std::string(intf_ctrl.if_name), &intf_ctrl)) != STD_ERR_OK) {
         EV_LOGGING(INTERFACE, ERR, "NAS-BRIDGE",
                    "Interface %s returned error %d", intf_ctrl.if_name, rc);
         return STD_ERR(INTERFACE,FAIL, rc);
@@ -461,8 +383,8 @@ t_std_error NAS_DOT1D_BRIDGE::nas_bridge_npu_add_remove_member(std::string &mem_
 
     if (intf_ctrl.int_type == nas_int_type_LAG) {
 
-        if((rc = _nas_npu_add_remove_lag_member(npu_id,intf_ctrl.lag_id, intf_ctrl.if_index, bridge_id,uc_l2mc_group_id,
-                mc_l2mc_group_id,vlan_id,port_mode,add_member)) != STD_ERR_OK){
+        if((rc = _nas_npu_add_remove_lag_member(npu_id,intf_ctrl.lag_id, intf_ctrl.if_index, bridge_id,flood_groups,
+                vlan_id,port_mode,add_member)) != STD_ERR_OK){
             return rc;
         }
         /* subintf_attr set handled later */
@@ -479,7 +401,7 @@ t_std_error NAS_DOT1D_BRIDGE::nas_bridge_npu_add_remove_member(std::string &mem_
 
         // TODO replace the section with following call
         ndi_port_t _port = { npu_id, intf_ctrl.port_id};
-        if((rc = _nas_npu_add_remove_port_member(intf_ctrl.if_index, &_port, bridge_id_get(), uc_l2mc_group_id,mc_l2mc_group_id,
+        if((rc = _nas_npu_add_remove_port_member(intf_ctrl.if_index, &_port, bridge_id_get(), flood_groups,
                                                   vlan_id, port_mode,  add_member)) != STD_ERR_OK){
             return rc;
         }
@@ -533,24 +455,51 @@ t_std_error NAS_DOT1D_BRIDGE::nas_bridge_add_remove_member(std::string & mem_nam
     return STD_ERR_OK;
 }
 
+/*
+ * Apply a member list update grouped by target: the kernel list first, then the
+ * NPU bridge ports with ports, LAGs and sub interfaces ahead of VxLAN members on add and
+ * behind them on remove. A failure reverts what was applied in reverse order.
+ */
 t_std_error NAS_DOT1D_BRIDGE::nas_bridge_add_remove_memberlist(memberlist_t & m_list, nas_port_mode_t port_mode, bool add)
 {
     t_std_error  rc = STD_ERR_OK;
-    memberlist_t processed_mem_list;
-    for (auto mem : m_list) {
-        if ((rc = nas_bridge_add_remove_member(mem, port_mode, add)) != STD_ERR_OK) {
+    if (m_list.empty()) {
+        return STD_ERR_OK;
+    }
+    typedef std::pair<std::string, nas_int_type_t> npu_member_t;
+    std::vector<npu_member_t> port_members, vxlan_members;
+    for (auto &mem : m_list) {
+        nas_int_type_t mem_type = nas_int_type_VLANSUB_INTF;
+        if ((port_mode != NAS_PORT_TAGGED) &&
+            ((rc = nas_get_int_name_type(mem.c_str(), &mem_type)) != STD_ERR_OK)) {
+            EV_LOGGING(INTERFACE,ERR, "NAS-BRIDGE", " Failed to get member type %s ", mem.c_str());
+            return rc;
+        }
+        ((mem_type == nas_int_type_VXLAN) ? vxlan_members : port_members).push_back(npu_member_t(mem, mem_type));
+    }
+    std::vector<npu_member_t> &first = add ? port_members : vxlan_members;
+    std::vector<npu_member_t> &second = add ? vxlan_members : port_members;
+    first.insert(first.end(), second.begin(), second.end());
+
+    if ((rc = nas_bridge_os_add_remove_memberlist(m_list, port_mode, add)) != STD_ERR_OK) {
+        return rc;
+    }
+    size_t ix = 0;
+    for (; ix < first.size(); ++ix) {
+        if ((rc = nas_bridge_npu_add_remove_member(first[ix].first, first[ix].second, add)) != STD_ERR_OK) {
+            EV_LOGGING(INTERFACE,ERR,"INT-DB-GET","Failed to %s member %s to/from bridge %s",
+                       (add ? "add":"delete"), first[ix].first.c_str(), get_bridge_name());
             break;
         }
-        // Save processed member in a list
-        processed_mem_list.insert(mem);
     }
     if (rc != STD_ERR_OK) {
         // IF any failure then rollback the added or removed members
-        for (auto mem : processed_mem_list) {
-            if ((rc = nas_bridge_add_remove_member(mem, port_mode, !add)) != STD_ERR_OK) {
-                EV_LOGGING(INTERFACE,ERR,"INT-DB-GET","Failed to rollback member %s update", mem.c_str());
+        while (ix-- > 0) {
+            if (nas_bridge_npu_add_remove_member(first[ix].first, first[ix].second, !add) != STD_ERR_OK) {
+                EV_LOGGING(INTERFACE,ERR,"INT-DB-GET","Failed to rollback member %s update", first[ix].first.c_str());
             }
         }
+        nas_bridge_os_add_remove_memberlist(m_list, port_mode, !add);
     }
     return rc;
 }
@@ -579,7 +528,7 @@ t_std_error NAS_DOT1D_BRIDGE:: nas_bridge_associate_npu_port(std::string &mem_na
 
     }
     /* TODO : this association code path needs to be tested */
-    rc =  _nas_npu_add_remove_port_member(if_index,port, bridge_id_get(), uc_l2mc_group_id, mc_l2mc_group_id,
+    rc =  _nas_npu_add_remove_port_member(if_index,port, bridge_id_get(), flood_groups,
                                             vlan_id, port_mode,  associate);
     if (rc == STD_ERR_OK) {
         nas_bridge_set_tag_untag_drop(if_index, port);
@@ -603,12 +552,19 @@ t_std_error NAS_DOT1D_BRIDGE::nas_bridge_npu_add_vxlan_member(std::string mem_na
         return STD_ERR(INTERFACE, FAIL, 0);
     }
     /*  2. Add tunnels corresponding to all remote endpoint in the npu */
+    /*  Flood group membership of all the tunnels is programmed in one pass after they are created */
+    flood_deferred = true;
     vxlan_obj->nas_interface_for_each_remote_endpoint([this](BASE_CMN_VNI_t vni, hal_ip_addr_t &local_ip, remote_endpoint_t &rm_endpoint) {
             /*  Get bridge_oid, vni, remote endpoint IP, local IP,   */
             /*  Call NDI API to create tunnel  */
             /*  Add the tunnel to L2MC group if flooding enabled */
         nas_bridge_add_remote_endpoint(vni, local_ip, &rm_endpoint);
     });
+    flood_deferred = false;
+    if (flood_groups.flush() != STD_ERR_OK) {
+        EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE", "Failed to add remote endpoints of %s to the L2MC flood groups of %s",
+                   mem_name.c_str(), bridge_name.c_str());
+    }
     /*
      *      create tunnel with VNI, bridge Id, remote endpoint, local endpoint
      *      if flooding flag enable then Add the tunnel to the L2MC group
@@ -632,6 +588,14 @@ t_std_error NAS_DOT1D_BRIDGE::nas_bridge_npu_remove_vxlan_member(std::string mem
         return STD_ERR(INTERFACE, FAIL, 0);
     }
     /*  2. Add tunnels corresponding to all remote endpoint in the npu */
+    /*  Take all the tunnels out of the flood groups in one pass before deleting them */
+    vxlan_obj->nas_interface_for_each_remote_endpoint([&](BASE_CMN_VNI_t vni, hal_ip_addr_t &local_ip, remote_endpoint_t &rm_endpoint) {
+        flood_groups.stage(NAS_FLOOD_MEM_TUNNEL, npu_id, rm_endpoint.tunnel_id, 0, NULL, 0);
+    });
+    if (flood_groups.flush() != STD_ERR_OK) {
+        EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE", "Failed to remove remote endpoints of %s from the L2MC flood groups of %s",
+                   mem_name.c_str(), bridge_name.c_str());
+    }
     vxlan_obj->nas_interface_for_each_remote_endpoint([&](BASE_CMN_VNI_t vni, hal_ip_addr_t &local_ip, remote_endpoint_t &rm_endpoint) {
             /*  Call NDI API to create tunnel  */
             /*  Add the tunnel to L2MC group if flooding enabled */
@@ -697,23 +661,12 @@ t_std_error NAS_DOT1D_BRIDGE::nas_bridge_add_remote_endpoint(BASE_CMN_VNI_t vni,
         EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE", "Failed to add remote endpoint to the bridge %s", bridge_name.c_str());
         return rc;
     }
-    if (rm_endpoint->uc_flooding_enabled) {
-        rc =  ndi_l2mc_handle_tunnel_member(npu_id, uc_l2mc_group_id, rm_endpoint->tunnel_id, &(rm_endpoint->remote_ip), true);
-        if (rc != STD_ERR_OK) {
-            EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE", "Failed to add remote endpoint to the uc_l2mc group %s", bridge_name.c_str());
-            return rc;
-        }
-        uc_l2mc_members.insert(rm_endpoint->tunnel_id);
-
-    }
-
-    if (rm_endpoint->mc_flooding_enabled && rm_endpoint->bc_flooding_enabled ) {
-        rc =  ndi_l2mc_handle_tunnel_member(npu_id, mc_l2mc_group_id, rm_endpoint->tunnel_id, &(rm_endpoint->remote_ip), true);
-        if (rc != STD_ERR_OK) {
-            EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE", "Failed to add remote endpoint to the mc_l2mc group %s", bridge_name.c_str());
+    nas_bridge_stage_remote_endpoint_flooding(rm_endpoint);
+    if (!flood_deferred) {
+        if ((rc = flood_groups.flush()) != STD_ERR_OK) {
+            EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE", "Failed to add remote endpoint to the L2MC flood groups %s", bridge_name.c_str());
             return rc;
         }
-        mc_l2mc_members.insert(rm_endpoint->tunnel_id);
     }
 
     if (rm_endpoint->mac_learn_mode) {
@@ -728,11 +681,24 @@ t_std_error NAS_DOT1D_BRIDGE::nas_bridge_add_remote_endpoint(BASE_CMN_VNI_t vni,
 }
 
 
+/*  Stage the flood groups a remote endpoint tunnel belongs to, programmed on the next flush */
+t_std_error NAS_DOT1D_BRIDGE::nas_bridge_stage_remote_endpoint_flooding(remote_endpoint_t *rm_endpoint)
+{
+    uint8_t groups = 0;
+    if (rm_endpoint->uc_flooding_enabled) {
+        groups |= NAS_FLOOD_GRP_UC;
+    }
+    if (rm_endpoint->mc_flooding_enabled && rm_endpoint->bc_flooding_enabled) {
+        groups |= NAS_FLOOD_GRP_MC;
+    }
+    flood_groups.stage(NAS_FLOOD_MEM_TUNNEL, npu_id, rm_endpoint->tunnel_id, 0, &(rm_endpoint->remote_ip), groups);
+    return STD_ERR_OK;
+}
+
 t_std_error NAS_DOT1D_BRIDGE::nas_bridge_set_flooding(remote_endpoint_t *rm_endpoint)
 {
     t_std_error rc = STD_ERR_OK;
-    if ((uc_l2mc_group_id == INVALID_L2MC_GROUP_ID) || (mc_l2mc_group_id == INVALID_L2MC_GROUP_ID) ||
-         (rm_endpoint->tunnel_id == NAS_INVALID_TUNNEL_ID)) {
+    if (!flood_groups.valid() || (rm_endpoint->tunnel_id == NAS_INVALID_TUNNEL_ID)) {
         EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE", "Failed to add remote endpoint: l2mc or tunnel id invalid %s",
                                    bridge_name.c_str());
         return STD_ERR(INTERFACE,FAIL, 0);
@@ -740,22 +706,10 @@ t_std_error NAS_DOT1D_BRIDGE::nas_bridge_set_flooding(remote_endpoint_t *rm_endp
     EV_LOGGING(INTERFACE,DEBUG,"NAS-BRIDGE", "Set flooding  to %d in NDI for bridge %s",
                                  rm_endpoint->flooding_enabled, bridge_name.c_str());
 
-    if (rm_endpoint->uc_flooding_enabled) {
-        rc =  ndi_l2mc_handle_tunnel_member(npu_id, uc_l2mc_group_id, rm_endpoint->tunnel_id, &(rm_endpoint->remote_ip), true);
-        if (rc != STD_ERR_OK) {
-            EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE", "Failed to add remote endpoint to the uc_l2mc group %s", bridge_name.c_str());
-            return rc;
-        }
-        uc_l2mc_members.insert(rm_endpoint->tunnel_id);
-    }
-
-    if (rm_endpoint->mc_flooding_enabled && rm_endpoint->bc_flooding_enabled) {
-        rc =  ndi_l2mc_handle_tunnel_member(npu_id, mc_l2mc_group_id, rm_endpoint->tunnel_id, &(rm_endpoint->remote_ip), true);
-        if (rc != STD_ERR_OK) {
-            EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE", "Failed to add remote endpoint to the mc_l2mc group %s", bridge_name.c_str());
-            return rc;
-        }
-        mc_l2mc_members.insert(rm_endpoint->tunnel_id);
+    nas_bridge_stage_remote_endpoint_flooding(rm_endpoint);
+    if ((rc = flood_groups.flush()) != STD_ERR_OK) {
+        EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE", "Failed to update remote endpoint flooding for bridge %s", bridge_name.c_str());
+        return rc;
     }
 
     return rc;
@@ -772,22 +726,10 @@ t_std_error NAS_DOT1D_BRIDGE::nas_bridge_remove_remote_endpoint(BASE_CMN_VNI_t v
     std_ip_to_string((const hal_ip_addr_t*) &rm_endpoint->remote_ip, buff, HAL_INET6_TEXT_LEN);
     EV_LOGGING(INTERFACE,DEBUG,"NAS-BRIDGE", "Remove remote endpoint :br %s, remote ip-address %s", bridge_name.c_str(), buff);
 
-    if(uc_l2mc_members.find(rm_endpoint->tunnel_id) != uc_l2mc_members.end()){
-        rc =  ndi_l2mc_handle_tunnel_member(npu_id, uc_l2mc_group_id, rm_endpoint->tunnel_id, NULL, false);
-        if (rc != STD_ERR_OK) {
-            EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE", "Failed to remove remote endpoint to the uc_l2mc group %s", bridge_name.c_str());
-            return rc;
-        }
-        uc_l2mc_members.erase(rm_endpoint->tunnel_id);
-    }
-
-    if(mc_l2mc_members.find(rm_endpoint->tunnel_id) != mc_l2mc_members.end()){
-        rc =  ndi_l2mc_handle_tunnel_member(npu_id, mc_l2mc_group_id, rm_endpoint->tunnel_id, NULL, false);
-        if (rc != STD_ERR_OK) {
-            EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE", "Failed to remove remote endpoint to the mc_l2mc group %s", bridge_name.c_str());
-            return rc;
-        }
-        mc_l2mc_members.erase(rm_endpoint->tunnel_id);
+    flood_groups.stage(NAS_FLOOD_MEM_TUNNEL, npu_id, rm_endpoint->tunnel_id, 0, NULL, 0);
+    if ((rc = flood_groups.flush()) != STD_ERR_OK) {
+        EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE", "Failed to remove remote endpoint from the L2MC flood groups %s", bridge_name.c_str());
+        return rc;
     }
 
     nas_com_id_value_t tunnel_params[2]; /*  VNI, local IP, Remove IP, */
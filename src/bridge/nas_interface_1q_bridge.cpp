@@ -22,8 +22,12 @@
 #include "dell-base-interface-common.h"
 #include "nas_int_utils.h"
 #include "bridge/nas_interface_1q_bridge.h"
+#include "bridge/nas_interface_vlan_scale.h"
 #include "interface/nas_interface_utils.h"
 
+#include <map>
+#include <vector>
+
 
 /************************** PROTECTED ******************************/
 /** NPU Implementation */
@@ -78,7 +82,7 @@ t_std_error NAS_DOT1Q_BRIDGE::nas_bridge_npu_delete() {
     bridge_vlan_id = NAS_VLAN_ID_INVALID;
 
     /** Delete all vlan members in NPU */
-    for (memberlist_t::iterator it = tagged_members.begin() ; it != tagged_members.end(); ++it) {
+    for (auto it = tagged_members.begin() ; it != tagged_members.end(); ++it) {
         EV_LOGGING(INTERFACE, DEBUG, "DOT-1Q", "Found intf %s for deletion", *it->c_str());
     }
 
@@ -124,6 +128,66 @@ static t_std_error _nas_npu_add_remove_lag_to_vlan(ndi_obj_id_t *lag_id, hal_vla
    return rc;
 }
 
+/*
+ * Untagged members are added in one NDI call per NPU for ports and one for LAGs.
+ * If a batch is rejected the members of that batch are retried one by one so a
+ * single bad member does not keep the rest out of the VLAN. A batch may fail
+ * after adding part of the list, so a failed retry is not taken to mean the
+ * member is missing: the PVID and the tag/untag drop setting are applied to
+ * every member either way.
+ */
+void NAS_DOT1Q_BRIDGE::nas_bridge_npu_add_untagged_port_list(npu_id_t npu,
+                                std::vector<interface_ctrl_t> &members)
+{
+    hal_vlan_id_t vlan_id = bridge_vlan_id;
+    std::vector<ndi_port_t> ports;
+    for (auto &mem : members) {
+        ports.push_back({mem.npu_id, mem.port_id});
+    }
+    ndi_port_list_t port_list{ports.size(), ports.data()};
+    bool bulk_ok = (ndi_add_ports_to_vlan(npu, vlan_id, NULL, &port_list) == STD_ERR_OK);
+    if (!bulk_ok) {
+        EV_LOGGING(INTERFACE, INFO, "NAS-BRIDGE",
+                "Bulk add of %lu untagged ports to Vlan %d failed, adding one by one",
+                ports.size(), vlan_id);
+    }
+    for (size_t ix = 0; ix < members.size(); ++ix) {
+        if (!bulk_ok) {
+            ndi_port_list_t mem_list{1, &ports[ix]};
+            if (ndi_add_ports_to_vlan(ports[ix].npu_id, vlan_id, NULL, &mem_list) != STD_ERR_OK) {
+                EV_LOGGING(INTERFACE,INFO,"NAS-BRIDGE","Untag mem add : Retry for member %s to the Vlan %d failed,"
+                     " it may have been added by the bulk call", members[ix].if_name, vlan_id);
+            }
+        }
+        ndi_set_port_vid(ports[ix].npu_id, ports[ix].npu_port, vlan_id);
+        nas_bridge_set_tag_untag_drop(members[ix].if_index, &ports[ix]);
+    }
+}
+
+void NAS_DOT1Q_BRIDGE::nas_bridge_npu_add_untagged_lag_list(std::vector<interface_ctrl_t> &members)
+{
+    hal_vlan_id_t vlan_id = bridge_vlan_id;
+    std::vector<ndi_obj_id_t> lags;
+    for (auto &mem : members) {
+        lags.push_back(mem.lag_id);
+    }
+    bool bulk_ok = (ndi_add_lag_to_vlan(0, vlan_id, NULL, 0, lags.data(), lags.size()) == STD_ERR_OK);
+    if (!bulk_ok) {
+        EV_LOGGING(INTERFACE, INFO, "NAS-BRIDGE",
+                "Bulk add of %lu untagged lags to Vlan %d failed, adding one by one",
+                lags.size(), vlan_id);
+    }
+    for (size_t ix = 0; ix < members.size(); ++ix) {
+        if (!bulk_ok &&
+            (ndi_add_lag_to_vlan(0, vlan_id, NULL, 0, &lags[ix], 1) != STD_ERR_OK)) {
+            EV_LOGGING(INTERFACE,INFO,"NAS-BRIDGE","Untag lag add : Retry for member %s to the Vlan %d failed,"
+                 " it may have been added by the bulk call", members[ix].if_name, vlan_id);
+        }
+        ndi_set_lag_pvid(0, lags[ix], vlan_id);
+        nas_bridge_set_lag_tag_untag_drop(npu_id, lags[ix], members[ix].if_index);
+    }
+}
+
 t_std_error NAS_DOT1Q_BRIDGE::nas_bridge_npu_update_all_untagged_members(void)
 {
     t_std_error rc = STD_ERR_OK;
@@ -131,20 +195,26 @@ t_std_error NAS_DOT1Q_BRIDGE::nas_bridge_npu_update_all_untagged_members(void)
     if (bridge_vlan_id == 0) {
         return STD_ERR(INTERFACE,FAIL, rc);
     }
+
+    /*  Resolve all members first, served from the interface id cache */
+    std::vector<interface_ctrl_t> members;
+    members.reserve(untagged_members.size());
     for (auto it = untagged_members.begin(); it != untagged_members.end(); ++it) {
         interface_ctrl_t intf_ctrl;
         memset(&intf_ctrl, 0, sizeof(interface_ctrl_t));
-        intf_ctrl.q_type = HAL_INTF_INFO_FROM_IF_NAME;
-        safestrncpy(intf_ctrl.if_name, &(*it->c_str()), sizeof(intf_ctrl.if_name));
-        if((rc= dn_hal_get_interface_info(&intf_ctrl)) != STD_ERR_OK) {
+        if((rc= nas_intf_id_resolve(it.id(), &intf_ctrl)) != STD_ERR_OK) {
             EV_LOGGING(INTERFACE, ERR, "NAS-BRIDGE",
-                   "Interface %s returned error %d", intf_ctrl.if_name, rc);
+                   "Interface %s returned error %d", it->c_str(), rc);
             return STD_ERR(INTERFACE,FAIL, rc);
         }
+        members.push_back(intf_ctrl);
+    }
 
-    /*  Change the mode to L2 if it is not already L2 */
-        nas_port_mode_t port_mode = NAS_PORT_UNTAGGED;
-        if_master_info_t master_info = { nas_int_type_VLAN, port_mode, if_index };
+    /*  Single pass over the master list: change the mode to L2 if it is not already L2 */
+    std::map<npu_id_t, std::vector<interface_ctrl_t>> port_members;
+    std::vector<interface_ctrl_t> lag_members;
+    if_master_info_t master_info = { nas_int_type_VLAN, NAS_PORT_UNTAGGED, if_index };
+    for (auto &intf_ctrl : members) {
         BASE_IF_MODE_t new_intf_mode;
         bool mode_change = false;
         if(!nas_intf_add_master(intf_ctrl.if_index, master_info, &new_intf_mode, &mode_change)){
@@ -159,28 +229,20 @@ t_std_error NAS_DOT1Q_BRIDGE::nas_bridge_npu_update_all_untagged_members(void)
             }
         }
         if (intf_ctrl.int_type == nas_int_type_LAG) {
-            rc = _nas_npu_add_remove_lag_to_vlan(&intf_ctrl.lag_id, bridge_vlan_id, NAS_PORT_UNTAGGED, true);
-            if (rc == STD_ERR_OK) {
-                nas_bridge_set_lag_tag_untag_drop(npu_id, intf_ctrl.lag_id, intf_ctrl.if_index);
-            } else {
-                EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE","Untag lag add : Failed to add member %s to the Vlan %d in the NPU",
-                 intf_ctrl.if_name, bridge_vlan_id);
-            }
-
+            lag_members.push_back(intf_ctrl);
         } else if (((intf_ctrl.int_type == nas_int_type_PORT) || (intf_ctrl.int_type == nas_int_type_FC))&&
             !(nas_is_virtual_port(intf_ctrl.if_index))) {
-            /*  TODO Call NDI function to Add/deleting phy port to the .1D bridge */
-            ndi_port_t ndi_port = {intf_ctrl.npu_id, intf_ctrl.port_id};
-            rc = _nas_npu_add_remove_port_to_vlan(&ndi_port, bridge_vlan_id, NAS_PORT_UNTAGGED, true);
-            if (rc == STD_ERR_OK) {
-                nas_bridge_set_tag_untag_drop(intf_ctrl.if_index, &ndi_port);
-            } else {
-                EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE","Untag mem add : Failed to add member %s to the Vlan %d in the NPU",
-                 intf_ctrl.if_name, bridge_vlan_id);
-
-            }
+            port_members[intf_ctrl.npu_id].push_back(intf_ctrl);
         }
     }
+
+    /*  Program the NPU in batches */
+    for (auto &npu_ports : port_members) {
+        nas_bridge_npu_add_untagged_port_list(npu_ports.first, npu_ports.second);
+    }
+    if (!lag_members.empty()) {
+        nas_bridge_npu_add_untagged_lag_list(lag_members);
+    }
     return STD_ERR_OK;
 }
 
@@ -293,7 +355,7 @@ t_std_error NAS_DOT1Q_BRIDGE::nas_bridge_npu_add_remove_member(std::string &mem_
                                  "Invalid Member type %d",  bridge_name.c_str(), intf_ctrl.if_index, mem_type);
         return STD_ERR(INTERFACE, FAIL, 0);
     }
-    if((rc= dn_hal_get_interface_info(&intf_ctrl)) != STD_ERR_OK) {
+    if((rc= nas_intf_id_resolve(std::string(intf_ctrl.if_name), &intf_ctrl)) != STD_ERR_OK) {
         EV_LOGGING(INTERFACE, ERR, "NAS-BRIDGE",
                    "Interface %s returned error %d", intf_ctrl.if_name, rc);
         return STD_ERR(INTERFACE,FAIL, rc);
@@ -410,7 +472,7 @@ t_std_error NAS_DOT1Q_BRIDGE::nas_bridge_add_remove_member(std::string & mem_nam
     return STD_ERR_OK;
 }
 
-t_std_error NAS_DOT1Q_BRIDGE::nas_bridge_add_remove_memberlist(memberlist_t & m_list, nas_port_mode_t port_mode, bool add)
+t_std_error NAS_DOT1Q_BRIDGE::nas_bridge_add_remove_each_member(memberlist_t & m_list, nas_port_mode_t port_mode, bool add)
 {
     t_std_error  rc = STD_ERR_OK;
     memberlist_t processed_mem_list;
@@ -431,6 +493,217 @@ t_std_error NAS_DOT1Q_BRIDGE::nas_bridge_add_remove_memberlist(memberlist_t & m_
     }
     return rc;
 }
+/*
+ * Resolve every member of the list before anything is programmed: tagged members to their
+ * parent port or LAG, grouped per NPU for ports and in one list for LAGs.
+ */
+t_std_error NAS_DOT1Q_BRIDGE::nas_bridge_npu_batch_get(memberlist_t & m_list, nas_port_mode_t port_mode,
+                                                      nas_bridge_npu_batch_t &batch)
+{
+    t_std_error rc = STD_ERR_OK;
+    for (auto &mem : m_list) {
+        NAS_INTERFACE *_intf_obj = nas_interface_map_obj_get(mem);
+        if (_intf_obj == nullptr) {
+            EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE", "interface object not found  %s", mem.c_str());
+            return STD_ERR(INTERFACE,FAIL, 0);
+        }
+        std::string npu_intf = mem;
+        if (port_mode == NAS_PORT_TAGGED) {
+            NAS_VLAN_INTERFACE *vlan_intf_obj = dynamic_cast<NAS_VLAN_INTERFACE *>(_intf_obj);
+            if ((vlan_intf_obj == nullptr) || (vlan_intf_obj->vlan_id != bridge_vlan_id)) {
+                EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE", "Member %s is not a sub interface of VLAN %d",
+                           mem.c_str(), bridge_vlan_id);
+                return STD_ERR(INTERFACE, FAIL, 0);
+            }
+            npu_intf = vlan_intf_obj->parent_intf_name;
+        }
+        nas_int_type_t mem_type;
+        if ((rc = nas_get_int_name_type(npu_intf.c_str(), &mem_type)) != STD_ERR_OK) {
+            EV_LOGGING(INTERFACE,ERR, "NAS-BRIDGE", "Failed to get member type %s ", npu_intf.c_str());
+            return rc;
+        }
+        /*  Management ports are only kernel members and only of a management VLAN */
+        bool is_mgmt_port = (mem_type == nas_int_type_MGMT);
+        if ((nas_bridge_sub_type_get() == BASE_IF_VLAN_TYPE_MANAGEMENT) && !is_mgmt_port) {
+            return STD_ERR(INTERFACE, FAIL, 0);
+        }
+        if (is_mgmt_port) {
+            batch.kernel_only.push_back(&mem);
+            continue;
+        }
+        if ((mem_type != nas_int_type_PORT) && (mem_type != nas_int_type_FC) && (mem_type != nas_int_type_LAG)) {
+            EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE", "Member update failed for bridge %s member %s: "
+                       "Invalid Member type %d", bridge_name.c_str(), mem.c_str(), mem_type);
+            return STD_ERR(INTERFACE, FAIL, 0);
+        }
+
+        interface_ctrl_t intf_ctrl;
+        memset(&intf_ctrl, 0, sizeof(interface_ctrl_t));
+        if ((rc = nas_intf_id_resolve(npu_intf, &intf_ctrl)) != STD_ERR_OK) {
+            EV_LOGGING(INTERFACE, ERR, "NAS-BRIDGE", "Interface %s returned error %d", npu_intf.c_str(), rc);
+            return STD_ERR(INTERFACE,FAIL, rc);
+        }
+        if (intf_ctrl.int_type == nas_int_type_LAG) {
+            batch.lags.push_back(intf_ctrl.lag_id);
+        } else if (!nas_is_virtual_port(intf_ctrl.if_index)) {
+            batch.ports[intf_ctrl.npu_id].push_back({intf_ctrl.npu_id, intf_ctrl.port_id});
+        }
+        batch.names.push_back(&mem);
+        batch.objs.push_back(_intf_obj);
+        batch.intfs.push_back(intf_ctrl);
+    }
+    return STD_ERR_OK;
+}
+
+/*  One NDI call per NPU for ports and one for LAGs, reverted in reverse order on failure */
+t_std_error NAS_DOT1Q_BRIDGE::nas_bridge_npu_batch_apply(nas_bridge_npu_batch_t &batch,
+                                                        nas_port_mode_t port_mode, bool add)
+{
+    t_std_error rc = STD_ERR_OK;
+    bool tagged = (port_mode == NAS_PORT_TAGGED);
+    std::vector<npu_id_t> done;
+
+    auto port_update = [&](npu_id_t npu, std::vector<ndi_port_t> &ports, bool _add) -> t_std_error {
+        ndi_port_list_t port_list = {ports.size(), ports.data()};
+        ndi_port_list_t *t_list = tagged ? &port_list : NULL;
+        ndi_port_list_t *ut_list = tagged ? NULL : &port_list;
+        return _add ? ndi_add_ports_to_vlan(npu, bridge_vlan_id, t_list, ut_list) :
+                      ndi_del_ports_from_vlan(npu, bridge_vlan_id, t_list, ut_list);
+    };
+
+    for (auto &it : batch.ports) {
+        if ((rc = port_update(it.first, it.second, add)) != STD_ERR_OK) {
+            EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE", "Failed to %s %lu ports %s Vlan %d in NPU %d",
+                       add ? "add" : "remove", it.second.size(), add ? "to" : "from", bridge_vlan_id, it.first);
+            break;
+        }
+        done.push_back(it.first);
+    }
+    if ((rc == STD_ERR_OK) && !batch.lags.empty()) {
+        ndi_obj_id_t *lags = batch.lags.data();
+        size_t cnt = batch.lags.size();
+        rc = add ? ndi_add_lag_to_vlan(0, bridge_vlan_id, tagged ? lags : NULL, tagged ? cnt : 0,
+                                       tagged ? NULL : lags, tagged ? 0 : cnt) :
+                   ndi_del_lag_from_vlan(0, bridge_vlan_id, tagged ? lags : NULL, tagged ? cnt : 0,
+                                         tagged ? NULL : lags, tagged ? 0 : cnt);
+        if (rc != STD_ERR_OK) {
+            EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE", "Failed to %s %lu lags %s Vlan %d",
+                       add ? "add" : "remove", cnt, add ? "to" : "from", bridge_vlan_id);
+        }
+    }
+    if (rc != STD_ERR_OK) {
+        for (auto it = done.rbegin(); it != done.rend(); ++it) {
+            if (port_update(*it, batch.ports[*it], !add) != STD_ERR_OK) {
+                EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE", "Failed to rollback ports of Vlan %d in NPU %d",
+                           bridge_vlan_id, *it);
+            }
+        }
+    }
+    return rc;
+}
+
+/*  Change the mode of the members to L2 (or back) before they are programmed in the NPU */
+void NAS_DOT1Q_BRIDGE::nas_bridge_npu_batch_masters_update(nas_bridge_npu_batch_t &batch,
+                                                          nas_port_mode_t port_mode, bool add)
+{
+    if_master_info_t master_info = { nas_int_type_VLAN, port_mode, if_index };
+    for (auto &intf_ctrl : batch.intfs) {
+        BASE_IF_MODE_t new_intf_mode;
+        bool mode_change = false;
+        if (add) {
+            if(!nas_intf_add_master(intf_ctrl.if_index, master_info, &new_intf_mode, &mode_change)){
+                EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE","Failed to add master %s for memeber port %d",
+                                        bridge_name.c_str(), intf_ctrl.if_index);
+            }
+        } else {
+            if(!nas_intf_del_master(intf_ctrl.if_index, master_info, &new_intf_mode, &mode_change)){
+                EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE","Failed to delete master %s for memeber port %d",
+                                        bridge_name.c_str(), intf_ctrl.if_index);
+            }
+        }
+        if (mode_change && (nas_intf_handle_intf_mode_change(intf_ctrl.if_index, new_intf_mode) == false)) {
+            EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE", "Update to NAS-L3 about interface mode change failed(%s)",
+                    intf_ctrl.if_name);
+        }
+    }
+}
+
+/*  Per member attributes and the bridge member list, once the NPU accepted the batch */
+void NAS_DOT1Q_BRIDGE::nas_bridge_npu_batch_finish(nas_bridge_npu_batch_t &batch,
+                                                  nas_port_mode_t port_mode, bool add)
+{
+    for (size_t ix = 0; ix < batch.intfs.size(); ++ix) {
+        interface_ctrl_t &intf_ctrl = batch.intfs[ix];
+        if (add) {
+            batch.objs[ix]->nas_br_member_type_1q_set();
+        } else {
+            batch.objs[ix]->nas_br_member_type_none_set();
+            if(!nas_intf_cleanup_l2mc_config(intf_ctrl.if_index, bridge_vlan_id)) {
+                EV_LOGGING(INTERFACE, ERR, "NAS-Vlan",
+                       "Error cleaning L2MC membership for interface %s", intf_ctrl.if_name);
+            }
+        }
+        if (intf_ctrl.int_type == nas_int_type_LAG) {
+            if (add && (port_mode == NAS_PORT_UNTAGGED)) {
+                ndi_set_lag_pvid(0, intf_ctrl.lag_id, bridge_vlan_id);
+            }
+            nas_bridge_set_lag_tag_untag_drop(npu_id, intf_ctrl.lag_id, intf_ctrl.if_index);
+            if (add) {
+                nas_interface_utils_config_lag_1q_mac_learn_mode(std::string(intf_ctrl.if_name), npu_id, intf_ctrl.lag_id);
+            }
+        } else if (!nas_is_virtual_port(intf_ctrl.if_index)) {
+            ndi_port_t ndi_port = {intf_ctrl.npu_id, intf_ctrl.port_id};
+            if (add && (port_mode == NAS_PORT_UNTAGGED)) {
+                ndi_set_port_vid(ndi_port.npu_id, ndi_port.npu_port, bridge_vlan_id);
+            }
+            nas_bridge_set_tag_untag_drop(intf_ctrl.if_index, &ndi_port);
+            if (add) {
+                nas_interface_utils_config_port_1q_mac_learn_mode(std::string(intf_ctrl.if_name), &ndi_port);
+            }
+        }
+        nas_bridge_update_member_list(*batch.names[ix], port_mode, add);
+    }
+    for (auto mem : batch.kernel_only) {
+        nas_bridge_update_member_list(*mem, port_mode, add);
+    }
+}
+
+/*
+ * Apply a member list update grouped by target: the kernel list first, then the
+ * NPU ports and LAGs in one call per group. A failure reverts the groups already applied
+ * in reverse order.
+ */
+t_std_error NAS_DOT1Q_BRIDGE::nas_bridge_add_remove_memberlist(memberlist_t & m_list, nas_port_mode_t port_mode, bool add)
+{
+    t_std_error  rc = STD_ERR_OK;
+    if (m_list.empty()) {
+        return STD_ERR_OK;
+    }
+    /*  The first tagged member sets the VLAN of a bridge model bridge, keep the per member path for it */
+    if (bridge_vlan_id == NAS_VLAN_ID_INVALID) {
+        return nas_bridge_add_remove_each_member(m_list, port_mode, add);
+    }
+
+    nas_bridge_npu_batch_t batch;
+    if ((rc = nas_bridge_npu_batch_get(m_list, port_mode, batch)) != STD_ERR_OK) {
+        EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE","Failed to resolve memberlist of bridge %s", bridge_name.c_str());
+        return rc;
+    }
+    if ((rc = nas_bridge_os_add_remove_memberlist(m_list, port_mode, add)) != STD_ERR_OK) {
+        return rc;
+    }
+    nas_bridge_npu_batch_masters_update(batch, port_mode, add);
+    if ((rc = nas_bridge_npu_batch_apply(batch, port_mode, add)) != STD_ERR_OK) {
+        nas_bridge_npu_batch_masters_update(batch, port_mode, !add);
+        if (nas_bridge_os_add_remove_memberlist(m_list, port_mode, !add) != STD_ERR_OK) {
+            EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE","Failed to rollback kernel members of bridge %s",
+                       bridge_name.c_str());
+        }
+        return rc;
+    }
+    nas_bridge_npu_batch_finish(batch, port_mode, add);
+    return STD_ERR_OK;
+}
 t_std_error NAS_DOT1Q_BRIDGE::nas_bridge_associate_npu_port(std::string &mem_name, ndi_port_t *ndi_port, nas_port_mode_t port_mode, bool associate)
 {
     t_std_error rc  = STD_ERR_OK;
@@ -486,17 +759,31 @@ t_std_error NAS_DOT1Q_BRIDGE::nas_bridge_intf_cntrl_block_register(hal_intf_reg_
     return STD_ERR_OK;
 }
 
+static void _nas_bridge_fill_vlan_info(NAS_DOT1Q_BRIDGE *br, cps_api_object_t obj)
+{
+    if (br->get_bridge_model() == INT_VLAN_MODEL) {
+        cps_api_object_attr_add_u32(obj, DELL_IF_IF_INTERFACES_INTERFACE_VLAN_TYPE,
+                                 br->nas_bridge_sub_type_get());
+        cps_api_object_attr_add_u32(obj, BASE_IF_VLAN_IF_INTERFACES_INTERFACE_ID, br->nas_bridge_vlan_id_get());
+    }
+}
+
 cps_api_return_code_t NAS_DOT1Q_BRIDGE::nas_bridge_fill_info(cps_api_object_t obj)
 {
+    _nas_bridge_fill_vlan_info(this, obj);
     if (get_bridge_model() == INT_VLAN_MODEL) {
-        cps_api_object_attr_add_u32(obj, DELL_IF_IF_INTERFACES_INTERFACE_VLAN_TYPE,
-                                 nas_bridge_sub_type_get());
-        cps_api_object_attr_add_u32(obj, BASE_IF_VLAN_IF_INTERFACES_INTERFACE_ID, nas_bridge_vlan_id_get());
+        nas_vlan_scale_fill_tagged_members(bridge_vlan_id, obj);
     }
     return nas_bridge_fill_com_info(obj);
 
 }
 
+cps_api_return_code_t NAS_DOT1Q_BRIDGE::nas_bridge_fill_summary(cps_api_object_t obj)
+{
+    _nas_bridge_fill_vlan_info(this, obj);
+    return nas_bridge_fill_com_info(obj, false);
+}
+
 t_std_error NAS_DOT1Q_BRIDGE::nas_bridge_set_learning_disable(bool disable){
 
     if(ndi_set_vlan_learning(0, bridge_vlan_id, disable) != STD_ERR_OK) {
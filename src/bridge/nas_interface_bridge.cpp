@@ -42,7 +42,7 @@ bool NAS_BRIDGE::nas_bridge_untagged_member_present(void) {
     return true;
 }
 
-t_std_error NAS_BRIDGE::nas_bridge_check_tagged_membership(std::string mem_name, bool *present)
+t_std_error NAS_BRIDGE::nas_bridge_check_tagged_membership(const std::string &mem_name, bool *present)
 {
     *present = false;
     auto itr = tagged_members.find(mem_name);
@@ -53,7 +53,7 @@ t_std_error NAS_BRIDGE::nas_bridge_check_tagged_membership(std::string mem_name,
     return STD_ERR_OK;
 }
 
-t_std_error NAS_BRIDGE::nas_bridge_check_untagged_membership(std::string mem_name, bool *present)
+t_std_error NAS_BRIDGE::nas_bridge_check_untagged_membership(const std::string &mem_name, bool *present)
 {
     *present = false;
     auto itr = untagged_members.find(mem_name);
@@ -64,7 +64,7 @@ t_std_error NAS_BRIDGE::nas_bridge_check_untagged_membership(std::string mem_nam
     return STD_ERR_OK;
 }
 
-t_std_error NAS_BRIDGE::nas_bridge_check_membership(std::string mem_name, bool *present) {
+t_std_error NAS_BRIDGE::nas_bridge_check_membership(const std::string &mem_name, bool *present) {
 
     if ((nas_bridge_check_untagged_membership(mem_name, present) == STD_ERR_OK) && (*present)) {
         return STD_ERR_OK;
@@ -77,7 +77,7 @@ t_std_error NAS_BRIDGE::nas_bridge_check_membership(std::string mem_name, bool *
 }
 
 
-t_std_error NAS_BRIDGE::nas_bridge_add_vlan_in_attached_list(std::string mem_name)
+t_std_error NAS_BRIDGE::nas_bridge_add_vlan_in_attached_list(const std::string &mem_name)
 {
     try {
         attached_vlans.insert(mem_name);
@@ -88,7 +88,7 @@ t_std_error NAS_BRIDGE::nas_bridge_add_vlan_in_attached_list(std::string mem_nam
     return STD_ERR_OK;
 }
 
-t_std_error NAS_BRIDGE::nas_bridge_add_tagged_member_in_list(std::string mem_name)
+t_std_error NAS_BRIDGE::nas_bridge_add_tagged_member_in_list(const std::string &mem_name)
 {
     try {
         tagged_members.insert(mem_name);
@@ -99,7 +99,7 @@ t_std_error NAS_BRIDGE::nas_bridge_add_tagged_member_in_list(std::string mem_nam
     return STD_ERR_OK;
 }
 
-t_std_error NAS_BRIDGE::nas_bridge_add_untagged_member_in_list(std::string mem_name)
+t_std_error NAS_BRIDGE::nas_bridge_add_untagged_member_in_list(const std::string &mem_name)
 {
     try {
         untagged_members.insert(mem_name);
@@ -110,7 +110,7 @@ t_std_error NAS_BRIDGE::nas_bridge_add_untagged_member_in_list(std::string mem_n
     return STD_ERR_OK;
 }
 
-t_std_error NAS_BRIDGE::nas_bridge_remove_vlan_member_from_attached_list(std::string mem_name)
+t_std_error NAS_BRIDGE::nas_bridge_remove_vlan_member_from_attached_list(const std::string &mem_name)
 {
     auto it = attached_vlans.find(mem_name);
     if(it != attached_vlans.end()){
@@ -123,7 +123,7 @@ t_std_error NAS_BRIDGE::nas_bridge_remove_vlan_member_from_attached_list(std::st
     return STD_ERR(INTERFACE, FAIL, 0);
 }
 
-t_std_error NAS_BRIDGE::nas_bridge_remove_tagged_member_from_list(std::string mem_name)
+t_std_error NAS_BRIDGE::nas_bridge_remove_tagged_member_from_list(const std::string &mem_name)
 {
     auto it = tagged_members.find(mem_name);
     if(it != tagged_members.end()){
@@ -135,7 +135,7 @@ t_std_error NAS_BRIDGE::nas_bridge_remove_tagged_member_from_list(std::string me
     return STD_ERR(INTERFACE, FAIL, 0);
 }
 
-t_std_error NAS_BRIDGE::nas_bridge_remove_untagged_member_from_list(std::string mem_name)
+t_std_error NAS_BRIDGE::nas_bridge_remove_untagged_member_from_list(const std::string &mem_name)
 {
     auto it  = untagged_members.find(mem_name);
     if(it != untagged_members.end()){
@@ -147,26 +147,18 @@ t_std_error NAS_BRIDGE::nas_bridge_remove_untagged_member_from_list(std::string
     return STD_ERR(INTERFACE, FAIL, 0);
 }
 
-void NAS_BRIDGE::nas_bridge_for_each_member(std::function <void (std::string mem_name, nas_port_mode_t port_mode)> fn)
+void NAS_BRIDGE::nas_bridge_for_each_member(std::function <void (const std::string &mem_name, nas_port_mode_t port_mode)> fn)
 {
-    if (!tagged_members.empty()) {
-        for (auto it = tagged_members.begin(); it != tagged_members.end(); ++it) {
-            std::string _name = *it;
-            // TODO check type of function parameter
-            fn(_name, NAS_PORT_TAGGED);
-        }
+    for (auto it = tagged_members.begin(); it != tagged_members.end(); ++it) {
+        fn(*it, NAS_PORT_TAGGED);
     }
-    if (!untagged_members.empty()) {
-        for (auto it = untagged_members.begin(); it != untagged_members.end(); ++it) {
-            // TODO check type of function parameter
-            std::string _name = *it;
-            fn(_name, NAS_PORT_UNTAGGED);
-        }
+    for (auto it = untagged_members.begin(); it != untagged_members.end(); ++it) {
+        fn(*it, NAS_PORT_UNTAGGED);
     }
 }
 t_std_error NAS_BRIDGE::nas_bridge_get_member_list(nas_port_mode_t port_mode, memberlist_t &m_list)
 {
-    memberlist_t *_list = NULL;
+    member_id_list_t *_list = NULL;
     if (port_mode == NAS_PORT_TAGGED) {
         _list  = &tagged_members;
     } else {
@@ -233,7 +225,7 @@ bool NAS_BRIDGE::nas_bridge_multiple_vlans_present(void)
 }
 
 // Fill common bridge attributes in the CPS object
-cps_api_return_code_t NAS_BRIDGE::nas_bridge_fill_bridge_model_com_info(cps_api_object_t obj)
+cps_api_return_code_t NAS_BRIDGE::nas_bridge_fill_bridge_model_com_info(cps_api_object_t obj, bool with_members)
 {
     if(obj == nullptr) {
         return  cps_api_ret_code_ERR;
@@ -241,6 +233,9 @@ cps_api_return_code_t NAS_BRIDGE::nas_bridge_fill_bridge_model_com_info(cps_api_
     cps_api_set_key_data(obj,BRIDGE_DOMAIN_BRIDGE_NAME,
                            cps_api_object_ATTR_T_BIN, bridge_name.c_str(), strlen(bridge_name.c_str())+1);
     cps_api_object_attr_add_u32(obj,BRIDGE_DOMAIN_BRIDGE_MODE, bridge_mode);
+    if (!with_members) {
+        return cps_api_ret_code_OK;
+    }
     // Add tagged and untagged members name
     if (!tagged_members.empty()) {
         for (auto it = tagged_members.begin(); it != tagged_members.end(); ++it) {
@@ -258,7 +253,7 @@ cps_api_return_code_t NAS_BRIDGE::nas_bridge_fill_bridge_model_com_info(cps_api_
 
     return cps_api_ret_code_OK;
 }
-cps_api_return_code_t NAS_BRIDGE::nas_bridge_fill_vlan_intf_model_com_info(cps_api_object_t obj)
+cps_api_return_code_t NAS_BRIDGE::nas_bridge_fill_vlan_intf_model_com_info(cps_api_object_t obj, bool with_members)
 {
     if(obj == nullptr) {
         return  cps_api_ret_code_ERR;
@@ -270,7 +265,7 @@ cps_api_return_code_t NAS_BRIDGE::nas_bridge_fill_vlan_intf_model_com_info(cps_a
                             (const void *)IF_INTERFACE_TYPE_IANAIFT_IANA_INTERFACE_TYPE_IANAIFT_L2VLAN,
                             strlen(IF_INTERFACE_TYPE_IANAIFT_IANA_INTERFACE_TYPE_IANAIFT_L2VLAN)+1);
     // Add tagged and untagged members name
-    if (!tagged_members.empty()) {
+    if (with_members && !tagged_members.empty()) {
         for (auto it = tagged_members.begin(); it != tagged_members.end(); ++it) {
             std::string parent_intf;
             if (nas_interface_utils_parent_name_get((std::string &)*it, parent_intf) != STD_ERR_OK) {
@@ -281,7 +276,7 @@ cps_api_return_code_t NAS_BRIDGE::nas_bridge_fill_vlan_intf_model_com_info(cps_a
                     strlen(parent_intf.c_str())+1);
         }
     }
-    if (!untagged_members.empty()) {
+    if (with_members && !untagged_members.empty()) {
         for (auto it = untagged_members.begin(); it != untagged_members.end(); ++it) {
             cps_api_object_attr_add(obj, DELL_IF_IF_INTERFACES_INTERFACE_UNTAGGED_PORTS, it->c_str(),
                     strlen(it->c_str())+1);
@@ -291,13 +286,13 @@ cps_api_return_code_t NAS_BRIDGE::nas_bridge_fill_vlan_intf_model_com_info(cps_a
     cps_api_object_attr_add_u32(obj, DELL_BASE_IF_CMN_IF_INTERFACES_INTERFACE_IF_INDEX, get_bridge_intf_index());
     return cps_api_ret_code_OK;
 }
-cps_api_return_code_t NAS_BRIDGE::nas_bridge_fill_com_info(cps_api_object_t obj)
+cps_api_return_code_t NAS_BRIDGE::nas_bridge_fill_com_info(cps_api_object_t obj, bool with_members)
 {
 
     if (get_bridge_model() == BRIDGE_MODEL) {
-        return nas_bridge_fill_bridge_model_com_info(obj);
+        return nas_bridge_fill_bridge_model_com_info(obj, with_members);
     } else {
-        return nas_bridge_fill_vlan_intf_model_com_info(obj);
+        return nas_bridge_fill_vlan_intf_model_com_info(obj, with_members);
     }
     return  cps_api_ret_code_OK;
 }
@@ -340,7 +335,7 @@ void NAS_BRIDGE::nas_bridge_publish_member_event(std::string &mem_name, cps_api_
     cps_api_event_thread_publish(og.get());
 }
 
-void NAS_BRIDGE::nas_bridge_publish_memberlist_event(memberlist_t &memlist, cps_api_operation_types_t op)
+void NAS_BRIDGE::nas_bridge_publish_memberlist_event(const memberlist_t &memlist, cps_api_operation_types_t op)
 {
     if (memlist.empty()) { return;}
     cps_api_object_guard og(cps_api_object_create());
@@ -353,7 +348,7 @@ void NAS_BRIDGE::nas_bridge_publish_memberlist_event(memberlist_t &memlist, cps_
     cps_api_object_set_type_operation(cps_api_object_key(og.get()), op);
     cps_api_set_key_data(og.get(),BRIDGE_DOMAIN_BRIDGE_NAME,
             cps_api_object_ATTR_T_BIN, bridge_name.c_str(), strlen(bridge_name.c_str())+1);
-    for (auto mem : memlist) {
+    for (auto &mem : memlist) {
         EV_LOGGING(INTERFACE,DEBUG,"NAS-BRIDGE"," Publish %s member %s to the bridge %s event",
                         (op  == cps_api_oper_CREATE? "ADD" : "DELETE"), mem.c_str(), bridge_name.c_str());
         cps_api_object_attr_add(og.get(), BRIDGE_DOMAIN_BRIDGE_MEMBER_INTERFACE,
@@ -364,26 +359,14 @@ void NAS_BRIDGE::nas_bridge_publish_memberlist_event(memberlist_t &memlist, cps_
     cps_api_event_thread_publish(og.get());
 }
 
-t_std_error NAS_BRIDGE::nas_bridge_os_add_remove_member(std::string & mem_name, nas_port_mode_t port_mode, bool add)
+/*  Fill the kernel bridge membership request of one member */
+t_std_error NAS_BRIDGE::nas_bridge_os_member_obj_fill(cps_api_object_t obj, const std::string &mem_name,
+                                                      nas_port_mode_t port_mode)
 {
     t_std_error rc = STD_ERR_OK;
-    if ((nas_g_scaled_vlan_get() == true) && (bridge_l3_mode_get() != BASE_IF_MODE_MODE_L3)) {
-        // Nothing to do in case of non L3 mode
-        return rc;
-    }
-
-    /*  check if the interface exist  */
-    // if not then first create
-
-    cps_api_object_guard _og(cps_api_object_create());
-    if(!_og.valid()){
-        EV_LOGGING(INTERFACE,ERR,"INT-DB-GET","Failed to create object  member addition");
-        return STD_ERR(INTERFACE, FAIL, 0);
-    }
-
-    cps_api_object_attr_add(_og.get(),IF_INTERFACES_INTERFACE_NAME,
-                                get_bridge_name().c_str(),
-                               strlen(get_bridge_name().c_str())+1);
+    cps_api_object_attr_add(obj,IF_INTERFACES_INTERFACE_NAME,
+                                bridge_name.c_str(),
+                               strlen(bridge_name.c_str())+1);
     cps_api_attr_id_t port_mode_id = DELL_IF_IF_INTERFACES_INTERFACE_UNTAGGED_PORTS;
     hal_vlan_id_t vlan_id =0;
     if(port_mode == NAS_PORT_TAGGED) {
@@ -392,42 +375,121 @@ t_std_error NAS_BRIDGE::nas_bridge_os_add_remove_member(std::string & mem_name,
         port_mode_id = DELL_IF_IF_INTERFACES_INTERFACE_TAGGED_PORTS;
         std::string parent;
         hal_ifindex_t ifindex;
-        rc = nas_interface_utils_parent_name_get(mem_name, parent);
-        rc = nas_interface_utils_vlan_id_get(mem_name, vlan_id);
-        rc = nas_interface_utils_ifindex_get(mem_name,ifindex);
+        std::string _mem_name(mem_name);
+        rc = nas_interface_utils_parent_name_get(_mem_name, parent);
+        rc = nas_interface_utils_vlan_id_get(_mem_name, vlan_id);
+        rc = nas_interface_utils_ifindex_get(_mem_name,ifindex);
         if (rc != STD_ERR_OK) {
             EV_LOGGING(INTERFACE,ERR,"INT-DB-GET","Member %s does not exist member", mem_name.c_str());
             return rc;
         }
-        cps_api_object_attr_add(_og.get(),DELL_IF_IF_INTERFACES_INTERFACE_PARENT_INTERFACE, parent.c_str(), strlen(parent.c_str())+1);
-        cps_api_object_attr_add_u32(_og.get(),DELL_BASE_IF_CMN_IF_INTERFACES_INTERFACE_IF_INDEX,ifindex);
+        cps_api_object_attr_add(obj,DELL_IF_IF_INTERFACES_INTERFACE_PARENT_INTERFACE, parent.c_str(), strlen(parent.c_str())+1);
+        cps_api_object_attr_add_u32(obj,DELL_BASE_IF_CMN_IF_INTERFACES_INTERFACE_IF_INDEX,ifindex);
     }
     // TODO Though vlan id not needed for adding member
-    cps_api_object_attr_add_u32(_og.get(),BASE_IF_VLAN_IF_INTERFACES_INTERFACE_ID, vlan_id);
+    cps_api_object_attr_add_u32(obj,BASE_IF_VLAN_IF_INTERFACES_INTERFACE_ID, vlan_id);
 
     // Add member Name
-    cps_api_object_attr_add(_og.get(), port_mode_id, mem_name.c_str(), strlen(mem_name.c_str())+1);
+    cps_api_object_attr_add(obj, port_mode_id, mem_name.c_str(), strlen(mem_name.c_str())+1);
+    return STD_ERR_OK;
+}
+
+static t_std_error _nas_bridge_os_apply(cps_api_object_t obj, bool add, const char *mem_name, const char *br_name)
+{
+    t_std_error rc = STD_ERR_OK;
     if (add) {
-        if ((rc = nas_os_add_intf_to_bridge(_og.get())) != STD_ERR_OK) {
+        if ((rc = nas_os_add_intf_to_bridge(obj)) != STD_ERR_OK) {
             EV_LOGGING(INTERFACE,ERR,"INT-DB-GET","Failed to add member %s to the bridge %s in the kernel",
-                                    mem_name.c_str(), get_bridge_name().c_str() );
+                                    mem_name, br_name);
         }
     } else  {
-        if ((rc = nas_os_del_intf_from_bridge(_og.get())) != STD_ERR_OK) {
+        if ((rc = nas_os_del_intf_from_bridge(obj)) != STD_ERR_OK) {
             EV_LOGGING(INTERFACE,ERR,"INT-DB-GET","Failed to delete member %s from the bridge %s  in the kernel",
-                                    mem_name.c_str(), get_bridge_name().c_str() );
+                                    mem_name, br_name);
         }
     }
     return rc;
 }
-t_std_error NAS_BRIDGE::nas_bridge_os_add_remove_memberlist(memberlist_t & memlist, nas_port_mode_t port_mode, bool add)
+
+t_std_error NAS_BRIDGE::nas_bridge_os_add_remove_member(std::string & mem_name, nas_port_mode_t port_mode, bool add)
+{
+    t_std_error rc = STD_ERR_OK;
+    if ((nas_g_scaled_vlan_get() == true) && (bridge_l3_mode_get() != BASE_IF_MODE_MODE_L3)) {
+        // Nothing to do in case of non L3 mode
+        return rc;
+    }
+
+    /*  check if the interface exist  */
+    // if not then first create
+
+    cps_api_object_guard _og(cps_api_object_create());
+    if(!_og.valid()){
+        EV_LOGGING(INTERFACE,ERR,"INT-DB-GET","Failed to create object  member addition");
+        return STD_ERR(INTERFACE, FAIL, 0);
+    }
+    if ((rc = nas_bridge_os_member_obj_fill(_og.get(), mem_name, port_mode)) != STD_ERR_OK) {
+        return rc;
+    }
+    return _nas_bridge_os_apply(_og.get(), add, mem_name.c_str(), bridge_name.c_str());
+}
+
+/*
+ * All kernel requests of the list are built before the kernel is touched. Additions are
+ * all or nothing: if a member fails, the members already added are removed again and
+ * the error is returned, since callers revert their NPU changes on failure. Removals
+ * stay best effort as before: a failed member is logged and the rest are still removed,
+ * so a partial teardown is never undone by re-adding members.
+ */
+t_std_error NAS_BRIDGE::nas_bridge_os_add_remove_memberlist(const memberlist_t & memlist, nas_port_mode_t port_mode, bool add)
 {
+    if (memlist.empty()) {
+        return STD_ERR_OK;
+    }
+    if ((nas_g_scaled_vlan_get() == true) && (bridge_l3_mode_get() != BASE_IF_MODE_MODE_L3)) {
+        // Nothing to do in case of non L3 mode
+        return STD_ERR_OK;
+    }
 
-    for (auto mem : memlist ) {
-       nas_bridge_os_add_remove_member(mem, port_mode, add);
-       // TODO May need to add check error for rollback
+    t_std_error rc = STD_ERR_OK;
+    cps_api_object_list_guard lg(cps_api_object_list_create());
+    std::vector<const std::string *> names;
+    names.reserve(memlist.size());
+    for (auto &mem : memlist) {
+        cps_api_object_t obj = cps_api_object_list_create_obj_and_append(lg.get());
+        if (obj == nullptr) {
+            EV_LOGGING(INTERFACE,ERR,"INT-DB-GET","Failed to create object  member addition");
+            return STD_ERR(INTERFACE, FAIL, 0);
+        }
+        if ((rc = nas_bridge_os_member_obj_fill(obj, mem, port_mode)) != STD_ERR_OK) {
+            return rc;
+        }
+        names.push_back(&mem);
     }
-    return STD_ERR_OK;
+
+    if (!add) {
+        for (size_t ix = 0; ix < names.size(); ++ix) {
+            _nas_bridge_os_apply(cps_api_object_list_get(lg.get(), ix), false,
+                                 names[ix]->c_str(), bridge_name.c_str());
+        }
+        return STD_ERR_OK;
+    }
+
+    size_t ix = 0;
+    for (; ix < names.size(); ++ix) {
+        if ((rc = _nas_bridge_os_apply(cps_api_object_list_get(lg.get(), ix), true,
+                                       names[ix]->c_str(), bridge_name.c_str())) != STD_ERR_OK) {
+            break;
+        }
+    }
+    if (rc != STD_ERR_OK) {
+        while (ix-- > 0) {
+            if (_nas_bridge_os_apply(cps_api_object_list_get(lg.get(), ix), false,
+                                     names[ix]->c_str(), bridge_name.c_str()) != STD_ERR_OK) {
+                EV_LOGGING(INTERFACE,ERR,"INT-DB-GET","Failed to rollback member %s update", names[ix]->c_str());
+            }
+        }
+    }
+    return rc;
 }
 
 
@@ -484,7 +546,7 @@ t_std_error NAS_BRIDGE::nas_bridge_set_mtu(cps_api_object_t obj, cps_api_object_
     t_std_error rc;
     cps_api_object_attr_add_u32(obj, DELL_BASE_IF_CMN_IF_INTERFACES_INTERFACE_IF_INDEX, if_index);
 
-    for(auto member : tagged_members){
+    for(auto &member : tagged_members){
         NAS_VLAN_INTERFACE * intf = dynamic_cast<NAS_VLAN_INTERFACE *>(nas_interface_map_obj_get(member));
         if(intf){
             if((rc = intf->set_mtu(mtu))!=STD_ERR_OK){
@@ -22,6 +22,7 @@
 #include "cps_api_object.h"
 #include "ds_common_types.h"
 #include "cps_api_object_key.h"
+#include "cps_api_object_tools.h"
 #include "cps_api_events.h"
 #include "cps_class_map.h"
 #include "bridge/nas_interface_bridge_cps.h"
@@ -252,13 +253,20 @@ static cps_api_return_code_t bridge_get (void * context, cps_api_get_params_t *
     cps_api_object_t filt = cps_api_object_list_get(param->filters,key_ix);
     cps_api_object_attr_t _name = cps_api_get_key_data(filt,BRIDGE_DOMAIN_BRIDGE_NAME);
 
-    std_mutex_simple_lock_guard _lg(nas_bridge_mtx_lock());
+    if ((_name == nullptr) || cps_api_filter_is_getnext(filt)) {
+        /*  Get all, or the next page after the named bridge. Bridge lock is taken per page */
+        std::string cursor;
+        if (_name != nullptr) {
+            cursor = (const char*)cps_api_object_attr_data_bin(_name);
+        }
+        size_t count = 0;
+        cps_api_filter_get_count(filt, &count);
+        return nas_fill_bridge_info_page(param->list, BRIDGE_MODEL, cursor, count,
+                                         nas_bridge_get_filter_with_members(filt, BRIDGE_MODEL));
+    }
 
-    if (_name == nullptr) {
-        /*  Get all */
-        nas_fill_all_bridge_info(&param->list, BRIDGE_MODEL);
-        return cps_api_ret_code_OK;
-    } else {
+    std_mutex_simple_lock_guard _lg(nas_bridge_mtx_lock());
+    {
         const char *br_name = (const char*)cps_api_object_attr_data_bin(_name);
         cps_api_object_t obj = cps_api_object_create();
         cps_api_key_from_attr_with_qual(cps_api_object_key(obj),
@@ -271,7 +279,8 @@ static cps_api_return_code_t bridge_get (void * context, cps_api_get_params_t *
             if (cps_api_object_list_append(param->list,obj)) {
                 rc = cps_api_ret_code_OK;
             }
-        } else if (nas_bridge_fill_info(br_name, obj) == cps_api_ret_code_OK) {
+        } else if (nas_bridge_fill_info(br_name, obj, nas_bridge_get_filter_with_members(filt, BRIDGE_MODEL)) ==
+                   cps_api_ret_code_OK) {
             if (cps_api_object_list_append(param->list,obj)) {
                 rc = cps_api_ret_code_OK;
             }
@@ -297,10 +306,10 @@ cps_api_return_code_t nas_bridge_cps_publish_1q_object(NAS_DOT1Q_BRIDGE *p_bridg
     cps_api_object_attr_add_u32(obj_pub, BASE_IF_VLAN_IF_INTERFACES_INTERFACE_ID, p_bridge_node->bridge_vlan_id);
     cps_api_object_attr_add_u32(obj_pub, DELL_IF_IF_INTERFACES_INTERFACE_VLAN_TYPE, p_bridge_node->bridge_sub_type);
 
-    for (memberlist_t::iterator it = p_bridge_node->tagged_members.begin() ; it != p_bridge_node->tagged_members.end(); ++it) {
+    for (auto it = p_bridge_node->tagged_members.begin() ; it != p_bridge_node->tagged_members.end(); ++it) {
         //cps_api_object_attr_add(obj_pub, DELL_IF_IF_INTERFACES_INTERFACE_TAGGED_PORTS, (const void *)(*it->c_str()), strlen(*it->c_str())+1);
     }
-    for (memberlist_t::iterator it = p_bridge_node->untagged_members.begin() ; it != p_bridge_node->untagged_members.end(); ++it) {
+    for (auto it = p_bridge_node->untagged_members.begin() ; it != p_bridge_node->untagged_members.end(); ++it) {
         //cps_api_object_attr_add(obj_pub, DELL_IF_IF_INTERFACES_INTERFACE_UNTAGGED_PORTS, (const void *)(*it->c_str()), strlen(*it->c_str())+1);
     }
     cps_api_object_set_type_operation(cps_api_object_key(obj_pub), op);
@@ -327,10 +336,10 @@ cps_api_return_code_t nas_bridge_cps_publish_1d_object(NAS_DOT1D_BRIDGE *p_bridg
             strlen(p_bridge_node->bridge_name.c_str())+1);
     cps_api_object_attr_add_u32(obj_pub,DELL_BASE_IF_CMN_IF_INTERFACES_INTERFACE_IF_INDEX, p_bridge_node->if_index);
 
-    for (memberlist_t::iterator it = p_bridge_node->tagged_members.begin() ; it != p_bridge_node->tagged_members.end(); ++it) {
+    for (auto it = p_bridge_node->tagged_members.begin() ; it != p_bridge_node->tagged_members.end(); ++it) {
         //cps_api_object_attr_add(obj_pub, DELL_IF_IF_INTERFACES_INTERFACE_TAGGED_PORTS, (const void *)(*it->c_str()), strlen(*it->c_str())+1);
     }
-    for (memberlist_t::iterator it = p_bridge_node->untagged_members.begin() ; it != p_bridge_node->untagged_members.end(); ++it) {
+    for (auto it = p_bridge_node->untagged_members.begin() ; it != p_bridge_node->untagged_members.end(); ++it) {
         //cps_api_object_attr_add(obj_pub, DELL_IF_IF_INTERFACES_INTERFACE_UNTAGGED_PORTS, (const void *)(*it->c_str()), strlen(*it->c_str())+1);
     }
     cps_api_object_set_type_operation(cps_api_object_key(obj_pub), op);
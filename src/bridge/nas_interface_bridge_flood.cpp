@@ -0,0 +1,275 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+
+/*
+ * filename: nas_interface_bridge_flood.cpp
+ */
+
+#include "bridge/nas_interface_bridge_flood.h"
+#include "nas_ndi_l2mc.h"
+#include "event_log.h"
+#include "event_log_types.h"
+
+#include <string.h>
+
+t_std_error NAS_BRIDGE_FLOOD_GROUPS::create(npu_id_t npu, nas_bridge_id_t br_id)
+{
+    t_std_error rc = STD_ERR_OK;
+
+    npu_id = npu;
+    bridge_id = br_id;
+
+    if ((rc = ndi_l2mc_group_create(npu_id, &uc_group_id)) != STD_ERR_OK) {
+        EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE-FLOOD", "Failed to create unicast L2MC group");
+        return rc;
+    }
+    if ((rc = ndi_l2mc_group_create(npu_id, &mc_group_id)) != STD_ERR_OK) {
+        EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE-FLOOD", "Failed to create multicast L2MC group");
+        return rc;
+    }
+
+    /*  No members yet so unknown unicast starts out on the shared multicast group */
+    uc_shared = true;
+    if ((rc = ndi_flood_control_1d_bridge(npu_id, bridge_id, mc_group_id,
+                                NDI_BRIDGE_PKT_UNICAST, true)) != STD_ERR_OK) {
+        EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE-FLOOD", " Failed to set L2MC group %llu and "
+                "unicast flooding on bridge %llu", mc_group_id, bridge_id);
+        return rc;
+    }
+    if ((rc = ndi_flood_control_1d_bridge(npu_id, bridge_id, mc_group_id,
+                                NDI_BRIDGE_PKT_MULTICAST, true)) != STD_ERR_OK) {
+        EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE-FLOOD", " Failed to set L2MC group %llu and "
+                "multicast flooding on bridge %llu", mc_group_id, bridge_id);
+        return rc;
+    }
+    if ((rc = ndi_flood_control_1d_bridge(npu_id, bridge_id, mc_group_id,
+                                NDI_BRIDGE_PKT_BROADCAST, true)) != STD_ERR_OK) {
+        EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE-FLOOD", " Failed to set L2MC group %llu and "
+                "broadcast flooding on bridge %llu", mc_group_id, bridge_id);
+        return rc;
+    }
+    return rc;
+}
+
+t_std_error NAS_BRIDGE_FLOOD_GROUPS::destroy(void)
+{
+    t_std_error rc = STD_ERR_OK;
+    ndi_obj_id_t uc_flood_group = uc_shared ? mc_group_id : uc_group_id;
+
+    if ((rc = ndi_flood_control_1d_bridge(npu_id, bridge_id, uc_flood_group,
+                                    NDI_BRIDGE_PKT_UNICAST, false)) != STD_ERR_OK) {
+        EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE-FLOOD", " Failed to remove L2MC group %llu and "
+                    "unicast flooding on bridge %llu", uc_flood_group, bridge_id);
+        return rc;
+    }
+    if ((rc = ndi_flood_control_1d_bridge(npu_id, bridge_id, mc_group_id,
+                                NDI_BRIDGE_PKT_MULTICAST, false)) != STD_ERR_OK) {
+        EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE-FLOOD", " Failed to remove L2MC group %llu and "
+                    "multicast flooding on bridge %llu", mc_group_id, bridge_id);
+        return rc;
+    }
+    if ((rc = ndi_flood_control_1d_bridge(npu_id, bridge_id, mc_group_id,
+                                NDI_BRIDGE_PKT_BROADCAST, false)) != STD_ERR_OK) {
+        EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE-FLOOD", " Failed to remove L2MC group %llu and "
+                "broadcast flooding on bridge %llu", mc_group_id, bridge_id);
+        return rc;
+    }
+    if ((rc = ndi_l2mc_group_delete(npu_id, uc_group_id)) != STD_ERR_OK) {
+        EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE-FLOOD", " Failed to delete unicast L2MC group %llu",
+                   uc_group_id);
+        return rc;
+    }
+    if ((rc = ndi_l2mc_group_delete(npu_id, mc_group_id)) != STD_ERR_OK) {
+        EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE-FLOOD", " Failed to delete multicast L2MC group %llu",
+                   mc_group_id);
+        return rc;
+    }
+    uc_group_id = INVALID_L2MC_GROUP_ID;
+    mc_group_id = INVALID_L2MC_GROUP_ID;
+    members.clear();
+    dirty.clear();
+    diverged_cnt = 0;
+    return rc;
+}
+
+void NAS_BRIDGE_FLOOD_GROUPS::set_desired(mem_info_t &info, uint8_t groups)
+{
+    if (diverged(info.desired)) --diverged_cnt;
+    info.desired = groups;
+    if (diverged(info.desired)) ++diverged_cnt;
+}
+
+void NAS_BRIDGE_FLOOD_GROUPS::stage(nas_flood_mem_type_t type, npu_id_t npu, ndi_obj_id_t id,
+                                    hal_vlan_id_t vlan_id, const hal_ip_addr_t *remote_ip, uint8_t groups)
+{
+    mem_key_t key = { type, id, vlan_id };
+    auto it = members.find(key);
+    if (it == members.end()) {
+        if (groups == 0) {
+            return;
+        }
+        mem_info_t info;
+        memset(&info, 0, sizeof(info));
+        info.npu_id = npu;
+        it = members.insert(std::make_pair(key, info)).first;
+    }
+    if (remote_ip != nullptr) {
+        it->second.remote_ip = *remote_ip;
+    }
+    set_desired(it->second, groups);
+    dirty.insert(key);
+}
+
+t_std_error NAS_BRIDGE_FLOOD_GROUPS::program(const mem_key_t &key, mem_info_t &info, uint8_t grp, bool add)
+{
+    t_std_error rc = STD_ERR_OK;
+    ndi_obj_id_t group_id = (grp == NAS_FLOOD_GRP_UC) ? uc_group_id : mc_group_id;
+
+    switch (key.type) {
+    case NAS_FLOOD_MEM_PORT:
+        rc = ndi_l2mc_handle_subport_add(info.npu_id, group_id, (npu_port_t)key.id, key.vlan_id, add);
+        break;
+    case NAS_FLOOD_MEM_LAG:
+        rc = ndi_l2mc_handle_lagport_add(info.npu_id, group_id, key.id, key.vlan_id, add);
+        break;
+    case NAS_FLOOD_MEM_TUNNEL:
+        rc = ndi_l2mc_handle_tunnel_member(info.npu_id, group_id, key.id,
+                                           add ? &info.remote_ip : NULL, add);
+        break;
+    }
+    if (rc != STD_ERR_OK) {
+        EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE-FLOOD", "Failed to %s member type %d id %llu vlan %d %s L2MC group %llu",
+                   add ? "add" : "remove", key.type, key.id, key.vlan_id, add ? "to" : "from", group_id);
+        return rc;
+    }
+    if (add) {
+        info.programmed |= grp;
+    } else {
+        info.programmed &= ~grp;
+    }
+    return STD_ERR_OK;
+}
+
+/*
+ * Bring one member in line with its desired groups. While unknown unicast is shared with the
+ * multicast group, unicast additions are deferred but removals are still applied so the
+ * unicast group never refers to a port or tunnel that is about to be deleted.
+ */
+t_std_error NAS_BRIDGE_FLOOD_GROUPS::sync_member(const mem_key_t &key, mem_info_t &info)
+{
+    t_std_error rc = STD_ERR_OK;
+    bool want_mc = (info.desired & NAS_FLOOD_GRP_MC) != 0;
+    bool have_mc = (info.programmed & NAS_FLOOD_GRP_MC) != 0;
+    bool want_uc = (info.desired & NAS_FLOOD_GRP_UC) != 0;
+    bool have_uc = (info.programmed & NAS_FLOOD_GRP_UC) != 0;
+
+    if ((want_uc != have_uc) && (!uc_shared || have_uc)) {
+        if ((rc = program(key, info, NAS_FLOOD_GRP_UC, want_uc)) != STD_ERR_OK) {
+            return rc;
+        }
+    }
+    if (want_mc != have_mc) {
+        if ((rc = program(key, info, NAS_FLOOD_GRP_MC, want_mc)) != STD_ERR_OK) {
+            return rc;
+        }
+    }
+    return STD_ERR_OK;
+}
+
+t_std_error NAS_BRIDGE_FLOOD_GROUPS::set_uc_flood_group(ndi_obj_id_t group_id)
+{
+    t_std_error rc = ndi_flood_control_1d_bridge(npu_id, bridge_id, group_id, NDI_BRIDGE_PKT_UNICAST, true);
+    if (rc != STD_ERR_OK) {
+        EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE-FLOOD", " Failed to move unicast flooding of bridge %llu to "
+                   "L2MC group %llu", bridge_id, group_id);
+    }
+    return rc;
+}
+
+void NAS_BRIDGE_FLOOD_GROUPS::rollback_pending(void)
+{
+    for (auto &key : dirty) {
+        auto it = members.find(key);
+        if (it == members.end()) continue;
+        set_desired(it->second, it->second.committed);
+        if (sync_member(key, it->second) != STD_ERR_OK) {
+            EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE-FLOOD", "Failed to roll back flood groups of member id %llu",
+                       key.id);
+        }
+    }
+    dirty.clear();
+}
+
+t_std_error NAS_BRIDGE_FLOOD_GROUPS::flush(void)
+{
+    t_std_error rc = STD_ERR_OK;
+
+    if (!valid()) {
+        EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE-FLOOD", "Flood groups not created for bridge %llu", bridge_id);
+        rollback_pending();
+        return STD_ERR(INTERFACE, FAIL, 0);
+    }
+    if (dirty.empty()) {
+        return STD_ERR_OK;
+    }
+
+    if (uc_shared && (diverged_cnt > 0)) {
+        /*  Unicast and multicast sets differ now, program the deferred unicast members
+         *  and move unknown unicast back to its own group */
+        uc_shared = false;
+        for (auto &mem : members) {
+            bool want_uc = (mem.second.desired & NAS_FLOOD_GRP_UC) != 0;
+            bool have_uc = (mem.second.programmed & NAS_FLOOD_GRP_UC) != 0;
+            if (want_uc && !have_uc &&
+                ((rc = program(mem.first, mem.second, NAS_FLOOD_GRP_UC, true)) != STD_ERR_OK)) {
+                break;
+            }
+        }
+        if ((rc != STD_ERR_OK) || ((rc = set_uc_flood_group(uc_group_id)) != STD_ERR_OK)) {
+            uc_shared = true;
+            rollback_pending();
+            return rc;
+        }
+    }
+
+    for (auto &key : dirty) {
+        auto it = members.find(key);
+        if (it == members.end()) continue;
+        if ((rc = sync_member(key, it->second)) != STD_ERR_OK) {
+            rollback_pending();
+            return rc;
+        }
+    }
+
+    for (auto &key : dirty) {
+        auto it = members.find(key);
+        if (it == members.end()) continue;
+        it->second.committed = it->second.desired;
+        if ((it->second.desired == 0) && (it->second.programmed == 0)) {
+            members.erase(it);
+        }
+    }
+    dirty.clear();
+
+    if (!uc_shared && (diverged_cnt == 0)) {
+        /*  Sets are identical again, let unknown unicast flood on the multicast group */
+        if (set_uc_flood_group(mc_group_id) == STD_ERR_OK) {
+            uc_shared = true;
+        }
+    }
+    return STD_ERR_OK;
+}
@@ -22,120 +22,349 @@
 #include "bridge/nas_interface_bridge_map.h"
 #include "event_log.h"
 #include "event_log_types.h"
+#include "bridge/nas_interface_bridge_com.h"
+#include "cps_api_object_tools.h"
+#include "dell-interface.h"
+#include "bridge-model.h"
 static bridge_map_t &bridge_map = *new bridge_map_t();
+/* Recursive so for_each callbacks may look up other bridges */
+static std_mutex_lock_create_static_init_rec(bridge_map_lock);
 
-t_std_error bridge_map_t::insert(std::string name, NAS_BRIDGE *obj)
+bridge_map_entry_t *bridge_map_t::entry_get(const char *name)
 {
-    bridge_map_s::iterator it = bmap.find(name);
-    if (it != bmap.end()) {
-        EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE", "bridge %s already exists", name.c_str());
+    bridge_name_key_t key = { name };
+    auto it = by_name.find(key);
+    if (it == by_name.end()) {
+        return nullptr;
+    }
+    return it->second;
+}
+
+bridge_map_entry_t *bridge_map_t::entry_create(const char *name)
+{
+    bridge_map_entry_t *entry = new bridge_map_entry_t;
+    entry->name = name;
+    entry->obj = nullptr;
+    entry->if_index = 0;
+    entry->vlan_id = NAS_VLAN_ID_INVALID;
+    bridge_name_key_t key = { entry->name.c_str() };
+    by_name[key] = entry;
+    name_order[key] = entry;
+    return entry;
+}
+
+/* Free the entry once neither a bridge object nor a VLAN binding refers to it */
+void bridge_map_t::entry_release(bridge_map_entry_t *entry)
+{
+    if ((entry->obj != nullptr) || (entry->vlan_id != NAS_VLAN_ID_INVALID)) {
+        return;
+    }
+    bridge_name_key_t key = { entry->name.c_str() };
+    by_name.erase(key);
+    name_order.erase(key);
+    delete entry;
+}
+
+t_std_error bridge_map_t::insert(const char *name, NAS_BRIDGE *obj)
+{
+    std_mutex_simple_lock_guard lg(&bridge_map_lock);
+    bridge_map_entry_t *entry = entry_get(name);
+    if ((entry != nullptr) && (entry->obj != nullptr)) {
+        EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE", "bridge %s already exists", name);
         return STD_ERR(INTERFACE, FAIL, 0);
     }
-    ret_t ret = bmap.insert(pair_t(name, obj));
-    if (ret.second == false) {
-        EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE", "bridge %s insert failed", name.c_str());
+    hal_ifindex_t if_index = obj->get_bridge_intf_index();
+    if ((if_index != 0) && (by_ifindex.find(if_index) != by_ifindex.end())) {
+        EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE", "bridge %s insert failed, ifindex %d already in use",
+                name, if_index);
         return STD_ERR(INTERFACE, FAIL, 0);
     }
+    if (entry == nullptr) {
+        entry = entry_create(name);
+    }
+    entry->obj = obj;
+    entry->if_index = if_index;
+    if (if_index != 0) {
+        by_ifindex[if_index] = entry;
+    }
     return STD_ERR_OK;
 }
 
-t_std_error bridge_map_t::remove(std::string name)
+t_std_error bridge_map_t::remove(const char *name)
 {
-    bridge_map_s::iterator it = bmap.find(name);
-    if (it == bmap.end()) {
+    std_mutex_simple_lock_guard lg(&bridge_map_lock);
+    bridge_map_entry_t *entry = entry_get(name);
+    if ((entry == nullptr) || (entry->obj == nullptr)) {
         return STD_ERR(INTERFACE, FAIL, 0);
     }
-    bmap.erase(it);
+    if (entry->if_index != 0) {
+        by_ifindex.erase(entry->if_index);
+    }
+    entry->obj = nullptr;
+    entry->if_index = 0;
+    /* VLAN binding belongs to the name and outlives the object, e.g. across a mode change */
+    entry_release(entry);
     return STD_ERR_OK;
 }
 
-t_std_error bridge_map_t::get(std::string name, NAS_BRIDGE **obj)
+t_std_error bridge_map_t::get(const char *name, NAS_BRIDGE **obj)
 {
-    bridge_map_s::iterator it = bmap.find(name);
-    if (it == bmap.end()) {
+    std_mutex_simple_lock_guard lg(&bridge_map_lock);
+    bridge_map_entry_t *entry = entry_get(name);
+    if ((entry == nullptr) || (entry->obj == nullptr)) {
         return STD_ERR(INTERFACE, FAIL, 0);
     }
-    *obj = it->second;
+    *obj = entry->obj;
     return STD_ERR_OK;
 }
 
-t_std_error bridge_map_t::find(std::string name, bool *present)
+t_std_error bridge_map_t::get_by_ifindex(hal_ifindex_t if_index, NAS_BRIDGE **obj)
 {
-    bridge_map_s::iterator it = bmap.find(name);
-    if (it == bmap.end()) {
-        *present = false;
-        return STD_ERR_OK;
+    std_mutex_simple_lock_guard lg(&bridge_map_lock);
+    auto it = by_ifindex.find(if_index);
+    if (it == by_ifindex.end()) {
+        return STD_ERR(INTERFACE, FAIL, 0);
     }
-    *present = true;
+    *obj = it->second->obj;
     return STD_ERR_OK;
 }
 
+t_std_error bridge_map_t::get_by_vlan(hal_vlan_id_t vlan_id, NAS_BRIDGE **obj)
+{
+    std_mutex_simple_lock_guard lg(&bridge_map_lock);
+    auto it = by_vlan.find(vlan_id);
+    if ((it == by_vlan.end()) || (it->second->obj == nullptr)) {
+        return STD_ERR(INTERFACE, FAIL, 0);
+    }
+    *obj = it->second->obj;
+    return STD_ERR_OK;
+}
+
+t_std_error bridge_map_t::find(const char *name, bool *present)
+{
+    std_mutex_simple_lock_guard lg(&bridge_map_lock);
+    bridge_map_entry_t *entry = entry_get(name);
+    *present = ((entry != nullptr) && (entry->obj != nullptr));
+    return STD_ERR_OK;
+}
+
+t_std_error bridge_map_t::vlan_bind(hal_vlan_id_t vlan_id, const char *name)
+{
+    std_mutex_simple_lock_guard lg(&bridge_map_lock);
+    if (by_vlan.find(vlan_id) != by_vlan.end()) {
+        return STD_ERR(INTERFACE, FAIL, 0);
+    }
+    bridge_map_entry_t *entry = entry_get(name);
+    if ((entry != nullptr) && (entry->vlan_id != NAS_VLAN_ID_INVALID)) {
+        EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE", "bridge %s already bound to vlan %d",
+                name, entry->vlan_id);
+        return STD_ERR(INTERFACE, FAIL, 0);
+    }
+    if (entry == nullptr) {
+        entry = entry_create(name);
+    }
+    entry->vlan_id = vlan_id;
+    by_vlan[vlan_id] = entry;
+    return STD_ERR_OK;
+}
+
+t_std_error bridge_map_t::vlan_unbind(hal_vlan_id_t vlan_id)
+{
+    std_mutex_simple_lock_guard lg(&bridge_map_lock);
+    auto it = by_vlan.find(vlan_id);
+    if (it == by_vlan.end()) {
+        return STD_ERR(INTERFACE, FAIL, 0);
+    }
+    bridge_map_entry_t *entry = it->second;
+    by_vlan.erase(it);
+    entry->vlan_id = NAS_VLAN_ID_INVALID;
+    entry_release(entry);
+    return STD_ERR_OK;
+}
+
+t_std_error bridge_map_t::vlan_name_get(hal_vlan_id_t vlan_id, std::string &name)
+{
+    std_mutex_simple_lock_guard lg(&bridge_map_lock);
+    auto it = by_vlan.find(vlan_id);
+    if (it == by_vlan.end()) {
+        return STD_ERR(INTERFACE, FAIL, 0);
+    }
+    name = it->second->name;
+    return STD_ERR_OK;
+}
+
+void bridge_map_t::for_each(std::function<void (const std::string &, NAS_BRIDGE *)> fn)
+{
+    std_mutex_simple_lock_guard lg(&bridge_map_lock);
+    for (auto it = by_name.begin(); it != by_name.end(); ++it) {
+        if (it->second->obj != nullptr) {
+            fn(it->second->name, it->second->obj);
+        }
+    }
+}
+
+std::string bridge_map_t::for_each_after(const char *after,
+                                         std::function<bool (const std::string &, NAS_BRIDGE *)> fn)
+{
+    std_mutex_simple_lock_guard lg(&bridge_map_lock);
+    std::string last;
+    bridge_name_key_t key = { after };
+    auto it = (*after == '\0') ? name_order.begin() : name_order.upper_bound(key);
+    for (; it != name_order.end(); ++it) {
+        if (it->second->obj == nullptr) {
+            continue;
+        }
+        if (!fn(it->second->name, it->second->obj)) {
+            break;
+        }
+        last = it->second->name;
+    }
+    return last;
+}
+
 t_std_error bridge_map_t::show(void)
 {
+    std_mutex_simple_lock_guard lg(&bridge_map_lock);
     std::cout << "\n Bridge Map : ";
-    for(auto it = bmap.begin(); it != bmap.end(); ++it)
+    for(auto it = by_name.begin(); it != by_name.end(); ++it)
     {
-        std::cout << "bridge name: " << it->first << "\n";
+        std::cout << "bridge name: " << it->second->name << " ifindex: " << it->second->if_index
+                  << " vlan: " << it->second->vlan_id << "\n";
     }
     // TODO Add bridge show function
     return STD_ERR_OK;
 }
 
-t_std_error nas_bridge_map_obj_add(std::string name, NAS_BRIDGE *br_obj) {
-    return bridge_map.insert(name, br_obj);
+t_std_error nas_bridge_map_obj_add(const std::string &name, NAS_BRIDGE *br_obj) {
+    return bridge_map.insert(name.c_str(), br_obj);
 }
 
-t_std_error nas_bridge_map_obj_remove(std::string name, NAS_BRIDGE **br_obj) {
-    if ((bridge_map.get(name, br_obj)) != STD_ERR_OK) {
+t_std_error nas_bridge_map_obj_remove(const std::string &name, NAS_BRIDGE **br_obj) {
+    if ((bridge_map.get(name.c_str(), br_obj)) != STD_ERR_OK) {
         return STD_ERR(INTERFACE, FAIL, 0);
     }
-    return (bridge_map.remove(name));
+    return (bridge_map.remove(name.c_str()));
+}
+
+t_std_error nas_bridge_map_obj_get(const std::string &name, NAS_BRIDGE **br_obj) {
+    return nas_bridge_map_obj_get(name.c_str(), br_obj);
 }
 
-t_std_error nas_bridge_map_obj_get(std::string name, NAS_BRIDGE **br_obj) {
+t_std_error nas_bridge_map_obj_get(const char *name, NAS_BRIDGE **br_obj) {
     if ((bridge_map.get(name, br_obj)) != STD_ERR_OK) {
         return STD_ERR(INTERFACE, FAIL, 0);
     }
     return STD_ERR_OK;
 }
 
-cps_api_return_code_t nas_bridge_fill_info(std::string br_name, cps_api_object_t obj)
+t_std_error nas_bridge_map_obj_get_by_ifindex(hal_ifindex_t if_index, NAS_BRIDGE **br_obj) {
+    return bridge_map.get_by_ifindex(if_index, br_obj);
+}
+
+t_std_error nas_bridge_map_obj_get_by_vlan(hal_vlan_id_t vlan_id, NAS_BRIDGE **br_obj) {
+    return bridge_map.get_by_vlan(vlan_id, br_obj);
+}
+
+t_std_error nas_bridge_map_vlan_bind(hal_vlan_id_t vlan_id, const std::string &name) {
+    return bridge_map.vlan_bind(vlan_id, name.c_str());
+}
+
+t_std_error nas_bridge_map_vlan_unbind(hal_vlan_id_t vlan_id) {
+    return bridge_map.vlan_unbind(vlan_id);
+}
+
+t_std_error nas_bridge_map_vlan_name_get(hal_vlan_id_t vlan_id, std::string &name) {
+    return bridge_map.vlan_name_get(vlan_id, name);
+}
+
+cps_api_return_code_t nas_bridge_fill_info(const std::string &br_name, cps_api_object_t obj, bool with_members)
 {
     NAS_BRIDGE *br_obj = nullptr;
     if (nas_bridge_map_obj_get(br_name, &br_obj) != STD_ERR_OK) {
         return  cps_api_ret_code_ERR;
     }
-    return (br_obj->nas_bridge_fill_info(obj));
+    return (with_members ? br_obj->nas_bridge_fill_info(obj) : br_obj->nas_bridge_fill_summary(obj));
 }
 
-cps_api_return_code_t nas_fill_all_bridge_info(cps_api_object_list_t *list, model_type_t model, bool get_state)
+static bool _nas_bridge_fill_one(cps_api_object_list_t list, NAS_BRIDGE *br_obj,
+                                 bool with_members, bool get_state)
 {
-    // TODO check if List pointer is required to be passed
-    std::for_each(bridge_map.bmap.begin(), bridge_map.bmap.end(), [list, model, get_state] (pair_t const& br_obj) {
+    cps_api_object_t obj = cps_api_object_create();
+    if(obj == nullptr) return false;
+    cps_api_object_set_type_operation(cps_api_object_key(obj),cps_api_oper_NULL);
+    cps_api_key_from_attr_with_qual(cps_api_object_key(obj),
+        BRIDGE_DOMAIN_BRIDGE_OBJ, cps_api_qualifier_TARGET);
 
+    cps_api_return_code_t rc = (with_members) ? br_obj->nas_bridge_fill_info(obj) :
+                                                br_obj->nas_bridge_fill_summary(obj);
+    if (rc != cps_api_ret_code_OK) {
+        cps_api_object_delete(obj);
+        return false;
+    }
 
-        if (br_obj.second->get_bridge_model() != model) return;
-        cps_api_object_t obj = cps_api_object_create();
-        if(obj == nullptr) return;
-        cps_api_object_set_type_operation(cps_api_object_key(obj),cps_api_oper_NULL);
-        cps_api_key_from_attr_with_qual(cps_api_object_key(obj),
-            BRIDGE_DOMAIN_BRIDGE_OBJ, cps_api_qualifier_TARGET);
+    if (get_state) {
+        cps_convert_to_state_attribute(obj);
+    }
 
-        if (br_obj.second->nas_bridge_fill_info(obj) != cps_api_ret_code_OK) {
-            cps_api_object_delete(obj);
-            return;
-        }
+    if (cps_api_object_list_append(list, obj)) {
+        return true;
+    }
+    cps_api_object_delete(obj);
+    return false;
+}
 
-        if (get_state) {
-            cps_convert_to_state_attribute(obj);
+cps_api_return_code_t nas_fill_bridge_info_page(cps_api_object_list_t list, model_type_t model,
+                                                std::string &cursor, size_t max_count,
+                                                bool with_members, bool get_state)
+{
+    size_t filled = 0;
+    while ((max_count == 0) || (filled < max_count)) {
+        size_t page = NAS_BRIDGE_DUMP_PAGE_SIZE;
+        if ((max_count != 0) && (max_count - filled < page)) {
+            page = max_count - filled;
         }
-
-        if (cps_api_object_list_append(*list, obj)) {
-            return;
-        } else {
-            cps_api_object_delete(obj);
-            return;
+        size_t visited = 0;
+        std::string last;
+        {
+            /*  Hold the bridge lock for one page only so updates can run between pages */
+            std_mutex_simple_lock_guard _lg(nas_bridge_mtx_lock());
+            last = bridge_map.for_each_after(cursor.c_str(),
+                    [&] (const std::string &, NAS_BRIDGE *br_obj) -> bool {
+                if (visited == page) return false;
+                if (br_obj->get_bridge_model() != model) return true;
+                if (_nas_bridge_fill_one(list, br_obj, with_members, get_state)) {
+                    ++visited;
+                }
+                return true;
+            });
         }
-    });
+        filled += visited;
+        if (last.empty() || (visited < page)) {
+            /*  Reached the end of the map */
+            cursor.clear();
+            return cps_api_ret_code_OK;
+        }
+        cursor = last;
+    }
     return cps_api_ret_code_OK;
 }
+
+bool nas_bridge_get_filter_with_members(cps_api_object_t filt, model_type_t model)
+{
+    size_t count = 0;
+    cps_api_filter_get_count(filt, &count);
+    if (!cps_api_filter_is_getnext(filt) && (count == 0)) {
+        return true;
+    }
+    if (model == BRIDGE_MODEL) {
+        return (cps_api_object_attr_get(filt, BRIDGE_DOMAIN_BRIDGE_MEMBER_INTERFACE) != nullptr);
+    }
+    return (cps_api_object_attr_get(filt, DELL_IF_IF_INTERFACES_INTERFACE_TAGGED_PORTS) != nullptr) ||
+           (cps_api_object_attr_get(filt, DELL_IF_IF_INTERFACES_INTERFACE_UNTAGGED_PORTS) != nullptr);
+}
+
+cps_api_return_code_t nas_fill_all_bridge_info(cps_api_object_list_t *list, model_type_t model, bool get_state)
+{
+    std::string cursor;
+    return nas_fill_bridge_info_page(*list, model, cursor, 0, true, get_state);
+}
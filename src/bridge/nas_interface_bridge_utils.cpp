@@ -28,6 +28,7 @@
 #include "bridge/nas_interface_bridge_utils.h"
 #include "bridge/nas_interface_bridge_map.h"
 #include "bridge/nas_interface_bridge_com.h"
+#include "bridge/nas_interface_vlan_scale.h"
 #include "interface/nas_interface.h"
 #include "interface/nas_interface_utils.h"
 
@@ -43,17 +44,9 @@ typedef struct _mem {
 typedef std::list<mem_t> list_t;
 
 
-typedef std::unordered_map<hal_vlan_id_t, std::string>  vlan_to_bridge_map_t;
-
-static vlan_to_bridge_map_t g_vlan_to_bridge_map;
-
+/*  VLAN id to bridge name bindings are kept in the bridge registry */
 bool nas_bridge_vlan_to_bridge_get(hal_vlan_id_t vlan_id, std::string &bridge_name) {
-    auto it = g_vlan_to_bridge_map.find(vlan_id);
-    if (it == g_vlan_to_bridge_map.end()) {
-        return false;
-    }
-    bridge_name = it->second;
-    return true;
+    return (nas_bridge_map_vlan_name_get(vlan_id, bridge_name) == STD_ERR_OK);
 }
 
 bool nas_bridge_vlan_in_use(hal_vlan_id_t vlan_id)
@@ -64,23 +57,11 @@ bool nas_bridge_vlan_in_use(hal_vlan_id_t vlan_id)
 
 bool nas_bridge_vlan_to_bridge_map_add(hal_vlan_id_t vlan_id, std::string &bridge_name)
 {
-    auto it = g_vlan_to_bridge_map.find(vlan_id);
-    if (it != g_vlan_to_bridge_map.end()) {
-        // TODO Already present
-        return false;
-    }
-    g_vlan_to_bridge_map[vlan_id] = bridge_name;
-    return true;
+    return (nas_bridge_map_vlan_bind(vlan_id, bridge_name) == STD_ERR_OK);
 }
 
 bool nas_bridge_vlan_to_bridge_map_del(hal_vlan_id_t vlan_id) {
-    auto it = g_vlan_to_bridge_map.find(vlan_id);
-    if (it == g_vlan_to_bridge_map.end()) {
-        // Not present
-        return false;
-    }
-    g_vlan_to_bridge_map.erase(it);
-    return true;
+    return (nas_bridge_map_vlan_unbind(vlan_id) == STD_ERR_OK);
 }
 
 t_std_error nas_bridge_utils_if_bridge_exists(const char *name, NAS_BRIDGE **bridge_obj) {
@@ -96,7 +77,7 @@ t_std_error nas_bridge_utils_if_bridge_exists(const char *name, NAS_BRIDGE **bri
 t_std_error nas_bridge_utils_vlan_id_get(const char * br_name, hal_vlan_id_t *vlan_id )
 {
     NAS_BRIDGE *br_obj;
-    if (nas_bridge_map_obj_get(std::string(br_name), &br_obj) != STD_ERR_OK) {
+    if (nas_bridge_map_obj_get(br_name, &br_obj) != STD_ERR_OK) {
         return STD_ERR(INTERFACE, FAIL, 0);
     }
     if (br_obj->bridge_mode_get() != BASE_IF_BRIDGE_MODE_1Q)  {
@@ -110,7 +91,7 @@ t_std_error nas_bridge_utils_vlan_id_get(const char * br_name, hal_vlan_id_t *vl
 t_std_error nas_bridge_utils_ifindex_get(const char * br_name, hal_ifindex_t *id )
 {
     NAS_BRIDGE *br_obj;
-    if (nas_bridge_map_obj_get(std::string(br_name), &br_obj) != STD_ERR_OK) {
+    if (nas_bridge_map_obj_get(br_name, &br_obj) != STD_ERR_OK) {
         return STD_ERR(INTERFACE, FAIL, 0);
     }
     *(id) = br_obj->if_index;
@@ -123,7 +104,7 @@ t_std_error nas_bridge_utils_l3_mode_get(const char * br_name, BASE_IF_MODE_t *m
     if (mode == NULL) return STD_ERR(INTERFACE, FAIL, 0);
 
     NAS_BRIDGE *br_obj;
-    if (nas_bridge_map_obj_get(std::string(br_name), &br_obj) != STD_ERR_OK) {
+    if (nas_bridge_map_obj_get(br_name, &br_obj) != STD_ERR_OK) {
         return STD_ERR(INTERFACE, FAIL, 0);
     }
     *mode = br_obj->bridge_l3_mode_get();
@@ -132,7 +113,7 @@ t_std_error nas_bridge_utils_l3_mode_get(const char * br_name, BASE_IF_MODE_t *m
 t_std_error nas_bridge_utils_l3_mode_set(const char * br_name, BASE_IF_MODE_t mode)
 {
     NAS_BRIDGE *br_obj;
-    if (nas_bridge_map_obj_get(std::string(br_name), &br_obj) != STD_ERR_OK) {
+    if (nas_bridge_map_obj_get(br_name, &br_obj) != STD_ERR_OK) {
         return STD_ERR(INTERFACE, FAIL, 0);
     }
     br_obj->bridge_l3_mode_set(mode);
@@ -141,7 +122,7 @@ t_std_error nas_bridge_utils_l3_mode_set(const char * br_name, BASE_IF_MODE_t mo
 t_std_error nas_bridge_utils_vlan_type_set(const char * br_name, BASE_IF_VLAN_TYPE_t vlan_type)
 {
     NAS_BRIDGE *br_obj;
-    if (nas_bridge_map_obj_get(std::string(br_name), &br_obj) != STD_ERR_OK) {
+    if (nas_bridge_map_obj_get(br_name, &br_obj) != STD_ERR_OK) {
         return STD_ERR(INTERFACE, FAIL, 0);
     }
     NAS_DOT1Q_BRIDGE *dot1q_bridge = dynamic_cast<NAS_DOT1Q_BRIDGE *>(br_obj);
@@ -152,7 +133,7 @@ t_std_error nas_bridge_utils_validate_bridge_mem_list(const char *br_name, std::
                                                         std::list <std::string>&mem_list)
 {
     NAS_BRIDGE *br_obj;
-    if (nas_bridge_map_obj_get(std::string(br_name), &br_obj) != STD_ERR_OK) {
+    if (nas_bridge_map_obj_get(br_name, &br_obj) != STD_ERR_OK) {
         EV_LOGGING(INTERFACE, ERR,"NAS-INT", " Bridge obj does not Exists for %s", br_name);
         return STD_ERR(INTERFACE, FAIL, 0);
     }
@@ -213,22 +194,10 @@ t_std_error nas_create_bridge(const char *name, BASE_IF_BRIDGE_MODE_t br_type, h
     return rc;
 }
 
-t_std_error nas_bridge_create_vlan(const char *br_name, hal_vlan_id_t vlan_id, cps_api_object_t obj, NAS_BRIDGE **bridge_obj)
+t_std_error nas_bridge_npu_create_vlan(const char *br_name, hal_vlan_id_t vlan_id, hal_ifindex_t if_index,
+                                        NAS_BRIDGE **bridge_obj)
 {
     t_std_error rc = STD_ERR_OK;
-    hal_ifindex_t if_index;
-
-    // TODO check if bridge exists in the kernel if yes then get the index otherwise create bridge in the kernel
-
-
-    EV_LOGGING(INTERFACE, DEBUG, "NAS-BRIDGE-CREATE", "Create Bridge for %s ",br_name );
-    // TODO change the name of API
-    if (nas_os_add_vlan(obj, &if_index) != STD_ERR_OK) {
-        EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE", " Bridge delete failed in the OS %s", br_name);
-        return STD_ERR(INTERFACE, FAIL, 0);
-    }
-    EV_LOGGING(INTERFACE, NOTICE, "NAS-BRIDGE-CREATE", "Create Bridge for %s in kernel Successful",br_name );
-    cps_api_object_attr_add_u32(obj,DELL_BASE_IF_CMN_IF_INTERFACES_INTERFACE_IF_INDEX,if_index);
     NAS_DOT1Q_BRIDGE *dot1q_br_obj;
     if ((rc = nas_bridge_utils_create_obj(br_name, BASE_IF_BRIDGE_MODE_1Q, if_index, (NAS_BRIDGE **)&dot1q_br_obj)) != STD_ERR_OK) {
         EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE", " Failed to create bridge object, name %s",br_name);
@@ -243,6 +212,24 @@ t_std_error nas_bridge_create_vlan(const char *br_name, hal_vlan_id_t vlan_id, c
         return rc;
     }
     if (bridge_obj != nullptr)  *bridge_obj = dot1q_br_obj;
+    return rc;
+}
+
+t_std_error nas_bridge_create_vlan(const char *br_name, hal_vlan_id_t vlan_id, cps_api_object_t obj, NAS_BRIDGE **bridge_obj)
+{
+    t_std_error rc = STD_ERR_OK;
+    hal_ifindex_t if_index;
+
+    // TODO check if bridge exists in the kernel if yes then get the index otherwise create bridge in the kernel
+
+
+    EV_LOGGING(INTERFACE, DEBUG, "NAS-BRIDGE-CREATE", "Create Bridge for %s ",br_name );
+    if ((rc = nas_bridge_utils_os_create_vlan(br_name, obj, &if_index)) != STD_ERR_OK) {
+        return rc;
+    }
+    if ((rc = nas_bridge_npu_create_vlan(br_name, vlan_id, if_index, bridge_obj)) != STD_ERR_OK) {
+        return rc;
+    }
     EV_LOGGING(INTERFACE, INFO, "NAS-BRIDGE-CREATE", "Create Bridge for %s is Successful",br_name );
     return rc;
 
@@ -356,7 +343,7 @@ t_std_error nas_bridge_utils_mem_list_get(const char * br_name, memberlist_t &me
 }
 t_std_error nas_bridge_utils_mem_list_get(NAS_BRIDGE *br_obj, list_t &mem_list)
 {
-    br_obj->nas_bridge_for_each_member([&mem_list](std::string mem_name, nas_port_mode_t port_mode) {
+    br_obj->nas_bridge_for_each_member([&mem_list](const std::string &mem_name, nas_port_mode_t port_mode) {
         /*  Remove the member from src_br_obj */
         t_std_error rc = STD_ERR_OK;
         nas_int_type_t mem_type;
@@ -371,45 +358,98 @@ t_std_error nas_bridge_utils_mem_list_get(NAS_BRIDGE *br_obj, list_t &mem_list)
     return STD_ERR_OK;
 }
 
-/*  Migrate all tagged and untagged members  */
-static t_std_error nas_npu_migrate_bridge_members(NAS_BRIDGE *dest_br_obj, NAS_BRIDGE *src_br_obj)
+/*  Undo the members already moved by nas_npu_migrate_bridge_members, newest first */
+static void nas_npu_migrate_rollback(NAS_BRIDGE *dest_br_obj, NAS_BRIDGE *src_br_obj,
+                                     list_t &migrated_list)
 {
-    /*  For each member of src_br_obj  */
+    for (auto it = migrated_list.rbegin(); it != migrated_list.rend(); ++it) {
+        if (dest_br_obj->nas_bridge_npu_add_remove_member(it->name, it->type, false) != STD_ERR_OK) {
+            EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE", " Rollback: failed to remove member %s from %s ",
+                           it->name.c_str(), dest_br_obj->get_bridge_name().c_str());
+        }
+        if (src_br_obj->nas_bridge_npu_add_remove_member(it->name, it->type, true) != STD_ERR_OK) {
+            EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE", " Rollback: failed to restore member %s in %s ",
+                           it->name.c_str(), src_br_obj->get_bridge_name().c_str());
+        }
+    }
+    migrated_list.clear();
+}
 
+/*
+ * Migrate all tagged and untagged members. The member set is snapshotted once, then each
+ * member is moved with its source removal immediately followed by the destination add so the
+ * per member outage is limited to two NPU calls. The NPU does not allow the same port and VLAN
+ * to be part of a .1Q VLAN and a .1D sub-port at once, and both bridge objects share the
+ * bridge ifindex in the master table, so the destination can not be programmed ahead of the
+ * source removal. On any failure every member moved so far is returned to the source bridge.
+ */
+static t_std_error nas_npu_migrate_bridge_members(NAS_BRIDGE *dest_br_obj, NAS_BRIDGE *src_br_obj)
+{
+    t_std_error rc = STD_ERR_OK;
     list_t mem_list;
-    // TODO replace with  the utility function
-    src_br_obj->nas_bridge_for_each_member([&mem_list](std::string mem_name, nas_port_mode_t port_mode) {
-        /*  Remove the member from src_br_obj */
-        t_std_error rc = STD_ERR_OK;
-        nas_int_type_t mem_type;
-        if ((rc = nas_get_int_name_type(mem_name.c_str(), &mem_type)) != STD_ERR_OK) {
-            EV_LOGGING(INTERFACE,ERR, "NAS-BRIDGE", " NAS OS L2 PORT Event: Failed to get member type %s ", mem_name.c_str());
-            return rc ;
-        }
-        mem_t _member = {mem_name, mem_type};
-        mem_list.push_back(_member);
-        return STD_ERR_OK;
-    });
+    list_t migrated_list;
 
-    for (auto _member:mem_list) {
+    nas_bridge_utils_mem_list_get(src_br_obj, mem_list);
+
+    EV_LOGGING(INTERFACE,INFO,"NAS-BRIDGE", " Migrating %d members from %s to %s ", (int)mem_list.size(),
+                   src_br_obj->get_bridge_name().c_str(), dest_br_obj->get_bridge_name().c_str());
+
+    for (auto &_member : mem_list) {
 
-        t_std_error rc = STD_ERR_OK;
         if ((rc = src_br_obj->nas_bridge_npu_add_remove_member(_member.name, _member.type, false)) != STD_ERR_OK) {
             EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE", " Failed to migrate members from %s to %s  member name %s ",
                            src_br_obj->get_bridge_name().c_str(),dest_br_obj->get_bridge_name().c_str(), _member.name.c_str());
-            return rc;
+            break;
         }
 
         /*  Add member in the dest_br_obj */
         if ((rc = dest_br_obj->nas_bridge_npu_add_remove_member(_member.name, _member.type, true)) != STD_ERR_OK) {
             EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE", " Failed to migrate members from %s to %s  member name %s ",
                            src_br_obj->get_bridge_name().c_str(),dest_br_obj->get_bridge_name().c_str(), _member.name.c_str());
-            return rc;
+            /*  Put the failed member back in the source before undoing the rest */
+            if (src_br_obj->nas_bridge_npu_add_remove_member(_member.name, _member.type, true) != STD_ERR_OK) {
+                EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE", " Rollback: failed to restore member %s in %s ",
+                               _member.name.c_str(), src_br_obj->get_bridge_name().c_str());
+            }
+            break;
         }
+        migrated_list.push_back(_member);
+    }
+
+    if (rc != STD_ERR_OK) {
+        nas_npu_migrate_rollback(dest_br_obj, src_br_obj, migrated_list);
+        return rc;
     }
     return STD_ERR_OK;
 
 }
+
+/*
+ * Restore the original bridge object after a failed mode change or migration. The new
+ * bridge object is removed from the map and the NPU and the old one is put back.
+ */
+static void nas_bridge_utils_migrate_restore(const char *br_name, NAS_BRIDGE *old_br_obj, NAS_BRIDGE *new_br_obj)
+{
+    std::string _br_name(br_name);
+    NAS_BRIDGE *tmp_br_obj = nullptr;
+
+    if (nas_bridge_map_obj_remove(_br_name, &tmp_br_obj) == STD_ERR_OK) {
+        if (new_br_obj != nullptr) {
+            if (nas_bridge_utils_delete_obj(new_br_obj) != STD_ERR_OK) {
+                EV_LOGGING(INTERFACE,ERR,"NAS-INT", " Failed to delete new bridge object for %s ", br_name);
+            }
+        } else if (tmp_br_obj != old_br_obj) {
+            /*  Object was created but the NPU create failed, nothing to remove from the NPU */
+            delete tmp_br_obj;
+        }
+    }
+    if (nas_bridge_map_obj_add(_br_name, old_br_obj) != STD_ERR_OK) {
+        EV_LOGGING(INTERFACE,ERR,"NAS-INT", " Failed to restore bridge %s in the map ", br_name);
+    }
+    if (old_br_obj->nas_bridge_intf_cntrl_block_register(HAL_INTF_OP_REG) != STD_ERR_OK) {
+        EV_LOGGING(INTERFACE,ERR,"NAS-INT", " Failed to re-register bridge %s ", br_name);
+    }
+}
 /*  Change bridge mode  */
 t_std_error nas_bridge_utils_change_mode(const char *br_name, BASE_IF_BRIDGE_MODE_t br_mode)
 {
@@ -445,11 +485,13 @@ t_std_error nas_bridge_utils_change_mode(const char *br_name, BASE_IF_BRIDGE_MOD
     /* create bridge obj */
     if (nas_create_bridge(br_name, br_mode, idx, &new_br_obj) != STD_ERR_OK) {
         EV_LOGGING(INTERFACE,ERR,"NAS-INT", " Bridge obj create failed %s", br_name);
+        nas_bridge_utils_migrate_restore(br_name, br_obj, new_br_obj);
         return STD_ERR(INTERFACE, FAIL, 0);
     }
     /*      migrate all members from .1q bridge object to .1d bridge object  in the NPU*/
     if ((rc = nas_npu_migrate_bridge_members(new_br_obj, br_obj)) != STD_ERR_OK) {
         EV_LOGGING(INTERFACE,ERR,"NAS-INT", " Bridge member migration failed for bridge %s ", br_name);
+        nas_bridge_utils_migrate_restore(br_name, br_obj, new_br_obj);
         return STD_ERR(INTERFACE, FAIL, 0);
     }
     /*      delete .1q bridge which deletes vlan in the npu */
@@ -495,12 +537,14 @@ t_std_error nas_bridge_utils_npu_add_member(const char *br_name, nas_int_type_t
 
         if (nas_create_bridge(br_name, BASE_IF_BRIDGE_MODE_1D, idx, (NAS_BRIDGE **)&dot1d_br_obj) != STD_ERR_OK) {
             EV_LOGGING(INTERFACE,ERR,"NAS-INT", " Bridge obj create failed %s", br_name);
+            nas_bridge_utils_migrate_restore(br_name, br_obj, (NAS_BRIDGE *)dot1d_br_obj);
             return STD_ERR(INTERFACE, FAIL, 0);
         }
 
     /*      migrate all members from .1q bridge object to .1d bridge object */
         if ((rc = nas_npu_migrate_bridge_members((NAS_BRIDGE *)dot1d_br_obj, br_obj)) != STD_ERR_OK) {
             EV_LOGGING(INTERFACE,ERR,"NAS-INT", " Bridge migration failed ");
+            nas_bridge_utils_migrate_restore(br_name, br_obj, (NAS_BRIDGE *)dot1d_br_obj);
             return STD_ERR(INTERFACE, FAIL, 0);
         }
 
@@ -595,7 +639,7 @@ t_std_error nas_bridge_utils_remove_member(const char *br_name, const char *mem_
 
 /* This publish is for nas internal components like nas-l2 */
 
-static t_std_error
+t_std_error
 nas_bridge_utils_internal_pub_mem_update(const char *br_name, memberlist_t &list, nas_port_mode_t port_mode,  cps_api_operation_types_t op )
 {
     cps_api_attr_id_t id =0;
@@ -664,6 +708,58 @@ nas_bridge_utils_internal_pub_mem_update(const char *br_name, memberlist_t &list
 
 }
 
+/*
+ * In VLAN scale mode tagged members are kept as parent names in the VLAN bitmaps. Members
+ * are passed in and returned as VLAN sub interface names like for other VLANs.
+ */
+static t_std_error nas_bridge_utils_scale_update_tagged_list(NAS_BRIDGE *br_obj, memberlist_t &new_list,
+                                                            memberlist_t &cur_list)
+{
+    NAS_DOT1Q_BRIDGE *dot1q_bridge = dynamic_cast<NAS_DOT1Q_BRIDGE *>(br_obj);
+    hal_vlan_id_t vlan_id = dot1q_bridge->nas_bridge_vlan_id_get();
+    std::string suffix = "." + std::to_string(vlan_id);
+
+    memberlist_t parent_list, prev_list;
+    for (auto &mem : new_list) {
+        if ((mem.size() > suffix.size()) &&
+            (mem.compare(mem.size() - suffix.size(), suffix.size(), suffix) == 0)) {
+            parent_list.insert(mem.substr(0, mem.size() - suffix.size()));
+        } else {
+            parent_list.insert(mem);
+        }
+    }
+    t_std_error rc = nas_vlan_scale_vlan_members_set(vlan_id, parent_list, &prev_list);
+    if (cur_list.empty()) {
+        for (auto &mem : prev_list) {
+            cur_list.insert(mem + suffix);
+        }
+    }
+    if (rc != STD_ERR_OK) {
+        EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE", "Failed to update tagged members of scaled VLAN %d", vlan_id);
+    }
+    return rc;
+}
+
+/*
+ * Members of new_list missing from cur_list go to add_list and members of cur_list missing
+ * from new_list go to remove_list. Each name is one hash lookup and only the names which
+ * change are copied.
+ */
+static void nas_bridge_utils_memberlist_diff(const memberlist_t &new_list, const memberlist_t &cur_list,
+                                             memberlist_t &add_list, memberlist_t &remove_list)
+{
+    for (auto &mem : new_list) {
+        if (cur_list.find(mem) == cur_list.end()) {
+            add_list.insert(mem);
+        }
+    }
+    for (auto &mem : cur_list) {
+        if (new_list.find(mem) == new_list.end()) {
+            remove_list.insert(mem);
+        }
+    }
+}
+
 t_std_error nas_bridge_utils_update_member_list(const char *br_name, memberlist_t &new_list,
                                                                 memberlist_t &cur_list , nas_port_mode_t port_mode)
 {
@@ -677,28 +773,20 @@ t_std_error nas_bridge_utils_update_member_list(const char *br_name, memberlist_
         EV_LOGGING(INTERFACE,ERR,"NAS-INT", " Bridge %s not present in the map ", br_name);
         return STD_ERR(INTERFACE, FAIL, 0);
     }
+    if ((port_mode == NAS_PORT_TAGGED) && nas_vlan_scale_bridge_managed(br_obj)) {
+        return nas_bridge_utils_scale_update_tagged_list(br_obj, new_list, cur_list);
+    }
     /*  Get the current list  */
     if (cur_list.empty()) {
         br_obj->nas_bridge_get_member_list(port_mode, cur_list);
     }
 
-    // TODO check if either new_list or cur_list if empty
-    // find out the members to be added
-    //
-    for (auto mem : new_list) {
-        auto it = cur_list.find(mem);
-        if (it == cur_list.end()) {
-            add_list.insert(mem);
-        }
-    }
-    // find out the members to be removed by looking for the
-    // mmebers from current list not present in the new list
-    for (auto mem : cur_list) {
-        auto it = new_list.find(mem);
-        if (it == new_list.end()) {
-            remove_list.insert(mem);
-        }
+    nas_bridge_utils_memberlist_diff(new_list, cur_list, add_list, remove_list);
+    if (add_list.empty() && remove_list.empty()) {
+        return STD_ERR_OK;
     }
+    EV_LOGGING(INTERFACE,INFO,"NAS-BRIDGE", "Bridge %s: %lu members to add, %lu to remove",
+               br_name, add_list.size(), remove_list.size());
     // In case if this vlan bridge attached to a parent bridge which is of 1D type then add all members to
     // the the parent bridge only. on the vlan bridge, just update the lsit
     bool add_to_parent = false;
@@ -813,12 +901,12 @@ t_std_error nas_bridge_utils_attach_vlan(const char *vlan_intf, const char *pare
     /* Get the objects of vlan_obj and p_bridge_obj */
     EV_LOGGING(INTERFACE,INFO,"VLAN-ATTACH"," Attach Vlan %s to parent Bridge %s ",vlan_intf,parent_bridge);
     NAS_BRIDGE *p_br_obj = nullptr;
-    if (nas_bridge_map_obj_get(std::string(parent_bridge), &p_br_obj) != STD_ERR_OK) {
+    if (nas_bridge_map_obj_get(parent_bridge, &p_br_obj) != STD_ERR_OK) {
         EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE", " Parent Bridge %s not present in the map ", parent_bridge);
         return STD_ERR(INTERFACE, FAIL, 0);
     }
     NAS_BRIDGE *vlan_br_obj = nullptr;
-    if (nas_bridge_map_obj_get(std::string(vlan_intf), &vlan_br_obj) != STD_ERR_OK) {
+    if (nas_bridge_map_obj_get(vlan_intf, &vlan_br_obj) != STD_ERR_OK) {
         EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE", " Vlan Bridge %s not present in the map ", vlan_intf);
         return STD_ERR(INTERFACE, FAIL, 0);
     }
@@ -828,6 +916,15 @@ t_std_error nas_bridge_utils_attach_vlan(const char *vlan_intf, const char *pare
         EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE", " parent Bridge already  present for %s ", vlan_intf);
         return STD_ERR(INTERFACE, FAIL, 0);
     }
+    /*  Tagged members kept in the VLAN bitmaps can not be migrated to a .1D bridge */
+    if ((p_br_obj->bridge_mode_get() == BASE_IF_BRIDGE_MODE_1D) && nas_vlan_scale_bridge_managed(vlan_br_obj)) {
+        NAS_DOT1Q_BRIDGE * vlan_1q_obj = dynamic_cast<NAS_DOT1Q_BRIDGE *>(vlan_br_obj);
+        if (nas_vlan_scale_vlan_has_members(vlan_1q_obj->nas_bridge_vlan_id_get())) {
+            EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE", " Scaled VLAN %s has tagged members, can not attach to %s ",
+                       vlan_intf, parent_bridge);
+            return STD_ERR(INTERFACE, FAIL, 0);
+        }
+    }
     //
 //   if parent bridge is 1Q and it does not have any member
 //      just mark the parent bridge and leave and update bridge object
@@ -880,12 +977,12 @@ t_std_error nas_bridge_utils_detach_vlan(const char *vlan_intf, const char *pare
     EV_LOGGING(INTERFACE,INFO,"VLAN-ATTACH", " Detach Vlan %s from parent Bridge %s ", vlan_intf,parent_bridge);
     NAS_BRIDGE *vlan_br_obj = nullptr;
     std::string p_bridge(parent_bridge);
-    if (nas_bridge_map_obj_get(std::string(vlan_intf), &vlan_br_obj) != STD_ERR_OK) {
+    if (nas_bridge_map_obj_get(vlan_intf, &vlan_br_obj) != STD_ERR_OK) {
         EV_LOGGING(INTERFACE,ERR,"NAS-INT", " Bridge %s not present in the map ", vlan_intf);
         return STD_ERR(INTERFACE, FAIL, 0);
     }
     NAS_BRIDGE *p_br_obj = nullptr;
-    if (nas_bridge_map_obj_get(std::string(parent_bridge), &p_br_obj) != STD_ERR_OK) {
+    if (nas_bridge_map_obj_get(parent_bridge, &p_br_obj) != STD_ERR_OK) {
         EV_LOGGING(INTERFACE,ERR,"NAS-INT", " Parent Bridge %s not present in the map ", parent_bridge);
         return STD_ERR(INTERFACE, FAIL, 0);
     }
@@ -1223,7 +1320,7 @@ void nas_bridge_utils_publish_event(const char * bridge_name, cps_api_operation_
     cps_api_set_key_data(og.get(),BRIDGE_DOMAIN_BRIDGE_NAME,
                                cps_api_object_ATTR_T_BIN, bridge_name, strlen(bridge_name)+1);
     if (op == cps_api_oper_CREATE) {
-      if (nas_bridge_fill_info(std::string(bridge_name), og.get()) != STD_ERR_OK) {
+      if (nas_bridge_fill_info(bridge_name, og.get()) != STD_ERR_OK) {
         EV_LOGGING(INTERFACE,ERR,"NAS-IF","Failed to add Bridge info");
       }
     }
@@ -1243,7 +1340,7 @@ void nas_bridge_utils_publish_member_event(std::string bridge_name, std::string
     bridge_obj->nas_bridge_publish_member_event(mem_name, op);
 }
 
-void nas_bridge_utils_publish_memberlist_event(std::string bridge_name, memberlist_t memlist,
+void nas_bridge_utils_publish_memberlist_event(const std::string &bridge_name, const memberlist_t &memlist,
         cps_api_operation_types_t op)
 {
     NAS_BRIDGE *bridge_obj = nullptr;
@@ -1313,6 +1410,18 @@ t_std_error nas_bridge_utils_os_create_bridge(const char *br_name, hal_ifindex_t
     return STD_ERR_OK;
 }
 
+t_std_error nas_bridge_utils_os_create_vlan(const char *br_name, cps_api_object_t obj, hal_ifindex_t *if_index)
+{
+    // TODO change the name of API
+    if (nas_os_add_vlan(obj, if_index) != STD_ERR_OK) {
+        EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE", " Bridge create failed in the OS %s", br_name);
+        return STD_ERR(INTERFACE, FAIL, 0);
+    }
+    EV_LOGGING(INTERFACE, NOTICE, "NAS-BRIDGE-CREATE", "Create Bridge for %s in kernel Successful",br_name );
+    cps_api_object_attr_add_u32(obj,DELL_BASE_IF_CMN_IF_INTERFACES_INTERFACE_IF_INDEX,*if_index);
+    return STD_ERR_OK;
+}
+
 t_std_error nas_bridge_utils_os_delete_bridge(const char *br_name)
 {
     cps_api_object_guard _og(cps_api_object_create());
@@ -1345,7 +1454,7 @@ void nas_bridge_utils_publish_vlan_intf_event(const char * bridge_name, cps_api_
                             strlen(IF_INTERFACE_TYPE_IANAIFT_IANA_INTERFACE_TYPE_IANAIFT_L2VLAN)+1);
     cps_api_object_set_type_operation(cps_api_object_key(og.get()), op);
     if (op == cps_api_oper_CREATE) {
-      if (nas_bridge_fill_info(std::string(bridge_name), og.get()) != STD_ERR_OK) {
+      if (nas_bridge_fill_info(bridge_name, og.get()) != STD_ERR_OK) {
         EV_LOGGING(INTERFACE,ERR,"NAS-IF","Failed to add Bridge info");
       }
     }
@@ -1380,6 +1489,14 @@ t_std_error nas_bridge_delete_bridge(const char *br_name)
         br_obj->nas_bridge_add_remove_memberlist(untagged_list, NAS_PORT_UNTAGGED, true);
         return rc;
     }
+    if ((br_obj->bridge_mode_get() == BASE_IF_BRIDGE_MODE_1Q) && (br_obj->get_bridge_model() == INT_VLAN_MODEL)) {
+        /*  Remove tagged members kept in the VLAN bitmaps  */
+        NAS_DOT1Q_BRIDGE *dot1q_bridge = dynamic_cast<NAS_DOT1Q_BRIDGE *>(br_obj);
+        if ((rc = nas_vlan_scale_vlan_clear(dot1q_bridge->nas_bridge_vlan_id_get())) != STD_ERR_OK) {
+            EV_LOGGING(INTERFACE,ERR,"NAS-BRIDGE", " Failed to delete scaled tagged members %s", br_name);
+            return rc;
+        }
+    }
     if (br_obj->bridge_mode_get() == BASE_IF_BRIDGE_MODE_1D)  {
         /*  Delete  VXLAN members if any */
         memberlist_t vxlan_list;
@@ -1454,7 +1571,7 @@ t_std_error nas_bridge_process_cps_memberlist(const char *br_name, memberlist_t
     return STD_ERR_OK;
 }
 
-t_std_error nas_bridge_utils_os_add_remove_memberlist(const char *br_name, memberlist_t & memlist, nas_port_mode_t port_mode, bool add)
+t_std_error nas_bridge_utils_os_add_remove_memberlist(const char *br_name, const memberlist_t & memlist, nas_port_mode_t port_mode, bool add)
 {
 
     NAS_BRIDGE *br_obj = nullptr;
@@ -1489,6 +1606,15 @@ t_std_error nas_bridge_utils_set_learning_disable(const char *br_name, bool disa
     return br_obj->nas_bridge_set_learning_disable(disable);
 }
 
+bool nas_bridge_utils_vlan_scale_managed(const char *br_name)
+{
+    NAS_BRIDGE *br_obj = nullptr;
+    if (nas_bridge_map_obj_get(br_name, &br_obj) != STD_ERR_OK) {
+        return false;
+    }
+    return nas_vlan_scale_bridge_managed(br_obj);
+}
+
 t_std_error nas_bridge_utils_check_membership(const char *br_name, const char *mem_name , bool *present)
 {
 
@@ -1509,7 +1635,14 @@ t_std_error nas_bridge_utils_check_membership(const char *br_name, const char *m
     nas_port_mode_t port_mode = (mem_type == nas_int_type_VLANSUB_INTF) ? NAS_PORT_TAGGED: NAS_PORT_UNTAGGED;
 
     if (mem_type != nas_int_type_VXLAN) {
-        if (port_mode == NAS_PORT_TAGGED)  {
+        if ((port_mode == NAS_PORT_TAGGED) && nas_vlan_scale_bridge_managed(br_obj)) {
+            /*  Scaled VLANs keep tagged members in the VLAN bitmaps under the parent name */
+            std::string parent;
+            NAS_DOT1Q_BRIDGE *dot1q_bridge = dynamic_cast<NAS_DOT1Q_BRIDGE *>(br_obj);
+            if (nas_interface_utils_parent_name_get(_mem_name, parent) == STD_ERR_OK) {
+                *present = nas_vlan_scale_member_vlan_test(parent, dot1q_bridge->nas_bridge_vlan_id_get());
+            }
+        } else if (port_mode == NAS_PORT_TAGGED)  {
             br_obj->nas_bridge_check_tagged_membership(_mem_name, present);
         } else {
             br_obj->nas_bridge_check_untagged_membership(_mem_name, present);
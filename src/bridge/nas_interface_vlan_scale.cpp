@@ -0,0 +1,357 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+
+/*
+ * filename: nas_interface_vlan_scale.cpp
+ */
+
+#include "dell-interface.h"
+#include "nas_int_utils.h"
+#include "bridge/nas_interface_vlan_scale.h"
+#include "bridge/nas_interface_bridge_com.h"
+#include "bridge/nas_interface_bridge_map.h"
+#include "bridge/nas_interface_bridge_utils.h"
+#include "interface/nas_interface_utils.h"
+#include "std_mutex_lock.h"
+#include "event_log.h"
+#include "event_log_types.h"
+
+#include <unordered_map>
+#include <map>
+#include <vector>
+
+static std_mutex_lock_create_static_init_rec(vlan_scale_lock);
+static auto &member_vlans = *new std::unordered_map<std::string, nas_vlan_bitmap_t>;
+
+/*  Members to add to and remove from one VLAN  */
+struct vlan_delta_t {
+    memberlist_t add;
+    memberlist_t del;
+};
+typedef std::map<hal_vlan_id_t, vlan_delta_t> vlan_delta_map_t;
+
+/*  NPU members of one VLAN grouped so each group is one NDI call  */
+struct vlan_npu_members_t {
+    std::map<npu_id_t, std::vector<ndi_port_t>> ports;
+    std::vector<ndi_obj_id_t> lags;
+    std::vector<interface_ctrl_t> intfs;
+};
+
+bool nas_vlan_scale_bridge_managed(NAS_BRIDGE *br_obj)
+{
+    if ((br_obj == nullptr) || (nas_g_scaled_vlan_get() == false)) return false;
+    if (br_obj->bridge_mode_get() != BASE_IF_BRIDGE_MODE_1Q) return false;
+    if (br_obj->get_bridge_model() != INT_VLAN_MODEL) return false;
+    /*  Members of a VLAN attached to a .1D bridge are kept by the parent bridge */
+    return !br_obj->bridge_is_parent_bridge_exists();
+}
+
+static void _vlan_scale_subintf_list(hal_vlan_id_t vlan_id, const memberlist_t &members, memberlist_t &subintf_list)
+{
+    for (auto &mem : members) {
+        subintf_list.insert(mem + "." + std::to_string(vlan_id));
+    }
+}
+
+/*  Kernel VLAN devices and kernel bridge membership, only present for L3 VLANs  */
+static t_std_error _vlan_scale_os_update(NAS_BRIDGE *br_obj, hal_vlan_id_t vlan_id,
+                                         const memberlist_t &members, bool add)
+{
+    if (members.empty() || (br_obj->bridge_l3_mode_get() != BASE_IF_MODE_MODE_L3)) return STD_ERR_OK;
+
+    t_std_error rc = STD_ERR_OK;
+    memberlist_t subintf_list;
+    _vlan_scale_subintf_list(vlan_id, members, subintf_list);
+    if (add) {
+        if ((rc = nas_interface_vlan_subintf_list_create(subintf_list, vlan_id, true)) != STD_ERR_OK) {
+            return rc;
+        }
+        if ((rc = br_obj->nas_bridge_os_add_remove_memberlist(subintf_list, NAS_PORT_TAGGED, true)) != STD_ERR_OK) {
+            nas_interface_vlan_subintf_list_delete(subintf_list);
+        }
+        return rc;
+    }
+    if ((rc = br_obj->nas_bridge_os_add_remove_memberlist(subintf_list, NAS_PORT_TAGGED, false)) != STD_ERR_OK) {
+        return rc;
+    }
+    return nas_interface_vlan_subintf_list_delete(subintf_list);
+}
+
+static t_std_error _vlan_scale_npu_members_get(const memberlist_t &members, vlan_npu_members_t &npu_members)
+{
+    for (auto &mem : members) {
+        interface_ctrl_t intf_ctrl;
+        t_std_error rc;
+        if ((rc = nas_intf_id_resolve(mem, &intf_ctrl)) != STD_ERR_OK) {
+            EV_LOGGING(INTERFACE, ERR, "NAS-VLAN-SCALE", "Interface %s returned error %d", mem.c_str(), rc);
+            return rc;
+        }
+        if (intf_ctrl.int_type == nas_int_type_LAG) {
+            npu_members.lags.push_back(intf_ctrl.lag_id);
+        } else if ((intf_ctrl.int_type == nas_int_type_PORT) || (intf_ctrl.int_type == nas_int_type_FC)) {
+            if (!nas_is_virtual_port(intf_ctrl.if_index)) {
+                ndi_port_t ndi_port = {intf_ctrl.npu_id, intf_ctrl.port_id};
+                npu_members.ports[intf_ctrl.npu_id].push_back(ndi_port);
+            }
+        } else {
+            EV_LOGGING(INTERFACE, ERR, "NAS-VLAN-SCALE", "Unsupported tagged member %s type %d",
+                       mem.c_str(), intf_ctrl.int_type);
+            return STD_ERR(INTERFACE, PARAM, 0);
+        }
+        npu_members.intfs.push_back(intf_ctrl);
+    }
+    return STD_ERR_OK;
+}
+
+static t_std_error _vlan_scale_npu_ports(npu_id_t npu, hal_vlan_id_t vlan_id, std::vector<ndi_port_t> &ports, bool add)
+{
+    ndi_port_list_t port_list = {ports.size(), &ports[0]};
+    return add ? ndi_add_ports_to_vlan(npu, vlan_id, &port_list, NULL) :
+                 ndi_del_ports_from_vlan(npu, vlan_id, &port_list, NULL);
+}
+
+static t_std_error _vlan_scale_npu_lags(hal_vlan_id_t vlan_id, std::vector<ndi_obj_id_t> &lags, bool add)
+{
+    return add ? ndi_add_lag_to_vlan(0, vlan_id, &lags[0], lags.size(), NULL, 0) :
+                 ndi_del_lag_from_vlan(0, vlan_id, &lags[0], lags.size(), NULL, 0);
+}
+
+/*  One NDI call per NPU for ports and one for LAGs, reverted if a later call fails  */
+static t_std_error _vlan_scale_npu_update(hal_vlan_id_t vlan_id, vlan_npu_members_t &npu_members, bool add)
+{
+    t_std_error rc = STD_ERR_OK;
+    std::vector<npu_id_t> done;
+    for (auto &it : npu_members.ports) {
+        if ((rc = _vlan_scale_npu_ports(it.first, vlan_id, it.second, add)) != STD_ERR_OK) {
+            EV_LOGGING(INTERFACE, ERR, "NAS-VLAN-SCALE", "Failed to %s %lu ports %s VLAN %d in NPU %d",
+                       add ? "add" : "remove", it.second.size(), add ? "to" : "from", vlan_id, it.first);
+            break;
+        }
+        done.push_back(it.first);
+    }
+    if ((rc == STD_ERR_OK) && !npu_members.lags.empty()) {
+        if ((rc = _vlan_scale_npu_lags(vlan_id, npu_members.lags, add)) != STD_ERR_OK) {
+            EV_LOGGING(INTERFACE, ERR, "NAS-VLAN-SCALE", "Failed to %s %lu LAGs %s VLAN %d",
+                       add ? "add" : "remove", npu_members.lags.size(), add ? "to" : "from", vlan_id);
+        }
+    }
+    if (rc != STD_ERR_OK) {
+        for (auto it = done.rbegin(); it != done.rend(); ++it) {
+            _vlan_scale_npu_ports(*it, vlan_id, npu_members.ports[*it], !add);
+        }
+    }
+    return rc;
+}
+
+/*  Master tracking, L2 mode and tagged/untagged drop of the members after the NPU update  */
+static void _vlan_scale_member_update(NAS_BRIDGE *br_obj, hal_vlan_id_t vlan_id,
+                                      vlan_npu_members_t &npu_members, bool add)
+{
+    if_master_info_t master_info = { nas_int_type_VLAN, NAS_PORT_TAGGED, br_obj->get_bridge_intf_index() };
+    for (auto &intf_ctrl : npu_members.intfs) {
+        BASE_IF_MODE_t new_mode;
+        bool mode_change = false;
+        if (add) {
+            if (!nas_intf_add_master(intf_ctrl.if_index, master_info, &new_mode, &mode_change)) {
+                EV_LOGGING(INTERFACE, ERR, "NAS-VLAN-SCALE", "Failed to add master %s for member %s",
+                           br_obj->bridge_name.c_str(), intf_ctrl.if_name);
+            }
+        } else {
+            if (!nas_intf_del_master(intf_ctrl.if_index, master_info, &new_mode, &mode_change)) {
+                EV_LOGGING(INTERFACE, ERR, "NAS-VLAN-SCALE", "Failed to delete master %s for member %s",
+                           br_obj->bridge_name.c_str(), intf_ctrl.if_name);
+            }
+            nas_intf_cleanup_l2mc_config(intf_ctrl.if_index, vlan_id);
+        }
+        if (mode_change && !nas_intf_handle_intf_mode_change(intf_ctrl.if_index, new_mode)) {
+            EV_LOGGING(INTERFACE, ERR, "NAS-VLAN-SCALE", "Update to NAS-L3 about interface mode change failed(%s)",
+                       intf_ctrl.if_name);
+        }
+        if (intf_ctrl.int_type == nas_int_type_LAG) {
+            br_obj->nas_bridge_set_lag_tag_untag_drop(br_obj->npu_id, intf_ctrl.lag_id, intf_ctrl.if_index);
+            if (add) {
+                nas_interface_utils_config_lag_1q_mac_learn_mode(std::string(intf_ctrl.if_name),
+                                                                 br_obj->npu_id, intf_ctrl.lag_id);
+            }
+        } else if (!nas_is_virtual_port(intf_ctrl.if_index)) {
+            ndi_port_t ndi_port = {intf_ctrl.npu_id, intf_ctrl.port_id};
+            br_obj->nas_bridge_set_tag_untag_drop(intf_ctrl.if_index, &ndi_port);
+            if (add) {
+                nas_interface_utils_config_port_1q_mac_learn_mode(std::string(intf_ctrl.if_name), &ndi_port);
+            }
+        }
+    }
+}
+
+static void _vlan_scale_bits_update(hal_vlan_id_t vlan_id, const memberlist_t &members, bool add)
+{
+    for (auto &mem : members) {
+        nas_vlan_bitmap_t &vlans = member_vlans[mem];
+        vlans.set(vlan_id, add);
+        if (vlans.none()) member_vlans.erase(mem);
+    }
+}
+
+static t_std_error _vlan_scale_members_update(NAS_BRIDGE *br_obj, hal_vlan_id_t vlan_id,
+                                              const memberlist_t &members, bool add)
+{
+    if (members.empty()) return STD_ERR_OK;
+
+    t_std_error rc = STD_ERR_OK;
+    vlan_npu_members_t npu_members;
+    if ((rc = _vlan_scale_npu_members_get(members, npu_members)) != STD_ERR_OK) {
+        return rc;
+    }
+    /*  Kernel devices go first on add and last on remove, as for non scaled VLANs */
+    if (add && ((rc = _vlan_scale_os_update(br_obj, vlan_id, members, true)) != STD_ERR_OK)) {
+        return rc;
+    }
+    if ((rc = _vlan_scale_npu_update(vlan_id, npu_members, add)) != STD_ERR_OK) {
+        if (add) _vlan_scale_os_update(br_obj, vlan_id, members, false);
+        return rc;
+    }
+    _vlan_scale_bits_update(vlan_id, members, add);
+    _vlan_scale_member_update(br_obj, vlan_id, npu_members, add);
+    if (!add && ((rc = _vlan_scale_os_update(br_obj, vlan_id, members, false)) != STD_ERR_OK)) {
+        EV_LOGGING(INTERFACE, ERR, "NAS-VLAN-SCALE", "Failed to remove kernel VLAN devices of VLAN %d", vlan_id);
+    }
+
+    memberlist_t pub_list(members);
+    nas_bridge_utils_internal_pub_mem_update(br_obj->bridge_name.c_str(), pub_list, NAS_PORT_TAGGED,
+                                             add ? cps_api_oper_CREATE : cps_api_oper_DELETE);
+    return STD_ERR_OK;
+}
+
+/*
+ * Apply the VLAN deltas in VLAN order. If a VLAN fails, the VLANs already applied are
+ * reverted in reverse order so the bitmaps and the NPU stay in step.
+ */
+static t_std_error _vlan_scale_apply(vlan_delta_map_t &deltas)
+{
+    t_std_error rc = STD_ERR_OK;
+    std::vector<std::pair<NAS_BRIDGE *, vlan_delta_map_t::iterator>> applied;
+    for (auto it = deltas.begin(); it != deltas.end(); ++it) {
+        NAS_BRIDGE *br_obj = nullptr;
+        if (nas_bridge_map_obj_get_by_vlan(it->first, &br_obj) != STD_ERR_OK) {
+            EV_LOGGING(INTERFACE, ERR, "NAS-VLAN-SCALE", "No bridge for VLAN %d", it->first);
+            rc = STD_ERR(INTERFACE, PARAM, 0);
+            break;
+        }
+        if ((rc = _vlan_scale_members_update(br_obj, it->first, it->second.add, true)) != STD_ERR_OK) {
+            break;
+        }
+        if ((rc = _vlan_scale_members_update(br_obj, it->first, it->second.del, false)) != STD_ERR_OK) {
+            _vlan_scale_members_update(br_obj, it->first, it->second.add, false);
+            break;
+        }
+        applied.push_back(std::make_pair(br_obj, it));
+    }
+    if (rc != STD_ERR_OK) {
+        for (auto it = applied.rbegin(); it != applied.rend(); ++it) {
+            hal_vlan_id_t vlan_id = it->second->first;
+            _vlan_scale_members_update(it->first, vlan_id, it->second->second.del, true);
+            _vlan_scale_members_update(it->first, vlan_id, it->second->second.add, false);
+        }
+    }
+    return rc;
+}
+
+t_std_error nas_vlan_scale_vlan_members_set(hal_vlan_id_t vlan_id, const memberlist_t &members,
+                                            memberlist_t *cur_members)
+{
+    if ((vlan_id == 0) || (vlan_id >= NAS_VLAN_BITMAP_BITS)) return STD_ERR(INTERFACE, PARAM, 0);
+
+    std_mutex_simple_lock_guard _lg(&vlan_scale_lock);
+    vlan_delta_map_t deltas;
+    vlan_delta_t &delta = deltas[vlan_id];
+    for (auto &it : member_vlans) {
+        if (!it.second.test(vlan_id)) continue;
+        if (cur_members != nullptr) cur_members->insert(it.first);
+        if (members.find(it.first) == members.end()) delta.del.insert(it.first);
+    }
+    for (auto &mem : members) {
+        auto it = member_vlans.find(mem);
+        if ((it == member_vlans.end()) || !it->second.test(vlan_id)) delta.add.insert(mem);
+    }
+    if (delta.add.empty() && delta.del.empty()) return STD_ERR_OK;
+    EV_LOGGING(INTERFACE, INFO, "NAS-VLAN-SCALE", "VLAN %d: %lu tagged members added, %lu removed",
+               vlan_id, delta.add.size(), delta.del.size());
+    return _vlan_scale_apply(deltas);
+}
+
+void nas_vlan_scale_vlan_members_get(hal_vlan_id_t vlan_id, memberlist_t &members)
+{
+    if (vlan_id >= NAS_VLAN_BITMAP_BITS) return;
+    std_mutex_simple_lock_guard _lg(&vlan_scale_lock);
+    for (auto &it : member_vlans) {
+        if (it.second.test(vlan_id)) members.insert(it.first);
+    }
+}
+
+bool nas_vlan_scale_member_vlan_test(const std::string &mem, hal_vlan_id_t vlan_id)
+{
+    if (vlan_id >= NAS_VLAN_BITMAP_BITS) return false;
+    std_mutex_simple_lock_guard _lg(&vlan_scale_lock);
+    auto it = member_vlans.find(mem);
+    return (it != member_vlans.end()) && it->second.test(vlan_id);
+}
+
+bool nas_vlan_scale_vlan_has_members(hal_vlan_id_t vlan_id)
+{
+    if (vlan_id >= NAS_VLAN_BITMAP_BITS) return false;
+    std_mutex_simple_lock_guard _lg(&vlan_scale_lock);
+    for (auto &it : member_vlans) {
+        if (it.second.test(vlan_id)) return true;
+    }
+    return false;
+}
+
+t_std_error nas_vlan_scale_vlan_clear(hal_vlan_id_t vlan_id)
+{
+    memberlist_t empty;
+    return nas_vlan_scale_vlan_members_set(vlan_id, empty);
+}
+
+void nas_vlan_scale_member_clear(const std::string &mem)
+{
+    std_mutex_simple_lock_guard _lg(&vlan_scale_lock);
+    auto it = member_vlans.find(mem);
+    if (it == member_vlans.end()) return;
+    EV_LOGGING(INTERFACE, INFO, "NAS-VLAN-SCALE", "Member %s deleted, dropping its %lu tagged VLANs",
+               mem.c_str(), it->second.count());
+    member_vlans.erase(it);
+}
+
+t_std_error nas_vlan_scale_os_members_update(hal_vlan_id_t vlan_id, bool create)
+{
+    NAS_BRIDGE *br_obj = nullptr;
+    if (nas_bridge_map_obj_get_by_vlan(vlan_id, &br_obj) != STD_ERR_OK) {
+        return STD_ERR(INTERFACE, PARAM, 0);
+    }
+    memberlist_t members;
+    nas_vlan_scale_vlan_members_get(vlan_id, members);
+    return _vlan_scale_os_update(br_obj, vlan_id, members, create);
+}
+
+void nas_vlan_scale_fill_tagged_members(hal_vlan_id_t vlan_id, cps_api_object_t obj)
+{
+    memberlist_t members;
+    nas_vlan_scale_vlan_members_get(vlan_id, members);
+    for (auto &mem : members) {
+        cps_api_object_attr_add(obj, DELL_IF_IF_INTERFACES_INTERFACE_TAGGED_PORTS, mem.c_str(), mem.size()+1);
+    }
+}
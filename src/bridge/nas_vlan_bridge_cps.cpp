@@ -29,6 +29,7 @@
 #include "bridge/nas_interface_bridge_map.h"
 #include "bridge/nas_vlan_bridge_cps.h"
 #include "bridge/nas_interface_bridge_com.h"
+#include "bridge/nas_interface_vlan_scale.h"
 
 #include "cps_api_object_key.h"
 #include "cps_api_object_tools.h"
@@ -42,7 +43,10 @@
 #include "nas_int_com_utils.h"
 #include "std_config_node.h"
 #include "std_mutex_lock.h"
+#include "hal_interface_common.h"
 #include <unordered_set>
+#include <vector>
+#include <algorithm>
 
 #define NUM_INT_CPS_API_THREAD 1
 static cps_api_operation_handle_t nas_if_global_handle;
@@ -65,10 +69,9 @@ static bool nas_bridge_process_port_association(const char *if_name, npu_id_t np
             continue;
         }else if(it.type == nas_int_type_VLAN){
             ndi_port_t ndi_port = { npu, port };
-            char bridge_name[HAL_IF_NAME_SZ];
-            memset(bridge_name, 0 , sizeof(bridge_name));
-            if ((rc = nas_int_get_if_index_to_name(it.m_if_idx, bridge_name, HAL_IF_NAME_SZ)) == STD_ERR_OK) {
-                nas_bridge_utils_associate_npu_port(bridge_name, if_name, &ndi_port, it.mode, add);
+            NAS_BRIDGE *br_obj = nullptr;
+            if ((rc = nas_bridge_map_obj_get_by_ifindex(it.m_if_idx, &br_obj)) == STD_ERR_OK) {
+                nas_bridge_utils_associate_npu_port(br_obj->bridge_name.c_str(), if_name, &ndi_port, it.mode, add);
             }
         }
     }
@@ -96,6 +99,19 @@ static bool _nas_bridge_handle_mode_change(const char *br_name, BASE_IF_MODE_t m
     std_mutex_simple_lock_guard _lg(nas_vlan_mode_mtx());
     if(nas_g_scaled_vlan_get() == false) return true;
 
+    hal_vlan_id_t vlan_id = 0;
+    nas_bridge_utils_vlan_id_get(br_name, &vlan_id);
+    BASE_IF_MODE_t cur_mode = BASE_IF_MODE_MODE_NONE;
+    nas_bridge_utils_l3_mode_get(br_name, &cur_mode);
+
+    /*  Kernel VLAN devices of bitmap members are removed while the bridge is still in L3 mode */
+    if ((cur_mode == BASE_IF_MODE_MODE_L3) && (mode != BASE_IF_MODE_MODE_L3)) {
+        if (nas_vlan_scale_os_members_update(vlan_id, false) != STD_ERR_OK) {
+            EV_LOGGING(INTERFACE,ERR,"NAS-INT", " Bridge %s kernel VLAN devices delete failed  ", br_name);
+            return false;
+        }
+    }
+
      nas_bridge_utils_l3_mode_set(br_name, mode);
 
     if(mode == BASE_IF_MODE_MODE_L3){
@@ -107,8 +123,6 @@ static bool _nas_bridge_handle_mode_change(const char *br_name, BASE_IF_MODE_t m
             EV_LOGGING(INTERFACE,ERR,"NAS-INT", " Bridge %s tagged member list get failed  ", br_name);
             return false;
         }
-        hal_vlan_id_t vlan_id = 0;
-        nas_bridge_utils_vlan_id_get(br_name, &vlan_id);
 
         /*  create sub interfaces  */
         /*  add all sub interfaces to the bridge in the kernel
@@ -123,6 +137,11 @@ static bool _nas_bridge_handle_mode_change(const char *br_name, BASE_IF_MODE_t m
             EV_LOGGING(INTERFACE,ERR,"NAS-INT", " Bridge %s tagged member list create failed  ", br_name);
             return false;
         }
+        if ((cur_mode != BASE_IF_MODE_MODE_L3) &&
+            (nas_vlan_scale_os_members_update(vlan_id, true) != STD_ERR_OK)) {
+            EV_LOGGING(INTERFACE,ERR,"NAS-INT", " Bridge %s kernel VLAN devices create failed  ", br_name);
+            return false;
+        }
     }
     return true;
 }
@@ -187,8 +206,6 @@ static cps_api_return_code_t nas_vlan_intf_cps_process_get(void * context, cps_a
 
     EV_LOGGING(INTERFACE, DEBUG, "NAS-Vlan", "nas_vlan_intf_cps_get");
 
-    std_mutex_simple_lock_guard _lg(nas_bridge_mtx_lock());
-
     cps_api_return_code_t rc =  cps_api_ret_code_ERR;
     cps_api_object_t filt = cps_api_object_list_get(param->filters,ix);
     cps_api_object_attr_t _name;
@@ -200,29 +217,42 @@ static cps_api_return_code_t nas_vlan_intf_cps_process_get(void * context, cps_a
         _name = cps_api_get_key_data(filt, IF_INTERFACES_INTERFACE_NAME);
     }
 
-    if ((_name == nullptr) && (_vlan_id == nullptr))  {
-        /*  Get all */
-        nas_fill_all_bridge_info(&param->list, INT_VLAN_MODEL, get_state);
-        return cps_api_ret_code_OK;
-    } else {
+    if (((_name == nullptr) && (_vlan_id == nullptr)) ||
+        ((_name != nullptr) && cps_api_filter_is_getnext(filt)))  {
+        /*  Get all, or the next page after the named VLAN. Bridge lock is taken per page */
+        std::string cursor;
+        if (_name != nullptr) {
+            cursor = (const char*)cps_api_object_attr_data_bin(_name);
+        }
+        size_t count = 0;
+        cps_api_filter_get_count(filt, &count);
+        return nas_fill_bridge_info_page(param->list, INT_VLAN_MODEL, cursor, count,
+                                         nas_bridge_get_filter_with_members(filt, INT_VLAN_MODEL), get_state);
+    }
+
+    std_mutex_simple_lock_guard _lg(nas_bridge_mtx_lock());
+    {
         /*  Get based on the bridge name of vlan id  */
-        const char *br_name = NULL;
+        NAS_BRIDGE *br_obj = nullptr;
         if (_name != nullptr) {
-            br_name = (const char*)cps_api_object_attr_data_bin(_name);
+            const char *br_name = (const char*)cps_api_object_attr_data_bin(_name);
+            if (nas_bridge_map_obj_get(br_name, &br_obj) != STD_ERR_OK) {
+                return cps_api_ret_code_ERR;
+            }
         } else if (_vlan_id != nullptr) {
             hal_vlan_id_t vid = cps_api_object_attr_data_u32(_vlan_id);
-            std::string _br_name;
-            if (nas_bridge_vlan_to_bridge_get(vid, _br_name) == false) {
+            if (nas_bridge_map_obj_get_by_vlan(vid, &br_obj) != STD_ERR_OK) {
                 return cps_api_ret_code_ERR;
             }
-            br_name = (const char *)_br_name.c_str();
         }
 
         cps_api_object_t obj = cps_api_object_create();
         cps_api_key_from_attr_with_qual(cps_api_object_key(obj),
             DELL_BASE_IF_CMN_IF_INTERFACES_INTERFACE_OBJ, (get_state) ? cps_api_qualifier_OBSERVED : cps_api_qualifier_TARGET);
 
-        if (nas_bridge_fill_info(br_name, obj) == cps_api_ret_code_OK) {
+        cps_api_return_code_t fill_rc = nas_bridge_get_filter_with_members(filt, INT_VLAN_MODEL) ?
+                                        br_obj->nas_bridge_fill_info(obj) : br_obj->nas_bridge_fill_summary(obj);
+        if (fill_rc == cps_api_ret_code_OK) {
             if (get_state) {
                 cps_convert_to_state_attribute(obj);
             }
@@ -527,6 +557,233 @@ static cps_api_return_code_t nas_cps_delete_vlan(cps_api_object_t obj)
 }
 
 
+/*
+ * Bulk VLAN provisioning, requested as a CPS ACTION on a VLAN interface object.
+ *  - BASE_IF_VLAN_IF_INTERFACES_INTERFACE_ID may be repeated, each instance is either one u32 VLAN id
+ *    or a pair of u32 (first, last) giving an inclusive range
+ *  - tagged ports/LAGs, VLAN type, mode, learning mode and the other interface attributes in the
+ *    request form a template that is applied to every VLAN
+ * VLANs are provisioned in batches: kernel bridges for the whole batch first, then NPU VLANs, then
+ * membership. The bridge lock is released between batches. Per-VLAN results are returned in the
+ * object as embedded entries BASE_IF_VLAN_IF_INTERFACES_INTERFACE_ID/<n>/{vlan-id, name, if-index};
+ * name and if-index are present only for VLANs that were provisioned. Once the VLAN list is
+ * accepted the action returns OK so the results reach the client, even if some VLANs failed.
+ */
+#define NAS_VLAN_BULK_BATCH_SIZE 64
+
+struct nas_vlan_bulk_entry_t {
+    hal_vlan_id_t vlan_id;
+    char name[HAL_IF_NAME_SZ];
+    hal_ifindex_t if_index;
+    bool os_created;
+    bool npu_created;
+    bool done;
+    cps_api_object_t obj;
+
+    nas_vlan_bulk_entry_t(hal_vlan_id_t id) : vlan_id(id), if_index(0), os_created(false),
+                                              npu_created(false), done(false), obj(nullptr) {
+        snprintf(name, sizeof(name), "br%d", id);
+    }
+};
+
+static bool nas_vlan_bulk_get_vlan_list(cps_api_object_t obj, std::vector<hal_vlan_id_t> &vlan_list)
+{
+    std::vector<bool> seen(MAX_VLAN_ID + 1, false);
+    cps_api_object_it_t it;
+    cps_api_object_it_begin(obj, &it);
+    for ( ; cps_api_object_it_attr_walk(&it, BASE_IF_VLAN_IF_INTERFACES_INTERFACE_ID);
+            cps_api_object_it_next(&it)) {
+        uint32_t first, last;
+        size_t len = cps_api_object_attr_len(it.attr);
+        if (len == sizeof(uint32_t)) {
+            first = last = cps_api_object_attr_data_u32(it.attr);
+        } else if (len == 2 * sizeof(uint32_t)) {
+            const uint32_t *range = (const uint32_t *)cps_api_object_attr_data_bin(it.attr);
+            first = range[0];
+            last = range[1];
+        } else {
+            EV_LOGGING(INTERFACE, ERR, "NAS-VLAN-BULK", "Invalid VLAN id attribute length %lu", len);
+            return false;
+        }
+        if ((first < MIN_VLAN_ID) || (last > MAX_VLAN_ID) || (first > last)) {
+            EV_LOGGING(INTERFACE, ERR, "NAS-VLAN-BULK", "Invalid VLAN range %u-%u", first, last);
+            return false;
+        }
+        for (uint32_t vlan_id = first; vlan_id <= last; ++vlan_id) {
+            if (seen[vlan_id]) continue;
+            seen[vlan_id] = true;
+            vlan_list.push_back((hal_vlan_id_t)vlan_id);
+        }
+    }
+    return !vlan_list.empty();
+}
+
+/*  Build the per-VLAN create object from the request template  */
+static bool nas_vlan_bulk_entry_obj_init(nas_vlan_bulk_entry_t &entry, cps_api_object_list_t list,
+                                         cps_api_object_t tmpl, const char *mac)
+{
+    cps_api_object_t obj = cps_api_object_list_create_obj_and_append(list);
+    if (obj == nullptr) return false;
+    if (!cps_api_object_clone(obj, tmpl)) return false;
+    entry.obj = obj;
+    cps_api_set_key_data(obj, IF_INTERFACES_INTERFACE_NAME, cps_api_object_ATTR_T_BIN,
+                         entry.name, strlen(entry.name)+1);
+    cps_api_object_attr_add_u32(obj, BASE_IF_VLAN_IF_INTERFACES_INTERFACE_ID, entry.vlan_id);
+    if ((mac != nullptr) && (cps_api_object_attr_get(obj, DELL_IF_IF_INTERFACES_INTERFACE_PHYS_ADDRESS) == nullptr)) {
+        cps_api_object_attr_add(obj, DELL_IF_IF_INTERFACES_INTERFACE_PHYS_ADDRESS, mac, strlen(mac)+1);
+    }
+    return true;
+}
+
+static void nas_vlan_bulk_entry_undo(nas_vlan_bulk_entry_t &entry)
+{
+    if (entry.npu_created) {
+        nas_bridge_delete_bridge(entry.name);
+        nas_bridge_vlan_to_bridge_map_del(entry.vlan_id);
+        return;
+    }
+    NAS_BRIDGE *br_obj = nullptr;
+    if (nas_bridge_map_obj_remove(entry.name, &br_obj) == STD_ERR_OK) {
+        delete br_obj;
+    }
+    if (entry.os_created) {
+        nas_bridge_utils_os_delete_bridge(entry.name);
+    }
+}
+
+static void nas_vlan_bulk_process_batch(std::vector<nas_vlan_bulk_entry_t> &batch, cps_api_object_t tmpl,
+                                        BASE_IF_VLAN_TYPE_t vlan_type, cps_api_object_attr_t mode_attr)
+{
+    cps_api_object_list_guard obj_list(cps_api_object_list_create());
+    if (obj_list.get() == nullptr) return;
+
+    /*  Assigned MACs for the whole batch are resolved with one lookup  */
+    std::vector<nas_if_mac_req_t> mac_req(batch.size());
+    for (size_t ix = 0; ix < batch.size(); ++ix) {
+        memset(&mac_req[ix], 0, sizeof(mac_req[ix]));
+        mac_req[ix].if_type = IF_INTERFACE_TYPE_IANAIFT_IANA_INTERFACE_TYPE_IANAIFT_L2VLAN;
+        mac_req[ix].if_name = batch[ix].name;
+        mac_req[ix].vlan_id = batch[ix].vlan_id;
+    }
+    nas_if_get_assigned_mac_bulk(&mac_req[0], mac_req.size());
+
+    std_mutex_simple_lock_guard _lg(nas_bridge_mtx_lock());
+
+    /*  Stage 1: kernel bridges  */
+    for (size_t ix = 0; ix < batch.size(); ++ix) {
+        nas_vlan_bulk_entry_t &entry = batch[ix];
+        if (nas_bridge_vlan_in_use(entry.vlan_id) ||
+            (nas_bridge_utils_if_bridge_exists(entry.name) == STD_ERR_OK)) {
+            EV_LOGGING(INTERFACE, ERR, "NAS-VLAN-BULK", "VLAN %d or bridge %s already exists",
+                       entry.vlan_id, entry.name);
+            continue;
+        }
+        const char *mac = (mac_req[ix].rc == STD_ERR_OK) ? mac_req[ix].mac_addr : nullptr;
+        if (!nas_vlan_bulk_entry_obj_init(entry, obj_list.get(), tmpl, mac)) {
+            EV_LOGGING(INTERFACE, ERR, "NAS-VLAN-BULK", "Failed to build create object for VLAN %d",
+                       entry.vlan_id);
+            continue;
+        }
+        if (nas_bridge_utils_os_create_vlan(entry.name, entry.obj, &entry.if_index) != STD_ERR_OK) {
+            continue;
+        }
+        entry.os_created = true;
+    }
+
+    /*  Stage 2: NPU VLANs  */
+    for (auto &entry : batch) {
+        if (!entry.os_created) continue;
+        if (nas_bridge_npu_create_vlan(entry.name, entry.vlan_id, entry.if_index) != STD_ERR_OK) {
+            nas_vlan_bulk_entry_undo(entry);
+            entry.os_created = false;
+            continue;
+        }
+        entry.npu_created = true;
+        std::string bridge_name(entry.name);
+        nas_bridge_vlan_to_bridge_map_add(entry.vlan_id, bridge_name);
+
+        BASE_IF_MODE_t mode = nas_check_reserved_vlan_id(entry.vlan_id) ?
+                                    BASE_IF_MODE_MODE_L3 : BASE_IF_MODE_MODE_L2;
+        if (mode_attr != nullptr) mode = (BASE_IF_MODE_t)cps_api_object_attr_data_u32(mode_attr);
+        nas_bridge_utils_vlan_type_set(entry.name, vlan_type);
+        nas_bridge_utils_l3_mode_set(entry.name, mode);
+    }
+
+    /*  Stage 3: membership and remaining attributes, same path as a single VLAN create  */
+    for (auto &entry : batch) {
+        if (!entry.npu_created) continue;
+        if (nas_cps_update_vlan(entry.name, entry.obj) != cps_api_ret_code_OK) {
+            EV_LOGGING(INTERFACE, ERR, "NAS-VLAN-BULK", "Member configuration failed for VLAN %d",
+                       entry.vlan_id);
+            nas_vlan_bulk_entry_undo(entry);
+            continue;
+        }
+        entry.done = true;
+        _nas_publish_vlan_cps_req_obj(entry.obj);
+    }
+}
+
+static cps_api_return_code_t nas_cps_bulk_provision_vlan(cps_api_object_t obj)
+{
+    std::vector<hal_vlan_id_t> vlan_list;
+    if (!nas_vlan_bulk_get_vlan_list(obj, vlan_list)) {
+        cps_api_set_object_return_attrs(obj, cps_api_ret_code_ERR, "Missing or invalid VLAN id list");
+        return cps_api_ret_code_ERR;
+    }
+
+    /*  Template holds every request attribute except the VLAN id list  */
+    cps_api_object_guard tmpl(cps_api_object_create());
+    if (!tmpl.valid()) return cps_api_ret_code_ERR;
+    cps_api_key_copy(cps_api_object_key(tmpl.get()), cps_api_object_key(obj));
+    cps_api_object_set_type_operation(cps_api_object_key(tmpl.get()), cps_api_oper_CREATE);
+    cps_api_object_it_t it;
+    cps_api_object_it_begin(obj, &it);
+    for ( ; cps_api_object_it_valid(&it); cps_api_object_it_next(&it)) {
+        if (cps_api_object_attr_id(it.attr) == BASE_IF_VLAN_IF_INTERFACES_INTERFACE_ID) continue;
+        cps_api_object_attr_add(tmpl.get(), cps_api_object_attr_id(it.attr),
+                                cps_api_object_attr_data_bin(it.attr), cps_api_object_attr_len(it.attr));
+    }
+
+    BASE_IF_VLAN_TYPE_t vlan_type = BASE_IF_VLAN_TYPE_DATA;
+    cps_api_object_attr_t attr = cps_api_object_attr_get(obj, DELL_IF_IF_INTERFACES_INTERFACE_VLAN_TYPE);
+    if (attr != nullptr) vlan_type = (BASE_IF_VLAN_TYPE_t)cps_api_object_attr_data_u32(attr);
+    cps_api_object_attr_t mode_attr = cps_api_object_attr_get(tmpl.get(), DELL_IF_IF_INTERFACES_INTERFACE_VLAN_MODE);
+
+    EV_LOGGING(INTERFACE, NOTICE, "NAS-VLAN-BULK", "Bulk provisioning of %lu VLANs", vlan_list.size());
+
+    while (cps_api_object_attr_delete(obj, BASE_IF_VLAN_IF_INTERFACES_INTERFACE_ID)) ;
+
+    size_t failed = 0, index = 0;
+    for (size_t start = 0; start < vlan_list.size(); start += NAS_VLAN_BULK_BATCH_SIZE) {
+        size_t end = std::min(start + NAS_VLAN_BULK_BATCH_SIZE, vlan_list.size());
+        std::vector<nas_vlan_bulk_entry_t> batch;
+        batch.reserve(end - start);
+        for (size_t ix = start; ix < end; ++ix) batch.emplace_back(vlan_list[ix]);
+
+        nas_vlan_bulk_process_batch(batch, tmpl.get(), vlan_type, mode_attr);
+
+        for (auto &entry : batch) {
+            cps_api_attr_id_t ids[3] = {BASE_IF_VLAN_IF_INTERFACES_INTERFACE_ID, index++,
+                                        BASE_IF_VLAN_IF_INTERFACES_INTERFACE_ID};
+            const size_t ids_len = sizeof(ids)/sizeof(ids[0]);
+            uint32_t vlan_id = entry.vlan_id;
+            cps_api_object_e_add(obj, ids, ids_len, cps_api_object_ATTR_T_U32, &vlan_id, sizeof(vlan_id));
+            if (!entry.done) {
+                ++failed;
+                continue;
+            }
+            ids[2] = IF_INTERFACES_INTERFACE_NAME;
+            cps_api_object_e_add(obj, ids, ids_len, cps_api_object_ATTR_T_BIN, entry.name, strlen(entry.name)+1);
+            ids[2] = DELL_BASE_IF_CMN_IF_INTERFACES_INTERFACE_IF_INDEX;
+            cps_api_object_e_add(obj, ids, ids_len, cps_api_object_ATTR_T_U32, &entry.if_index, sizeof(entry.if_index));
+        }
+    }
+
+    EV_LOGGING(INTERFACE, NOTICE, "NAS-VLAN-BULK", "Bulk provisioning done, %lu of %lu VLANs failed",
+               failed, vlan_list.size());
+    return cps_api_ret_code_OK;
+}
+
 static cps_api_return_code_t nas_vlan_intf_cps_set(void *context, cps_api_transaction_params_t *param, size_t ix)
 {
 
@@ -536,6 +793,9 @@ static cps_api_return_code_t nas_vlan_intf_cps_set(void *context, cps_api_transa
     EV_LOGGING(INTERFACE, DEBUG, "NAS-Vlan",
            "nas_process_cps_vlan_set");
 
+    /*  Bulk provisioning creates its own per-VLAN objects, no need to keep the request  */
+    if (op == cps_api_oper_ACTION)      return(nas_cps_bulk_provision_vlan(obj));
+
     cps_api_object_t cloned = cps_api_object_list_create_obj_and_append(param->prev);
     if (cloned == NULL) return cps_api_ret_code_ERR;
 
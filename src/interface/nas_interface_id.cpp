@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+
+/*
+ * filename: nas_interface_id.cpp
+ */
+
+#include "interface/nas_interface_id.h"
+#include "event_log.h"
+#include "event_log_types.h"
+#include "std_mutex_lock.h"
+#include "std_utils.h"
+
+#include <deque>
+#include <unordered_map>
+#include <algorithm>
+#include <string.h>
+
+typedef struct {
+    std::string    if_name;
+    bool           resolved;
+    uint32_t       gen;        /* bumped on every invalidation */
+    hal_ifindex_t  if_index;
+    nas_int_type_t int_type;
+    npu_id_t       npu_id;
+    npu_port_t     port_id;
+    ndi_obj_id_t   lag_id;
+} nas_intf_id_entry_t;
+
+/* Entries are only appended so references to the names stay valid */
+static std::deque<nas_intf_id_entry_t> _intf_id_entries;
+static std::unordered_map<std::string, nas_intf_id_t> _intf_id_map;
+static std_mutex_lock_create_static_init_fast(_intf_id_lock);
+
+static const std::string _intf_id_no_name;
+
+nas_intf_id_t nas_intf_id_intern(const std::string &if_name)
+{
+    std_mutex_simple_lock_guard lg(&_intf_id_lock);
+    auto it = _intf_id_map.find(if_name);
+    if (it != _intf_id_map.end()) {
+        return it->second;
+    }
+    nas_intf_id_t id = (nas_intf_id_t)_intf_id_entries.size();
+    nas_intf_id_entry_t entry;
+    entry.if_name = if_name;
+    entry.resolved = false;
+    entry.gen = 0;
+    entry.if_index = 0;
+    entry.int_type = nas_int_type_PORT;
+    entry.npu_id = 0;
+    entry.port_id = 0;
+    entry.lag_id = 0;
+    _intf_id_entries.push_back(entry);
+    _intf_id_map[if_name] = id;
+    return id;
+}
+
+nas_intf_id_t nas_intf_id_lookup(const std::string &if_name)
+{
+    std_mutex_simple_lock_guard lg(&_intf_id_lock);
+    auto it = _intf_id_map.find(if_name);
+    if (it == _intf_id_map.end()) {
+        return NAS_INTF_ID_INVALID;
+    }
+    return it->second;
+}
+
+const std::string & nas_intf_id_name(nas_intf_id_t id)
+{
+    std_mutex_simple_lock_guard lg(&_intf_id_lock);
+    if (id >= _intf_id_entries.size()) {
+        return _intf_id_no_name;
+    }
+    return _intf_id_entries[id].if_name;
+}
+
+static void _intf_id_fill_ctrl(const nas_intf_id_entry_t &entry, interface_ctrl_t *intf_ctrl)
+{
+    safestrncpy(intf_ctrl->if_name, entry.if_name.c_str(), sizeof(intf_ctrl->if_name));
+    intf_ctrl->if_index = entry.if_index;
+    intf_ctrl->int_type = entry.int_type;
+    intf_ctrl->npu_id = entry.npu_id;
+    intf_ctrl->port_id = entry.port_id;
+    intf_ctrl->lag_id = entry.lag_id;
+}
+
+t_std_error nas_intf_id_resolve(nas_intf_id_t id, interface_ctrl_t *intf_ctrl)
+{
+    std::string if_name;
+    uint32_t gen;
+    {
+        std_mutex_simple_lock_guard lg(&_intf_id_lock);
+        if (id >= _intf_id_entries.size()) {
+            return STD_ERR(INTERFACE, PARAM, 0);
+        }
+        nas_intf_id_entry_t &entry = _intf_id_entries[id];
+        if (entry.resolved) {
+            _intf_id_fill_ctrl(entry, intf_ctrl);
+            return STD_ERR_OK;
+        }
+        if_name = entry.if_name;
+        gen = entry.gen;
+    }
+
+    /* Not resolved yet, query the interface control block outside the lock */
+    interface_ctrl_t details;
+    memset(&details, 0, sizeof(details));
+    details.q_type = HAL_INTF_INFO_FROM_IF_NAME;
+    safestrncpy(details.if_name, if_name.c_str(), sizeof(details.if_name));
+    t_std_error rc = dn_hal_get_interface_info(&details);
+    if (rc != STD_ERR_OK) {
+        EV_LOGGING(INTERFACE, DEBUG, "NAS-INTF-ID", "Failed to resolve interface %s", if_name.c_str());
+        return rc;
+    }
+
+    std_mutex_simple_lock_guard lg(&_intf_id_lock);
+    nas_intf_id_entry_t &entry = _intf_id_entries[id];
+    nas_intf_id_entry_t result = entry;
+    result.if_index = details.if_index;
+    result.int_type = details.int_type;
+    result.npu_id = details.npu_id;
+    result.port_id = details.port_id;
+    result.lag_id = details.lag_id;
+    result.resolved = true;
+    /* Do not cache if the interface was removed or recreated while querying */
+    if (entry.gen == gen) {
+        entry = result;
+    }
+    _intf_id_fill_ctrl(result, intf_ctrl);
+    return STD_ERR_OK;
+}
+
+t_std_error nas_intf_id_resolve(const std::string &if_name, interface_ctrl_t *intf_ctrl)
+{
+    return nas_intf_id_resolve(nas_intf_id_intern(if_name), intf_ctrl);
+}
+
+void nas_intf_id_invalidate(const std::string &if_name)
+{
+    std_mutex_simple_lock_guard lg(&_intf_id_lock);
+    auto it = _intf_id_map.find(if_name);
+    if (it != _intf_id_map.end()) {
+        _intf_id_entries[it->second].resolved = false;
+        _intf_id_entries[it->second].gen++;
+    }
+}
+
+nas_intf_id_set::const_iterator nas_intf_id_set::find(nas_intf_id_t id) const
+{
+    auto it = std::lower_bound(ids.begin(), ids.end(), id);
+    if ((it == ids.end()) || (*it != id)) {
+        return end();
+    }
+    return const_iterator(it);
+}
+
+bool nas_intf_id_set::insert(nas_intf_id_t id)
+{
+    if (id == NAS_INTF_ID_INVALID) {
+        return false;
+    }
+    auto it = std::lower_bound(ids.begin(), ids.end(), id);
+    if ((it != ids.end()) && (*it == id)) {
+        return false;
+    }
+    ids.insert(it, id);
+    return true;
+}
+
+size_t nas_intf_id_set::erase(const std::string &if_name)
+{
+    nas_intf_id_t id = nas_intf_id_lookup(if_name);
+    auto it = std::lower_bound(ids.begin(), ids.end(), id);
+    if ((it == ids.end()) || (*it != id)) {
+        return 0;
+    }
+    ids.erase(it);
+    return 1;
+}
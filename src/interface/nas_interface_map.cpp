@@ -20,6 +20,7 @@
 
 #include <unordered_map>
 #include "interface/nas_interface_map.h"
+#include "interface/nas_interface_id.h"
 
 // TODO define map based on the interface type
 using nas_intf_obj_map_t = std::unordered_map <std::string, class NAS_INTERFACE *>;
@@ -41,6 +42,7 @@ t_std_error nas_interface_map_obj_add(const std::string &intf_name, class NAS_IN
         return STD_ERR(INTERFACE, FAIL, 0);
     }
     intf_obj_map[intf_name] = intf_obj;
+    nas_intf_id_invalidate(intf_name);
     return STD_ERR_OK;
 }
 
@@ -53,5 +55,6 @@ t_std_error nas_interface_map_obj_remove(std::string &intf_name, class NAS_INTER
     }
     *intf_obj = it->second;
     intf_obj_map.erase(intf_name);
+    nas_intf_id_invalidate(intf_name);
     return STD_ERR_OK;
 }
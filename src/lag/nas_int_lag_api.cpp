@@ -24,6 +24,7 @@
 #include "hal_if_mapping.h"
 #include "nas_if_utils.h"
 #include "nas_int_lag_api.h"
+#include "interface/nas_interface_id.h"
 #include "std_mutex_lock.h"
 #include "event_log.h"
 #include "std_utils.h"
@@ -322,6 +323,8 @@ t_std_error nas_register_lag_intf(nas_lag_master_info_t *nas_lag_entry, hal_intf
                    nas_lag_entry->ifindex, nas_lag_entry->lag_id);
         return STD_ERR(INTERFACE,FAIL,0);
     }
+    /* LAG created or removed, cached NDI LAG id of the name is no longer valid */
+    nas_intf_id_invalidate(std::string(nas_lag_entry->name));
 
     return STD_ERR_OK;
 }
@@ -46,6 +46,7 @@
 #include "interface/nas_interface.h"
 #include "interface/nas_interface_map.h"
 #include "interface/nas_interface_utils.h"
+#include "bridge/nas_interface_vlan_scale.h"
 #include "std_rw_lock.h"
 
 #include <stdio.h>
@@ -268,6 +269,7 @@ static cps_api_return_code_t nas_cps_delete_lag(cps_api_object_t obj)
       if(nas_interface_map_obj_remove(intf_name,&l_obj) ==STD_ERR_OK){
           if(l_obj) delete l_obj;
       }
+      nas_vlan_scale_member_clear(intf_name);
 
 
     for (auto it : nas_lag_entry->port_list) {
@@ -29,8 +29,11 @@
 #include "cps_class_map.h"
 
 #include <exception>
+#include <atomic>
 
 static std::unique_ptr<nas_intf_container> if_cont_inst (new nas_intf_container);
+/* Bumped after every master add or delete */
+static std::atomic<uint64_t> if_master_gen(0);
 
 //Interface common APIs
 
@@ -42,6 +45,7 @@ bool nas_intf_add_master(hal_ifindex_t ifx, if_master_info_t m_info)
         EV_LOGGING(INTERFACE,ERR,"IF_CONT", "%s", e.what());
         return false;
     }
+    ++if_master_gen;
 
     return true;
 }
@@ -54,17 +58,27 @@ bool nas_intf_add_master(hal_ifindex_t ifx, if_master_info_t m_info, BASE_IF_MOD
         EV_LOGGING(INTERFACE,ERR,"IF_CONT", "%s", e.what());
         return false;
     }
+    ++if_master_gen;
 
     return true;
 }
 bool nas_intf_del_master(hal_ifindex_t ifx, if_master_info_t m_info)
 {
-    return if_cont_inst->nas_intf_del_master(ifx, m_info);
+    bool rc = if_cont_inst->nas_intf_del_master(ifx, m_info);
+    ++if_master_gen;
+    return rc;
 }
 
 bool nas_intf_del_master(hal_ifindex_t ifx, if_master_info_t m_info, BASE_IF_MODE_t *new_mode, bool *mode_change)
 {
-    return if_cont_inst->nas_intf_del_master(ifx, m_info, new_mode, mode_change);
+    bool rc = if_cont_inst->nas_intf_del_master(ifx, m_info, new_mode, mode_change);
+    ++if_master_gen;
+    return rc;
+}
+
+uint64_t nas_intf_master_gen(void)
+{
+    return if_master_gen.load();
 }
 
 
@@ -83,6 +97,11 @@ void nas_intf_master_callback(hal_ifindex_t ifx, std::function< void (if_master_
     if_cont_inst->nas_intf_master_callbk(ifx, fn);
 }
 
+bool nas_intf_master_find(hal_ifindex_t ifx, std::function< bool (const if_master_info_t &)> fn)
+{
+    return if_cont_inst->nas_intf_master_find(ifx, fn);
+}
+
 std::pair<int,int> nas_intf_untag_tag_count(hal_ifindex_t ifx)
 {
      return if_cont_inst->nas_intf_get_untag_tag_cnt(ifx);
@@ -201,7 +220,7 @@ bool nas_intf_container::nas_intf_del_master(hal_ifindex_t ifx, if_master_info_t
     return rc;
 }
 
-void nas_intf_container::nas_intf_master_callbk(hal_ifindex_t ifx, master_fn_type fn) {
+void nas_intf_container::nas_intf_master_callbk(hal_ifindex_t ifx, const master_fn_type &fn) {
 
     std_rw_lock_read_guard lg(&rw_lock);
 
@@ -215,6 +234,19 @@ void nas_intf_container::nas_intf_master_callbk(hal_ifindex_t ifx, master_fn_typ
     ptr->nas_intf_obj_for_each_master(fn);
 }
 
+bool nas_intf_container::nas_intf_master_find(hal_ifindex_t ifx, const master_find_fn_type &fn) {
+
+    std_rw_lock_read_guard lg(&rw_lock);
+
+    auto itr = if_objects.find(ifx);
+
+    if(itr == if_objects.end()) {
+        return false;
+    }
+
+    return itr->second->nas_intf_obj_find_master(fn);
+}
+
 std::pair<int,int> nas_intf_container::nas_intf_get_untag_tag_cnt(hal_ifindex_t ifx) {
     std_rw_lock_read_guard lg(&rw_lock);
 
@@ -293,58 +325,104 @@ void nas_intf_container::nas_intf_dump_container(hal_ifindex_t ifx) noexcept {
 
 //Interface object class definitions
 
-bool nas_intf_obj::nas_intf_obj_master_add(if_master_info_t m_info) {
+size_t nas_intf_obj::nas_intf_obj_master_pos(hal_ifindex_t m_if_idx) const {
 
-    for(auto itr = m_list.begin(); itr != m_list.end(); ++itr) {
-        if(itr->m_if_idx == m_info.m_if_idx) {
-            return false;
+    if(!m_index.empty()) {
+        auto itr = m_index.find(m_if_idx);
+        return (itr == m_index.end()) ? m_list.size() : itr->second;
+    }
+    for(size_t ix = 0; ix < m_list.size(); ++ix) {
+        if(m_list[ix].m_if_idx == m_if_idx) {
+            return ix;
         }
     }
+    return m_list.size();
+}
+
+void nas_intf_obj::nas_intf_obj_index_rebuild(void) {
+
+    m_index.clear();
+    if(m_list.size() < NAS_INTF_MASTER_INDEX_MIN) {
+        return;
+    }
+    m_index.reserve(m_list.size());
+    for(size_t ix = 0; ix < m_list.size(); ++ix) {
+        m_index[m_list[ix].m_if_idx] = ix;
+    }
+}
+
+void nas_intf_obj::nas_intf_obj_count_update(const if_master_info_t &m_info, int delta) {
+
+    if (m_info.type != nas_int_type_VLAN) {
+        return;
+    }
+    if (m_info.mode == NAS_PORT_UNTAGGED || m_info.mode == NAS_PORT_HYBRID) {
+        untagged_cnt += delta;
+    }
+    if (m_info.mode == NAS_PORT_TAGGED || m_info.mode == NAS_PORT_HYBRID) {
+        tagged_cnt += delta;
+    }
+    EV_LOGGING(INTERFACE,DEBUG,"IF_CONT", "Master %d %s untag_cnt %d tag_cnt %d", m_info.m_if_idx,
+               (delta > 0) ? "added" : "deleted", untagged_cnt, tagged_cnt);
+}
+
+bool nas_intf_obj::nas_intf_obj_master_add(if_master_info_t m_info) {
+
+    if(nas_intf_obj_master_pos(m_info.m_if_idx) != m_list.size()) {
+        return false;
+    }
 
     //If LAG master, insert at front
     if(m_info.type == nas_int_type_LAG){
-        m_list.push_front(m_info);
+        m_list.insert(m_list.begin(), m_info);
+        if(!m_index.empty()) nas_intf_obj_index_rebuild();
     }else{
         m_list.push_back(m_info);
-    }
-    if (m_info.type == nas_int_type_VLAN) {
-        if (m_info.mode == NAS_PORT_UNTAGGED) {
-            untagged_cnt ++;
-            EV_LOGGING(INTERFACE,DEBUG,"IF_CONT", "nas_intf_obj_master_add master %d untag_cnt %d", m_info.m_if_idx, untagged_cnt);
-        }
-        if (m_info.mode == NAS_PORT_TAGGED) {
-            tagged_cnt ++;
-            EV_LOGGING(INTERFACE,DEBUG,"IF_CONT", "nas_intf_obj_master_add master %d tag_cnt %d", m_info.m_if_idx, tagged_cnt);
+        if(!m_index.empty()) {
+            m_index[m_info.m_if_idx] = m_list.size() - 1;
+        } else if(m_list.size() >= NAS_INTF_MASTER_INDEX_MIN) {
+            nas_intf_obj_index_rebuild();
         }
     }
+    nas_intf_obj_count_update(m_info, 1);
 
     return true;
 }
 
 bool nas_intf_obj::nas_intf_obj_master_delete(if_master_info_t m_info) {
 
-    for(auto itr = m_list.begin(); itr != m_list.end(); ++itr) {
-        if(itr->m_if_idx == m_info.m_if_idx) {
-            if (m_info.type == nas_int_type_VLAN) {
-                if (m_info.mode == NAS_PORT_UNTAGGED || m_info.mode == NAS_PORT_HYBRID) {
-                    untagged_cnt --;
-                }
-                if (m_info.mode == NAS_PORT_TAGGED || m_info.mode == NAS_PORT_HYBRID) {
-                    tagged_cnt --;
-                }
-            }
-        itr = m_list.erase(itr);
+    size_t pos = nas_intf_obj_master_pos(m_info.m_if_idx);
+    //No master found
+    if(pos == m_list.size()) {
+        return false;
+    }
+
+    nas_intf_obj_count_update(m_list[pos], -1);
+
+    if(m_list[pos].type == nas_int_type_LAG) {
+        //Keep the LAG masters in front
+        m_list.erase(m_list.begin() + pos);
+        if(!m_index.empty()) nas_intf_obj_index_rebuild();
         return true;
+    }
+
+    size_t last = m_list.size() - 1;
+    if(pos != last) {
+        m_list[pos] = m_list[last];
+        if(!m_index.empty()) m_index[m_list[pos].m_if_idx] = pos;
+    }
+    m_list.pop_back();
+    if(!m_index.empty()) {
+        m_index.erase(m_info.m_if_idx);
+        if(m_list.size() < NAS_INTF_MASTER_INDEX_MIN / 2) {
+            m_index.clear();
+            m_list.shrink_to_fit();
         }
     }
-    //No master found
-    return false;
+    return true;
 }
 
 
-std::pair<int, int> nas_intf_obj::nas_intf_obj_untag_tag_cnt(void) {
-    std::pair<int,int> val;
-    val.first = untagged_cnt;
-    val.second = tagged_cnt;
-    return val;
+std::pair<int, int> nas_intf_obj::nas_intf_obj_untag_tag_cnt(void) const {
+    return std::make_pair(untagged_cnt, tagged_cnt);
 }
@@ -0,0 +1,241 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+
+
+/*
+ * filename: nas_int_ev_dispatch.cpp
+ * Sharded dispatch of OS interface events to worker threads.
+ */
+
+#include "nas_int_ev_dispatch.h"
+#include "event_log.h"
+#include "event_log_types.h"
+
+#include <deque>
+#include <unordered_map>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <algorithm>
+#include <chrono>
+#include <exception>
+
+typedef struct {
+    cps_api_object_t         obj;
+    nas_int_ev_dispatch_fn_t fn;
+    nas_int_ev_batch_fn_t    batch_fn;
+    uint32_t                 key;
+    uint64_t                 merge_id;
+    /* shard and number of its events that have to be done before this one runs */
+    std::vector<std::pair<size_t, uint64_t>> waits;
+} nas_int_ev_entry_t;
+
+typedef struct {
+    std::deque<nas_int_ev_entry_t> queue;
+    uint64_t queued;
+    uint64_t popped;
+    uint64_t done;
+    uint64_t merged;
+    /* sequence number of the last event queued for a key, the first event is 1 */
+    std::unordered_map<uint32_t, uint64_t> last_seq;
+} nas_int_ev_shard_t;
+
+/*
+ * One lock covers all shards: it is only held to queue and dequeue, the handlers
+ * run without it. Handlers take the locks of the objects they change.
+ * Never freed since the detached workers wait on them until the process exits.
+ */
+static auto &_ev_mtx = *new std::mutex;
+static auto &_ev_cv = *new std::condition_variable;
+static auto &_ev_shards = *new std::vector<nas_int_ev_shard_t>;
+
+static bool nas_int_ev_entry_ready(const nas_int_ev_entry_t &entry)
+{
+    for (auto &w : entry.waits) {
+        if (_ev_shards[w.first].done < w.second) return false;
+    }
+    return true;
+}
+
+/* Number of events at the head of the shard queue that run together, called with the lock held */
+static size_t nas_int_ev_batch_len(const nas_int_ev_shard_t &shard)
+{
+    const nas_int_ev_entry_t &first = shard.queue.front();
+    size_t len = 1;
+    if (first.batch_fn == nullptr) return len;
+
+    while ((len < shard.queue.size()) && (len < NAS_INT_EV_BATCH_MAX)) {
+        const nas_int_ev_entry_t &entry = shard.queue[len];
+        if ((entry.key != first.key) || (entry.batch_fn != first.batch_fn) ||
+            !nas_int_ev_entry_ready(entry)) {
+            break;
+        }
+        ++len;
+    }
+    return len;
+}
+
+static void nas_int_ev_worker(size_t shard_id)
+{
+    nas_int_ev_shard_t &shard = _ev_shards[shard_id];
+    std::vector<nas_int_ev_entry_t> entries;
+    std::vector<cps_api_object_t> objs;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lk(_ev_mtx);
+            _ev_cv.wait(lk, [&shard]() {
+                return !shard.queue.empty() && nas_int_ev_entry_ready(shard.queue.front());
+            });
+
+            size_t len = nas_int_ev_batch_len(shard);
+            if (shard.queue.front().batch_fn != nullptr) {
+                /* Keep the run open while nothing else is queued behind it */
+                auto until = std::chrono::steady_clock::now() +
+                             std::chrono::milliseconds(NAS_INT_EV_BATCH_WINDOW_MS);
+                while ((len == shard.queue.size()) && (len < NAS_INT_EV_BATCH_MAX) &&
+                       (_ev_cv.wait_until(lk, until) != std::cv_status::timeout)) {
+                    len = nas_int_ev_batch_len(shard);
+                }
+                len = nas_int_ev_batch_len(shard);
+            }
+            for (size_t ix = 0; ix < len; ++ix) {
+                entries.push_back(std::move(shard.queue.front()));
+                shard.queue.pop_front();
+            }
+            shard.popped += len;
+        }
+
+        if (entries.front().batch_fn != nullptr) {
+            for (auto &entry : entries) objs.push_back(entry.obj);
+            entries.front().batch_fn(objs);
+            objs.clear();
+        } else {
+            entries.front().fn(entries.front().obj);
+        }
+        for (auto &entry : entries) cps_api_object_delete(entry.obj);
+
+        {
+            std::lock_guard<std::mutex> lk(_ev_mtx);
+            shard.done += entries.size();
+        }
+        entries.clear();
+        _ev_cv.notify_all();
+    }
+}
+
+t_std_error nas_int_ev_dispatch_init(size_t workers)
+{
+    if (workers == 0) {
+        workers = std::min<size_t>(std::max<unsigned>(std::thread::hardware_concurrency(), 1),
+                                   NAS_INT_EV_DISPATCH_DEF_WORKERS);
+    }
+
+    std::lock_guard<std::mutex> lk(_ev_mtx);
+    if (!_ev_shards.empty()) return STD_ERR_OK;
+
+    /* Shards are sized before any worker starts so references to them stay valid */
+    _ev_shards.resize(workers);
+    for (auto &shard : _ev_shards) {
+        shard.queued = shard.popped = shard.done = shard.merged = 0;
+    }
+    try {
+        for (size_t ix = 0; ix < workers; ++ix) {
+            std::thread(nas_int_ev_worker, ix).detach();
+        }
+    } catch (std::exception &e) {
+        EV_LOGGING(INTERFACE, ERR, "INTF-EV", "Failed to start OS event workers: %s", e.what());
+        return STD_ERR(INTERFACE, FAIL, 0);
+    }
+    EV_LOGGING(INTERFACE, NOTICE, "INTF-EV", "OS events dispatched to %lu workers", workers);
+    return STD_ERR_OK;
+}
+
+static size_t nas_int_ev_shard_id(const nas_int_ev_order_t &order, size_t n_shards)
+{
+    return (order.shared ? NAS_INT_EV_SHARED_KEY : order.key) % n_shards;
+}
+
+/* Merge obj into the queued event it updates, called with the lock held */
+static bool nas_int_ev_merge(nas_int_ev_shard_t &shard, const nas_int_ev_order_t &order,
+                             cps_api_object_t obj)
+{
+    if (order.merge_id == 0) return false;
+    auto it = shard.last_seq.find(order.key);
+    if ((it == shard.last_seq.end()) || (it->second <= shard.popped)) return false;
+
+    nas_int_ev_entry_t &last = shard.queue[it->second - shard.popped - 1];
+    if (last.merge_id != order.merge_id) return false;
+    if (!cps_api_object_attr_merge(last.obj, obj, true)) return false;
+
+    ++shard.merged;
+    EV_LOGGING(INTERFACE, DEBUG, "INTF-EV", "OS event for key %u merged, %lu merged so far",
+               order.key, shard.merged);
+    return true;
+}
+
+void nas_int_ev_dispatch(const nas_int_ev_order_t &order, cps_api_object_t obj,
+                         nas_int_ev_dispatch_fn_t fn)
+{
+    size_t n_shards = _ev_shards.size();
+    if ((n_shards != 0) && (order.merge_id != 0)) {
+        std::lock_guard<std::mutex> lk(_ev_mtx);
+        if (nas_int_ev_merge(_ev_shards[nas_int_ev_shard_id(order, n_shards)], order, obj)) return;
+    }
+
+    cps_api_object_t clone = nullptr;
+    if (n_shards != 0) {
+        clone = cps_api_object_create();
+        if ((clone != nullptr) && !cps_api_object_clone(clone, obj)) {
+            cps_api_object_delete(clone);
+            clone = nullptr;
+        }
+    }
+    if (clone == nullptr) {
+        fn(obj);
+        return;
+    }
+
+    nas_int_ev_entry_t entry;
+    entry.obj = clone;
+    entry.fn = fn;
+    entry.batch_fn = order.batch_fn;
+    entry.key = order.key;
+    entry.merge_id = order.merge_id;
+
+    size_t shard_id = nas_int_ev_shard_id(order, n_shards);
+    {
+        std::lock_guard<std::mutex> lk(_ev_mtx);
+        auto add_wait = [&](size_t dep_shard) {
+            if ((dep_shard == shard_id) || (_ev_shards[dep_shard].done >= _ev_shards[dep_shard].queued)) {
+                return;
+            }
+            for (auto &w : entry.waits) {
+                if (w.first == dep_shard) return;
+            }
+            entry.waits.push_back(std::make_pair(dep_shard, _ev_shards[dep_shard].queued));
+        };
+        if (order.dep_all) {
+            for (size_t ix = 0; ix < n_shards; ++ix) add_wait(ix);
+        } else {
+            for (auto dep : order.deps) add_wait(dep % n_shards);
+        }
+        nas_int_ev_shard_t &shard = _ev_shards[shard_id];
+        shard.queue.push_back(std::move(entry));
+        shard.last_seq[order.key] = ++shard.queued;
+    }
+    _ev_cv.notify_all();
+}
@@ -60,8 +60,11 @@
 #include "interface/nas_interface_cps.h"
 #include "interface/nas_interface_utils.h"
 #include "interface/nas_interface_mgmt_cps.h"
+#include "nas_int_ev_dispatch.h"
+#include "std_utils.h"
 
 #include <unordered_map>
+#include <algorithm>
 #include <string.h>
 
 
@@ -256,6 +259,15 @@ static void nas_l2_port_ev_handler(cps_api_object_t obj) {
         EV_LOGGING(INTERFACE,ERR, "NAS-BRIDGE", " NAS OS L2 PORT Event: Failed to get member type %s ", mem_name);
         return;
     }
+    /*
+     * Kernel sub interfaces of scaled L3 VLANs are added and removed by NAS along with the
+     * VLAN bitmaps, so their events are only echoes and must not reach the NPU again
+     */
+    if ((mem_type == nas_int_type_VLANSUB_INTF) && nas_bridge_utils_vlan_scale_managed(br_name)) {
+        EV_LOGGING(INTERFACE,DEBUG,"NAS-INT", " Ignore the OS event for member %s of scaled VLAN %s ",
+                         mem_name, br_name);
+        return;
+    }
     /*  Handle member addition */
     bool present = false;
     if (op == cps_api_oper_CREATE) {
@@ -377,216 +389,284 @@ static void nas_lag_ev_set_handler(hal_ifindex_t bond_idx, cps_api_object_t obj,
     }
 }
 
-void nas_lag_ev_handler(cps_api_object_t obj) {
-
+/*
+ * Creates the LAG of a bond create event if it is not present yet.
+ * Called with the LAG lock held.
+ */
+static nas_lag_master_info_t *nas_lag_ev_lag_create(hal_ifindex_t bond_idx, const char *bond_name,
+                                                    bool *create)
+{
     nas_lag_id_t lag_id = 0; // @TODO for now lag_id=0
-    hal_ifindex_t mem_idx;
-    bool create = false;
-    bool block_status = true;
-    const char *mem_name = NULL;
-    nas_lag_master_info_t *nas_lag_entry=NULL;
-    cps_api_operation_types_t member_op = cps_api_oper_NULL;
-
-    cps_api_object_attr_t _idx_attr = cps_api_object_attr_get(obj,
-                                        DELL_BASE_IF_CMN_IF_INTERFACES_INTERFACE_IF_INDEX);
-    cps_api_object_attr_t _mem_attr = cps_api_object_attr_get(obj,
-                                     DELL_IF_IF_INTERFACES_INTERFACE_MEMBER_PORTS_NAME);
-    cps_api_object_attr_t _name_attr = cps_api_object_attr_get(obj, IF_INTERFACES_INTERFACE_NAME);
-    cps_api_operation_types_t op = cps_api_object_type_operation(cps_api_object_key(obj));
+    nas_lag_master_info_t *nas_lag_entry = nas_get_lag_node(bond_idx);
+    if (nas_lag_entry != NULL) {
+        return nas_lag_entry;
+    }
+    /*  Create the lag  */
+    EV_LOGGING(INTERFACE,INFO,"NAS-LAG","Create Lag interface idx %d with lag ID %d ", bond_idx,lag_id);
 
-    if (_idx_attr == nullptr) {
-        EV_LOGGING(INTERFACE,ERR, "NAS-LAG", " LAG IF_index not present in the OS EVENT");
-        return;
+    if ((nas_lag_master_add(bond_idx,bond_name,lag_id)) != STD_ERR_OK) {
+            EV_LOGGING(INTERFACE,ERR, "NAS-LAG",
+                    "LAG creation Failed for bond interface %s index %d",bond_name, bond_idx);
+            return NULL;
     }
-    hal_ifindex_t bond_idx = cps_api_object_attr_data_u32(_idx_attr);
-    if (_mem_attr != nullptr) {
-        mem_name =  (const char*)cps_api_object_attr_data_bin(_mem_attr);
+    if (nas_intf_handle_intf_mode_change(bond_idx, BASE_IF_MODE_MODE_NONE) == false) {
+        EV_LOGGING(INTERFACE, DEBUG, "NAS-LAG",
+                "Update to NAS-L3 about interface mode change failed(%d)", bond_idx);
+    }
+    /* Now get the lag node entry */
+    nas_lag_entry = nas_get_lag_node(bond_idx);
+    if(nas_lag_entry != NULL){
+        nas_cps_handle_mac_set (bond_name, nas_lag_entry->ifindex);
+        *create = true;
+    }
+    /* TODO Add function to set intf description on netlink message */
+    return nas_lag_entry;
+}
+
+typedef struct {
+    hal_ifindex_t  mem_idx;
+    const char     *mem_name;
+    bool           add;
+    bool           skip;
+    BASE_IF_MODE_t mode; /* mode of the port before the member events */
+} nas_lag_ev_member_t;
+
+/*
+ * Handles a run of slave port add/delete events of one bond. The events are reduced to
+ * the net change per port, the port modes are evaluated once for the whole change and
+ * the NPU LAG is updated and published once.
+ */
+static void nas_lag_ev_member_batch_handler(const std::vector<cps_api_object_t> &objs)
+{
+    hal_ifindex_t bond_idx = 0;
+    const char *bond_name = NULL;
+    cps_api_object_t create_obj = nullptr;
+    std::vector<nas_lag_ev_member_t> members;
+
+    for (auto obj : objs) {
+        cps_api_object_attr_t _idx_attr = cps_api_object_attr_get(obj,
+                                            DELL_BASE_IF_CMN_IF_INTERFACES_INTERFACE_IF_INDEX);
+        cps_api_object_attr_t _mem_attr = cps_api_object_attr_get(obj,
+                                         DELL_IF_IF_INTERFACES_INTERFACE_MEMBER_PORTS_NAME);
+        cps_api_object_attr_t _name_attr = cps_api_object_attr_get(obj, IF_INTERFACES_INTERFACE_NAME);
+        cps_api_operation_types_t op = cps_api_object_type_operation(cps_api_object_key(obj));
+
+        if (_idx_attr == nullptr) {
+            EV_LOGGING(INTERFACE,ERR, "NAS-LAG", " LAG IF_index not present in the OS EVENT");
+            continue;
+        }
+        bond_idx = cps_api_object_attr_data_u32(_idx_attr);
+        if (op == cps_api_oper_CREATE) {
+            create_obj = obj;
+            if (_name_attr != nullptr) {
+                bond_name = (const char*)cps_api_object_attr_data_bin(_name_attr);
+            }
+        }
+        if (_mem_attr == nullptr) {
+            continue;
+        }
+
+        hal_ifindex_t mem_idx;
+        const char *mem_name = (const char*)cps_api_object_attr_data_bin(_mem_attr);
         if (nas_int_name_to_if_index(&mem_idx, mem_name) != STD_ERR_OK) {
             EV_LOGGING(INTERFACE,ERR, "NAS-LAG",
                     " Failed for get member %s if_index ", mem_name);
-            return;
+            continue;
+        }
+        auto it = std::find_if(members.begin(), members.end(),
+                               [mem_idx](const nas_lag_ev_member_t &m) { return m.mem_idx == mem_idx; });
+        if (it != members.end()) {
+            it->add = (op == cps_api_oper_CREATE);
+            continue;
         }
+        members.push_back({mem_idx, mem_name, (op == cps_api_oper_CREATE), false,
+                           nas_intf_get_mode(mem_idx)});
+    }
 
-        if_master_info_t master_info = { nas_int_type_LAG, NAS_PORT_NONE, bond_idx};
-        BASE_IF_MODE_t intf_mode = nas_intf_get_mode(mem_idx);
-        if (op == cps_api_oper_CREATE) {
-            if(!nas_intf_add_master(mem_idx, master_info)){
+    if_master_info_t master_info = { nas_int_type_LAG, NAS_PORT_NONE, bond_idx};
+    for (auto &m : members) {
+        if (m.add) {
+            if(!nas_intf_add_master(m.mem_idx, master_info)){
                 EV_LOGGING(INTERFACE,DEBUG,"NAS-LAG","Failed to add master for lag memeber port");
-            } else {
-                BASE_IF_MODE_t new_mode = nas_intf_get_mode(mem_idx);
-                if (new_mode != intf_mode) {
-                    if (nas_intf_handle_intf_mode_change(mem_idx, new_mode) == false) {
-                        EV_LOGGING(INTERFACE,DEBUG,"NAS-LAG",
-                                "Update to NAS-L3 about interface mode change failed(%d)", mem_idx);
-                    }
-                }
-            }
-        } else if (op == cps_api_oper_DELETE) {
-             nas_lag_master_info_t * lag_entry =NULL;
-             /*  delete the member from the lag */
-             lag_entry = nas_get_lag_node(bond_idx);
-             if(lag_entry == nullptr){
-                 EV_LOGGING(INTERFACE,INFO,"NAS-LAG","Failed to find lag entry with %d"
-                              "ifindex for delete operation",bond_idx);
-                 return;
-             }
-
-            /*
-             * For kernel notification to delete the member port, check if present in block list
-             * if it is in blocking list then we would have removed the port from kernel to prevent
-             * hashing to blocked port in kernel. In that case just continue and don't trigger
-             * mode change
-             */
-
-            if(lag_entry->block_port_list.find(mem_idx) != lag_entry->block_port_list.end()){
-                return;
             }
+            continue;
+        }
+        nas_lag_master_info_t * lag_entry = nas_get_lag_node(bond_idx);
+        if(lag_entry == nullptr){
+            EV_LOGGING(INTERFACE,INFO,"NAS-LAG","Failed to find lag entry with %d"
+                         "ifindex for delete operation",bond_idx);
+            m.skip = true;
+            continue;
+        }
+        /*
+         * For kernel notification to delete the member port, check if present in block list
+         * if it is in blocking list then we would have removed the port from kernel to prevent
+         * hashing to blocked port in kernel. In that case just continue and don't trigger
+         * mode change and let the port be still there in npu as part of lag
+         */
+        if(lag_entry->block_port_list.find(m.mem_idx) != lag_entry->block_port_list.end()){
+            m.skip = true;
+            continue;
+        }
+        if(!nas_intf_del_master(m.mem_idx, master_info)){
+             EV_LOGGING(INTERFACE,DEBUG,"NAS-LAG",
+                     "Failed to delete master for lag memeber port");
+        }
+    }
 
-            if(!nas_intf_del_master(mem_idx, master_info)){
-                 EV_LOGGING(INTERFACE,DEBUG,"NAS-LAG",
-                         "Failed to delete master for lag memeber port");
-            } else {
-                BASE_IF_MODE_t new_mode = nas_intf_get_mode(mem_idx);
-                if (new_mode != intf_mode) {
-                    if (nas_intf_handle_intf_mode_change(mem_idx, new_mode) == false) {
-                        EV_LOGGING(INTERFACE,DEBUG,"NAS-LAG",
-                                "Update to NAS-L3 about interface mode change failed(%d)", mem_idx);
-                    }
-                }
+    size_t npu_members = 0;
+    for (auto &m : members) {
+        if (m.skip) continue;
+        BASE_IF_MODE_t new_mode = nas_intf_get_mode(m.mem_idx);
+        if (new_mode != m.mode) {
+            if (nas_intf_handle_intf_mode_change(m.mem_idx, new_mode) == false) {
+                EV_LOGGING(INTERFACE,DEBUG,"NAS-LAG",
+                        "Update to NAS-L3 about interface mode change failed(%d)", m.mem_idx);
             }
         }
-
-        if(nas_is_virtual_port(mem_idx)){
+        if(nas_is_virtual_port(m.mem_idx)){
              EV_LOGGING(INTERFACE,INFO, "NAS-LAG",
-                     " Member port %s is virtual no need to do anything", mem_name);
-             return;
+                     " Member port %s is virtual no need to do anything", m.mem_name);
+             m.skip = true;
+             continue;
         }
+        ++npu_members;
+    }
+    if (!members.empty() && (npu_members == 0)) {
+        return;
     }
 
     std_mutex_simple_lock_guard lock_t(nas_lag_mutex_lock());
-    /* If op is CREATE then create the lag if not present and then add member lists*/
-    if (op == cps_api_oper_CREATE) {
-        if (_name_attr == nullptr) {
+    bool create = false;
+    nas_lag_master_info_t *nas_lag_entry = NULL;
+    /* If a member was added then create the lag if not present */
+    if (create_obj != nullptr) {
+        if (bond_name == NULL) {
             EV_LOGGING(INTERFACE,ERR, "NAS-LAG", " Bond name is not present in the create event");
             return;
         }
-        const char *bond_name =  (const char*)cps_api_object_attr_data_bin(_name_attr);
-        if ((nas_lag_entry = nas_get_lag_node(bond_idx)) == NULL) {
-            /*  Create the lag  */
-            EV_LOGGING(INTERFACE,INFO,"NAS-LAG","Create Lag interface idx %d with lag ID %d ", bond_idx,lag_id);
-
-            if ((nas_lag_master_add(bond_idx,bond_name,lag_id)) != STD_ERR_OK) {
-                    EV_LOGGING(INTERFACE,ERR, "NAS-LAG",
-                            "LAG creation Failed for bond interface %s index %d",bond_name, bond_idx);
-                    return;
-            }
-            if (nas_intf_handle_intf_mode_change(bond_idx, BASE_IF_MODE_MODE_NONE) == false) {
-                EV_LOGGING(INTERFACE, DEBUG, "NAS-LAG",
-                        "Update to NAS-L3 about interface mode change failed(%d)", bond_idx);
-            }
-            /* Now get the lag node entry */
-            nas_lag_entry = nas_get_lag_node(bond_idx);
-            if(nas_lag_entry != NULL){
-                nas_cps_handle_mac_set (bond_name, nas_lag_entry->ifindex);
-                create = true;
+        nas_lag_entry = nas_lag_ev_lag_create(bond_idx, bond_name, &create);
+    } else {
+        nas_lag_entry = nas_get_lag_node(bond_idx);
+    }
+    if (nas_lag_entry == NULL) {
+        return;
+    }
+
+    bool changed = false;
+    for (auto &m : members) {
+        if (m.skip) continue;
+        if (!m.add) {
+            if(nas_lag_member_delete(bond_idx, m.mem_idx) != STD_ERR_OK) {
+                EV_LOGGING(INTERFACE,INFO,"NAS-LAG",
+                        "Failed to Delete member %s to the Lag %d", m.mem_name, bond_idx);
+                continue;
             }
-            /* TODO Add function to set intf description on netlink message */
+            nas_lag_entry->port_list.erase(m.mem_idx);
+            changed = true;
+            continue;
         }
-        /*   Check if Member port is present then add the members in the lag */
-        if (_mem_attr != nullptr) {
-              /* Check: if port is a bond member*/
-            if (nas_lag_if_port_is_lag_member(bond_idx, mem_idx)) {
-                EV_LOGGING(INTERFACE, DEBUG, "NAS-LAG", "Slave port %d already a member of lag %d",
-                               mem_idx, bond_idx);
-                return ;
-            }
-            if(nas_lag_member_add(bond_idx,mem_idx) != STD_ERR_OK) {
-                EV_LOGGING(INTERFACE,INFO, "NAS-LAG",
-                    "Failed to Add member %s to the Lag %s", mem_name, bond_name);
-                return ;
+        /* Check: if port is a bond member*/
+        if (nas_lag_if_port_is_lag_member(bond_idx, m.mem_idx)) {
+            EV_LOGGING(INTERFACE, DEBUG, "NAS-LAG", "Slave port %d already a member of lag %d",
+                           m.mem_idx, bond_idx);
+            continue;
+        }
+        if(nas_lag_member_add(bond_idx,m.mem_idx) != STD_ERR_OK) {
+            EV_LOGGING(INTERFACE,INFO, "NAS-LAG",
+                "Failed to Add member %s to the Lag %d", m.mem_name, bond_idx);
+            continue;
+        }
+        nas_lag_entry->port_list.insert(m.mem_idx);
+        changed = true;
+        ndi_port_t ndi_port;
+        if (nas_int_get_npu_port(m.mem_idx, &ndi_port) != STD_ERR_OK) {
+            EV_LOGGING(INTERFACE,ERR, "NAS-LAG",
+                    "Error in finding member's %s npu port info", m.mem_name);
+            continue;
+        }
+        ndi_intf_link_state_t state;
+        if ((ndi_port_link_state_get(ndi_port.npu_id, ndi_port.npu_port, &state))
+                 == STD_ERR_OK) {
+            bool block_status = true;
+
+            /* if Oper up and port not in block list, then reset egress_disable */
+            if ((nas_lag_entry->block_port_list.find(m.mem_idx) ==
+                 nas_lag_entry->block_port_list.end()) &&
+                 (state.oper_status == ndi_port_OPER_UP)) {
+
+                block_status = false;
             }
-            nas_lag_entry->port_list.insert(mem_idx);
-            member_op = cps_api_oper_SET;
-            ndi_port_t ndi_port;
-            if (nas_int_get_npu_port(mem_idx, &ndi_port) != STD_ERR_OK) {
-                EV_LOGGING(INTERFACE,ERR, "NAS-LAG",
-                        "Error in finding member's %s npu port info", mem_name);
-                return;
+
+            if (nas_lag_block_port(nas_lag_entry,m.mem_idx,block_status) != STD_ERR_OK){
+
+                EV_LOGGING(INTERFACE,ERR, "NAS-CPS-LAG",
+                        "Error Block/unblock Port %s lag %d ",m.mem_name, bond_idx);
             }
-            ndi_intf_link_state_t state;
-            if ((ndi_port_link_state_get(ndi_port.npu_id, ndi_port.npu_port, &state))
-                     == STD_ERR_OK) {
+        }
+    }
+    // Handler attribute admin,MAC update
+    if (create_obj != nullptr) {
+        nas_lag_ev_set_handler(bond_idx, create_obj, create);
+    }
 
-                /* if Oper up and port not in block list, then reset egress_disable */
-                if ((nas_lag_entry->block_port_list.find(mem_idx) ==
-                     nas_lag_entry->block_port_list.end()) &&
-                     (state.oper_status == ndi_port_OPER_UP)) {
+    if (changed) {
+        /*  Publish the Lag event with portlist in case of member addition/deletion */
+        if(lag_object_publish(nas_lag_entry, bond_idx, cps_api_oper_SET)!= cps_api_ret_code_OK){
+            EV_LOGGING(INTERFACE,ERR, "NAS-CPS-LAG",
+                    "LAG events publish failure");
+        }
+    }
+}
 
-                    block_status = false;
-                }
+void nas_lag_ev_handler(cps_api_object_t obj) {
 
-                if (nas_lag_block_port(nas_lag_entry,mem_idx,block_status) != STD_ERR_OK){
+    bool create = false;
+    nas_lag_master_info_t *nas_lag_entry=NULL;
 
-                    EV_LOGGING(INTERFACE,ERR, "NAS-CPS-LAG",
-                            "Error Block/unblock Port %s lag %s ",mem_name, bond_name);
-                    return ;
-                }
-            }
+    cps_api_object_attr_t _idx_attr = cps_api_object_attr_get(obj,
+                                        DELL_BASE_IF_CMN_IF_INTERFACES_INTERFACE_IF_INDEX);
+    cps_api_object_attr_t _mem_attr = cps_api_object_attr_get(obj,
+                                     DELL_IF_IF_INTERFACES_INTERFACE_MEMBER_PORTS_NAME);
+    cps_api_object_attr_t _name_attr = cps_api_object_attr_get(obj, IF_INTERFACES_INTERFACE_NAME);
+    cps_api_operation_types_t op = cps_api_object_type_operation(cps_api_object_key(obj));
+
+    if (_idx_attr == nullptr) {
+        EV_LOGGING(INTERFACE,ERR, "NAS-LAG", " LAG IF_index not present in the OS EVENT");
+        return;
+    }
+    hal_ifindex_t bond_idx = cps_api_object_attr_data_u32(_idx_attr);
+    if ((_mem_attr != nullptr) && ((op == cps_api_oper_CREATE) || (op == cps_api_oper_DELETE))) {
+        nas_lag_ev_member_batch_handler(std::vector<cps_api_object_t>(1, obj));
+        return;
+    }
+
+    std_mutex_simple_lock_guard lock_t(nas_lag_mutex_lock());
+    /* If op is CREATE then create the lag if not present */
+    if (op == cps_api_oper_CREATE) {
+        if (_name_attr == nullptr) {
+            EV_LOGGING(INTERFACE,ERR, "NAS-LAG", " Bond name is not present in the create event");
+            return;
+        }
+        const char *bond_name =  (const char*)cps_api_object_attr_data_bin(_name_attr);
+        if ((nas_lag_entry = nas_lag_ev_lag_create(bond_idx, bond_name, &create)) == NULL) {
+            return;
         }
         // Handler attribute admin,MAC update
         nas_lag_ev_set_handler(bond_idx, obj, create);
 
     } else if (op == cps_api_oper_DELETE) { /* If op is DELETE */
-        if (_mem_attr != nullptr) {
-            /*  delete the member from the lag */
-            nas_lag_entry = nas_get_lag_node(bond_idx);
-            if(nas_lag_entry == nullptr){
-                EV_LOGGING(INTERFACE,INFO,"NAS-LAG","Failed to find lag entry with %d"
-                        "ifindex for delete operation",bond_idx);
-                return;
-            }
-
-            /*
-             * For kernel notification to delete the member port, check if present in block list
-             * if it is in blocking list then we would have removed the port from kernel to prevent
-             * hashing to blocked port in kernel. In that case just continue and let the port be
-             * still there in npu as part of lag
-             */
-            if(nas_lag_entry->block_port_list.find(mem_idx) != nas_lag_entry->block_port_list.end()){
-                return;
-            }
-
-            if(nas_lag_member_delete(bond_idx, mem_idx) != STD_ERR_OK) {
-                EV_LOGGING(INTERFACE,INFO,"NAS-LAG",
-                        "Failed to Delete member %s to the Lag %d", mem_name, bond_idx);
-                return ;
-            }
-            nas_lag_entry->port_list.erase(mem_idx);
-            member_op = cps_api_oper_SET;
-        } else {
-            if (nas_intf_handle_intf_mode_change(bond_idx, BASE_IF_MODE_MODE_L2) == false) {
-                EV_LOGGING(INTERFACE, DEBUG, "NAS-LAG",
-                        "Update to NAS-L3 about interface mode change failed(%d)", bond_idx);
-            }
-            /*  Otherwise the event is to delete the lag */
-            if((nas_lag_master_delete(bond_idx) != STD_ERR_OK))
-                return ;
+        if (nas_intf_handle_intf_mode_change(bond_idx, BASE_IF_MODE_MODE_L2) == false) {
+            EV_LOGGING(INTERFACE, DEBUG, "NAS-LAG",
+                    "Update to NAS-L3 about interface mode change failed(%d)", bond_idx);
         }
+        /*  Otherwise the event is to delete the lag */
+        if((nas_lag_master_delete(bond_idx) != STD_ERR_OK))
+            return ;
     } else if (op == cps_api_oper_SET) {
         EV_LOGGING(INTERFACE, DEBUG, "NAS-LAG", "LAG set event received for %d", bond_idx);
         nas_lag_ev_set_handler(bond_idx, obj, create);
     }
-    if (member_op == cps_api_oper_SET) {
-        /*  Publish the Lag event with portlist in case of member addition/deletion */
-        if ((nas_lag_entry = nas_get_lag_node(bond_idx)) == NULL) {
-            return;
-        }
-        if(lag_object_publish(nas_lag_entry, bond_idx, member_op)!= cps_api_ret_code_OK){
-            EV_LOGGING(INTERFACE,ERR, "NAS-CPS-LAG",
-                    "LAG events publish failure");
-            return ;
-        }
-    }
 }
 
 // Bridge Event Handler
@@ -1034,17 +1114,120 @@ static auto _int_ev_handlers = new std::unordered_map<BASE_CMN_INTERFACE_TYPE_t,
     {BASE_CMN_INTERFACE_TYPE_MANAGEMENT, nas_mgmt_ev_handler},
 };
 
-bool nas_int_ev_handler_cb(cps_api_object_t obj, void *param) {
+/*
+ * Ordering of an OS event for the dispatcher. The key is the ifindex of the object
+ * the event changes. LAG, bridge, bridge member, VXLAN and sub-interface handlers share
+ * the master lists, port modes and interface object map, so their events are shared
+ * and run one at a time. A bond slave port event stays on the worker of the port and
+ * depends on the shared events, and a LAG event depends on its member ports, so either
+ * side waits for what the other has queued. Objects referred to by name are dependencies
+ * so their earlier events are done first. A name that is not known yet may have its create event
+ * still queued, so the event then waits for everything queued before it.
+ */
+static void nas_int_ev_order_get(cps_api_object_t obj, BASE_CMN_INTERFACE_TYPE_t if_type,
+                                 nas_int_ev_order_t &order)
+{
+    order.key = 0;
+    order.dep_all = false;
+    order.shared = false;
+    order.merge_id = 0;
+    order.batch_fn = nullptr;
+
+    auto name_dep = [&](cps_api_attr_id_t id) {
+        cps_api_object_it_t it;
+        cps_api_object_it_begin(obj, &it);
+        for ( ; cps_api_object_it_attr_walk(&it, id); cps_api_object_it_next(&it)) {
+            interface_ctrl_t intf_ctrl;
+            memset(&intf_ctrl, 0, sizeof(intf_ctrl));
+            intf_ctrl.q_type = HAL_INTF_INFO_FROM_IF_NAME;
+            safestrncpy(intf_ctrl.if_name, (const char *)cps_api_object_attr_data_bin(it.attr),
+                        sizeof(intf_ctrl.if_name));
+            if (dn_hal_get_interface_info(&intf_ctrl) != STD_ERR_OK) {
+                order.dep_all = true;
+                return;
+            }
+            switch (intf_ctrl.int_type) {
+                case nas_int_type_LAG:
+                case nas_int_type_VLAN:
+                case nas_int_type_DOT1D_BRIDGE:
+                case nas_int_type_VLANSUB_INTF:
+                    order.deps.push_back(NAS_INT_EV_SHARED_KEY);
+                    break;
+                default:
+                    order.deps.push_back(intf_ctrl.if_index);
+                    break;
+            }
+        }
+    };
 
-    cps_api_object_attr_t _type = cps_api_object_attr_get(obj,BASE_IF_LINUX_IF_INTERFACES_INTERFACE_DELL_TYPE);
-    if (_type==nullptr) {
-        EV_LOGGING(INTERFACE,ERR,"INTF-EV","Unknown Event or interface type not present");
-        return true;
+    cps_api_object_attr_t idx_attr = cps_api_object_attr_get(obj,
+                                        DELL_BASE_IF_CMN_IF_INTERFACES_INTERFACE_IF_INDEX);
+    cps_api_object_attr_t master_attr = cps_api_object_attr_get(obj,
+                                        BASE_IF_LINUX_IF_INTERFACES_INTERFACE_IF_MASTER);
+    cps_api_object_attr_t name_attr = cps_api_object_attr_get(obj, IF_INTERFACES_INTERFACE_NAME);
+    if (idx_attr != nullptr) {
+        order.key = cps_api_object_attr_data_u32(idx_attr);
+    } else if (name_attr != nullptr) {
+        order.key = std::hash<std::string>()((const char *)cps_api_object_attr_data_bin(name_attr));
     }
-    EV_LOGGING(INTERFACE,INFO,"INTF-EV","OS event received for interface state change.");
-    BASE_CMN_INTERFACE_TYPE_t if_type = (BASE_CMN_INTERFACE_TYPE_t) cps_api_object_attr_data_u32(_type);
-    cps_api_object_attr_t _vrf_attr = cps_api_object_attr_get(obj, VRF_MGMT_NI_IF_INTERFACES_INTERFACE_VRF_ID);
 
+    /*
+     * Attribute updates of a port or a bond carry the full new value of each attribute
+     * they contain, so a queued update can absorb a later one for the same interface.
+     */
+    cps_api_operation_types_t op = cps_api_object_type_operation(cps_api_object_key(obj));
+    bool attr_update = (op == cps_api_oper_SET) && (idx_attr != nullptr);
+
+    switch (if_type) {
+        case BASE_CMN_INTERFACE_TYPE_L3_PORT:
+            /*
+             * A bond slave port waits for the queued events of its bond, which are shared.
+             * It is not merged, a merge would skip bond events queued after the first update.
+             */
+            if (master_attr != nullptr) {
+                order.deps.push_back(NAS_INT_EV_SHARED_KEY);
+            } else if (attr_update) {
+                order.merge_id = ((uint64_t)if_type << 32) | cps_api_object_attr_data_u32(idx_attr);
+            }
+            break;
+        case BASE_CMN_INTERFACE_TYPE_LAG:
+            order.shared = true;
+            name_dep(DELL_IF_IF_INTERFACES_INTERFACE_MEMBER_PORTS_NAME);
+            /* Slave port add/delete events of a bond are applied together */
+            if (((op == cps_api_oper_CREATE) || (op == cps_api_oper_DELETE)) &&
+                (cps_api_object_attr_get(obj, DELL_IF_IF_INTERFACES_INTERFACE_MEMBER_PORTS_NAME) != nullptr)) {
+                order.batch_fn = nas_lag_ev_member_batch_handler;
+            }
+            if (attr_update &&
+                (cps_api_object_attr_get(obj, DELL_IF_IF_INTERFACES_INTERFACE_MEMBER_PORTS_NAME) == nullptr)) {
+                order.merge_id = ((uint64_t)if_type << 32) | cps_api_object_attr_data_u32(idx_attr);
+            }
+            break;
+        case BASE_CMN_INTERFACE_TYPE_BRIDGE:
+        case BASE_CMN_INTERFACE_TYPE_VXLAN:
+            order.shared = true;
+            break;
+        case BASE_CMN_INTERFACE_TYPE_L2_PORT:
+            order.shared = true;
+            if (master_attr != nullptr) order.key = cps_api_object_attr_data_u32(master_attr);
+            name_dep(DELL_IF_IF_INTERFACES_INTERFACE_TAGGED_PORTS);
+            name_dep(DELL_IF_IF_INTERFACES_INTERFACE_UNTAGGED_PORTS);
+            break;
+        case BASE_CMN_INTERFACE_TYPE_VLAN_SUBINTF:
+            order.shared = true;
+            name_dep(DELL_IF_IF_INTERFACES_INTERFACE_PARENT_INTERFACE);
+            break;
+        default:
+            break;
+    }
+}
+
+/*
+ * Drop events the handlers would ignore, using the key attributes only, before
+ * they are copied and queued. Returns true if the event is to be dropped.
+ */
+static bool nas_int_ev_filter(cps_api_object_t obj, BASE_CMN_INTERFACE_TYPE_t if_type)
+{
     /*  only in case of mgmt interface events are processed un-conditionally.
      *  Otherwise in case of CPS only configuration for interface.
      *  interface events are ignored.
@@ -1056,21 +1239,58 @@ bool nas_int_ev_handler_cb(cps_api_object_t obj, void *param) {
             (if_type != BASE_CMN_INTERFACE_TYPE_LOOPBACK) &&
             (if_type != BASE_CMN_INTERFACE_TYPE_MACVLAN))
         {
-            /* Ignore all interface events interface if this is not from non-default VRF */
             return true;
         }
     }
 
+    cps_api_object_attr_t _vrf_attr = cps_api_object_attr_get(obj, VRF_MGMT_NI_IF_INTERFACES_INTERFACE_VRF_ID);
     if (_vrf_attr && (cps_api_object_attr_data_u32(_vrf_attr) != NAS_DEFAULT_VRF_ID)
             && (if_type != BASE_CMN_INTERFACE_TYPE_MANAGEMENT)) {
         /* Ignore all interface events interface from non-default VRF */
-        EV_LOGGING(INTERFACE,ERR,"INTF-EV","Interface type %u", if_type);
+        EV_LOGGING(INTERFACE,DEBUG,"INTF-EV","Non-default VRF event ignored, interface type %u", if_type);
+        return true;
+    }
+
+    cps_api_operation_types_t op = cps_api_object_type_operation(cps_api_object_key(obj));
+    if (op != cps_api_oper_SET) {
+        return false;
+    }
+    switch (if_type) {
+        case BASE_CMN_INTERFACE_TYPE_BRIDGE:
+        case BASE_CMN_INTERFACE_TYPE_VXLAN:
+            /*  set events are not handled for these types */
+            return true;
+        case BASE_CMN_INTERFACE_TYPE_L3_PORT:
+            /*  only admin state and MTU are applied from the OS */
+            return (cps_api_object_attr_get(obj, IF_INTERFACES_INTERFACE_ENABLED) == nullptr) &&
+                   (cps_api_object_attr_get(obj, DELL_IF_IF_INTERFACES_INTERFACE_MTU) == nullptr);
+        default:
+            return false;
+    }
+}
+
+bool nas_int_ev_handler_cb(cps_api_object_t obj, void *param) {
+
+    cps_api_object_attr_t _type = cps_api_object_attr_get(obj,BASE_IF_LINUX_IF_INTERFACES_INTERFACE_DELL_TYPE);
+    if (_type==nullptr) {
+        EV_LOGGING(INTERFACE,ERR,"INTF-EV","Unknown Event or interface type not present");
+        return true;
+    }
+    EV_LOGGING(INTERFACE,INFO,"INTF-EV","OS event received for interface state change.");
+    BASE_CMN_INTERFACE_TYPE_t if_type = (BASE_CMN_INTERFACE_TYPE_t) cps_api_object_attr_data_u32(_type);
+    if (if_type == BASE_CMN_INTERFACE_TYPE_L3_PORT) {
+        /*  keep the interface attribute store in sync whether or not the event is processed */
+        nas_int_os_if_store_update(obj);
+    }
+    if (nas_int_ev_filter(obj, if_type)) {
         return true;
     }
 
     auto func = _int_ev_handlers->find(if_type);
     if (func != _int_ev_handlers->end()) {
-        func->second(obj);
+        nas_int_ev_order_t order;
+        nas_int_ev_order_get(obj, if_type, order);
+        nas_int_ev_dispatch(order, obj, func->second);
         return true;
     } else {
         EV_LOGGING(INTERFACE,ERR,"INTF-EV","Unknown interface type");
@@ -52,6 +52,7 @@
 #include "nas_stats.h"
 #include "nas_fc_stats.h"
 #include "nas_int_utils.h"
+#include "nas_int_ev_dispatch.h"
 #include "std_utils.h"
 #include "nas_vrf.h"
 #include "bridge/nas_interface_bridge_cps.h"
@@ -62,11 +63,15 @@
 
 #include "nas_os_interface.h"
 #include "nas_ndi_port.h"
+#include "std_mutex_lock.h"
 #include <string.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <unistd.h>
 #include <set>
+#include <string>
+#include <vector>
+#include <unordered_map>
 
 #define NUM_INT_CPS_API_THREAD 1
 
@@ -96,78 +101,261 @@ static void hw_link_state_cb(npu_id_t npu, npu_port_t port,
     }
 }
 
-t_std_error nas_if_get_assigned_mac(const char *if_type,
-                                    const char *if_name,
-                                    hal_vlan_id_t vlan_id,
-                                    char *mac_addr, size_t mac_buf_size)
+/*
+ * Assigned MAC addresses are derived from the system base MAC and the
+ * interface type/id, so they never change once returned by the MAC
+ * allocation service.  Keep them in a local cache keyed by type and VLAN id
+ * or name, and prefetch a block of VLAN addresses on a miss so that bulk VLAN
+ * creation does not pay a CPS round trip per interface.
+ */
+#define NAS_IF_MAC_VLAN_PREFETCH_BLOCK 64
+
+static std::unordered_map<std::string, std::string> _assigned_mac_cache;
+static std_mutex_lock_create_static_init_fast(_assigned_mac_lock);
+
+static bool _is_vlan_if_type(const char *if_type)
 {
-    if (mac_buf_size == 0) {
-        return STD_ERR_OK;
+    return strncmp(if_type,
+                   IF_INTERFACE_TYPE_IANAIFT_IANA_INTERFACE_TYPE_IANAIFT_L2VLAN,
+                   sizeof(IF_INTERFACE_TYPE_IANAIFT_IANA_INTERFACE_TYPE_IANAIFT_L2VLAN)) == 0;
+}
+
+static bool _assigned_mac_key(const char *if_type, const char *if_name,
+                              hal_vlan_id_t vlan_id, std::string& key)
+{
+    if (if_type == NULL) {
+        return false;
+    }
+    key = if_type;
+    key += '/';
+    if (_is_vlan_if_type(if_type)) {
+        if (vlan_id == 0) {
+            return false;
+        }
+        key += std::to_string(vlan_id);
+    } else {
+        if (if_name == NULL) {
+            return false;
+        }
+        key += if_name;
+    }
+    return true;
+}
+
+static bool _assigned_mac_cache_get(const std::string& key, nas_if_mac_req_t *req)
+{
+    std_mutex_simple_lock_guard lg(&_assigned_mac_lock);
+    auto it = _assigned_mac_cache.find(key);
+    if (it == _assigned_mac_cache.end()) {
+        return false;
     }
+    safestrncpy(req->mac_addr, it->second.c_str(), sizeof(req->mac_addr));
+    return true;
+}
+
+static void _assigned_mac_cache_add(const std::string& key, const char *mac_addr)
+{
+    std_mutex_simple_lock_guard lg(&_assigned_mac_lock);
+    _assigned_mac_cache[key] = mac_addr;
+}
+
+static bool _add_get_mac_obj(cps_api_transaction_params_t *tr, const nas_if_mac_req_t *req)
+{
     cps_api_object_t obj = cps_api_object_create();
     if (obj == NULL) {
-        return STD_ERR(INTERFACE, FAIL, 0);
+        return false;
     }
     if (!cps_api_key_from_attr_with_qual(cps_api_object_key(obj),
                                          DELL_BASE_IF_CMN_GET_MAC_ADDRESS_OBJ,
                                          cps_api_qualifier_TARGET)) {
         cps_api_object_delete(obj);
-        return STD_ERR(INTERFACE, FAIL, 0);
+        return false;
     }
-    cps_api_object_attr_add(obj, IF_INTERFACES_INTERFACE_TYPE, if_type, strlen(if_type) + 1);
-
-    if (strncmp(if_type,
-                IF_INTERFACE_TYPE_IANAIFT_IANA_INTERFACE_TYPE_IANAIFT_L2VLAN,
-                sizeof(IF_INTERFACE_TYPE_IANAIFT_IANA_INTERFACE_TYPE_IANAIFT_L2VLAN)) == 0) {
-        if (vlan_id == 0) {
-            return STD_ERR(INTERFACE, FAIL, 0);
-        }
-        cps_api_object_attr_add_u16(obj, BASE_IF_VLAN_IF_INTERFACES_INTERFACE_ID, vlan_id);
+    cps_api_object_attr_add(obj, IF_INTERFACES_INTERFACE_TYPE, req->if_type,
+                            strlen(req->if_type) + 1);
+    if (_is_vlan_if_type(req->if_type)) {
+        cps_api_object_attr_add_u16(obj, BASE_IF_VLAN_IF_INTERFACES_INTERFACE_ID, req->vlan_id);
     } else {
-        if (if_name == NULL) {
-            return STD_ERR(INTERFACE, FAIL, 0);
-        }
-        cps_api_object_attr_add(obj, IF_INTERFACES_INTERFACE_NAME, if_name, strlen(if_name) + 1);
+        cps_api_object_attr_add(obj, IF_INTERFACES_INTERFACE_NAME, req->if_name,
+                                strlen(req->if_name) + 1);
+    }
+    if (cps_api_action(tr, obj) != cps_api_ret_code_OK) {
+        cps_api_object_delete(obj);
+        return false;
     }
+    return true;
+}
 
+/*
+ * Resolve a list of MAC requests from the MAC allocation service in one CPS
+ * transaction. Every request must have a valid key.
+ */
+static t_std_error _commit_get_mac_list(std::vector<nas_if_mac_req_t*>& req_list)
+{
     cps_api_transaction_params_t tr;
     if (cps_api_transaction_init(&tr) != cps_api_ret_code_OK) {
-        cps_api_object_delete(obj);
         return STD_ERR(INTERFACE, FAIL, 0);
     }
-    cps_api_action(&tr, obj);
     t_std_error rc = STD_ERR(INTERFACE, FAIL, 0);
     do {
-        if (cps_api_commit(&tr) != cps_api_ret_code_OK) {
-            EV_LOGGING(INTERFACE, ERR, "NAS-INTF-MAC", "Failed to commit");
-            break;
+        bool obj_added = true;
+        for (auto req: req_list) {
+            if (!(obj_added = _add_get_mac_obj(&tr, req))) break;
         }
-        size_t mx = cps_api_object_list_size(tr.change_list);
-        if (mx == 0) {
-            EV_LOGGING(INTERFACE, ERR, "NAS-INTF-MAC", "No object returned");
+        if (!obj_added) {
+            EV_LOGGING(INTERFACE, ERR, "NAS-INTF-MAC", "Failed to build request object");
             break;
         }
-        obj = cps_api_object_list_get(tr.change_list, 0);
-        cps_api_object_attr_t attr = cps_api_object_attr_get(obj,
-                                        DELL_IF_IF_INTERFACES_INTERFACE_PHYS_ADDRESS);
-        if (attr == NULL) {
-            EV_LOGGING(INTERFACE, ERR, "NAS-INTF-MAC", "No mac address in returned object");
+        if (cps_api_commit(&tr) != cps_api_ret_code_OK) {
+            EV_LOGGING(INTERFACE, ERR, "NAS-INTF-MAC", "Failed to commit");
             break;
         }
-        char *addr_str = (char *)cps_api_object_attr_data_bin(attr);
-        if (strlen(addr_str) > MAC_STRING_SZ) {
-            EV_LOGGING(INTERFACE, ERR, "NAS-INTF-MAC", "Invalid mac address format: %s",
-                       addr_str);
+        size_t mx = cps_api_object_list_size(tr.change_list);
+        if (mx < req_list.size()) {
+            EV_LOGGING(INTERFACE, ERR, "NAS-INTF-MAC", "%d objects returned for %d requests",
+                       (int)mx, (int)req_list.size());
             break;
         }
-        safestrncpy(mac_addr, addr_str, mac_buf_size);
         rc = STD_ERR_OK;
+        for (size_t ix = 0; ix < req_list.size(); ++ix) {
+            nas_if_mac_req_t *req = req_list[ix];
+            req->rc = STD_ERR(INTERFACE, FAIL, 0);
+            cps_api_object_t obj = cps_api_object_list_get(tr.change_list, ix);
+            cps_api_object_attr_t attr = cps_api_object_attr_get(obj,
+                                            DELL_IF_IF_INTERFACES_INTERFACE_PHYS_ADDRESS);
+            if (attr == NULL) {
+                EV_LOGGING(INTERFACE, ERR, "NAS-INTF-MAC", "No mac address in returned object");
+                rc = req->rc;
+                continue;
+            }
+            char *addr_str = (char *)cps_api_object_attr_data_bin(attr);
+            if (strlen(addr_str) > MAC_STRING_SZ) {
+                EV_LOGGING(INTERFACE, ERR, "NAS-INTF-MAC", "Invalid mac address format: %s",
+                           addr_str);
+                rc = req->rc;
+                continue;
+            }
+            safestrncpy(req->mac_addr, addr_str, sizeof(req->mac_addr));
+            req->rc = STD_ERR_OK;
+        }
     } while(0);
     cps_api_transaction_close(&tr);
 
     return rc;
 }
 
+t_std_error nas_if_get_assigned_mac_bulk(nas_if_mac_req_t *req_list, size_t count)
+{
+    t_std_error rc = STD_ERR_OK;
+    std::vector<std::string> keys(count);
+    std::vector<nas_if_mac_req_t*> miss_list;
+    std::set<hal_vlan_id_t> vlan_miss;
+    const char *vlan_if_type = nullptr;
+
+    for (size_t ix = 0; ix < count; ++ix) {
+        nas_if_mac_req_t *req = &req_list[ix];
+        req->mac_addr[0] = '\0';
+        if (!_assigned_mac_key(req->if_type, req->if_name, req->vlan_id, keys[ix])) {
+            req->rc = rc = STD_ERR(INTERFACE, PARAM, 0);
+            continue;
+        }
+        if (_assigned_mac_cache_get(keys[ix], req)) {
+            req->rc = STD_ERR_OK;
+            continue;
+        }
+        req->rc = STD_ERR(INTERFACE, FAIL, 0);
+        miss_list.push_back(req);
+        if (_is_vlan_if_type(req->if_type)) {
+            vlan_miss.insert(req->vlan_id);
+            vlan_if_type = req->if_type;
+        }
+    }
+    if (miss_list.empty()) {
+        return rc;
+    }
+
+    /*
+     * Prefetch the VLAN ids following each missed one so that subsequent
+     * creates of consecutive VLANs are served from the cache
+     */
+    std::vector<nas_if_mac_req_t> prefetch_list;
+    if (vlan_if_type != nullptr) {
+        std::set<hal_vlan_id_t> prefetch_ids;
+        for (auto vid: vlan_miss) {
+            for (hal_vlan_id_t pvid = vid + 1;
+                 pvid < IF_VLAN_MAX && pvid <= vid + NAS_IF_MAC_VLAN_PREFETCH_BLOCK; ++pvid) {
+                if (vlan_miss.find(pvid) != vlan_miss.end()) continue;
+                std::string key;
+                _assigned_mac_key(vlan_if_type, nullptr, pvid, key);
+                std_mutex_simple_lock_guard lg(&_assigned_mac_lock);
+                if (_assigned_mac_cache.find(key) == _assigned_mac_cache.end()) {
+                    prefetch_ids.insert(pvid);
+                }
+            }
+        }
+        prefetch_list.resize(prefetch_ids.size());
+        size_t ix = 0;
+        for (auto pvid: prefetch_ids) {
+            nas_if_mac_req_t& preq = prefetch_list[ix++];
+            preq.if_type = vlan_if_type;
+            preq.if_name = nullptr;
+            preq.vlan_id = pvid;
+            preq.mac_addr[0] = '\0';
+            preq.rc = STD_ERR(INTERFACE, FAIL, 0);
+        }
+    }
+
+    std::vector<nas_if_mac_req_t*> commit_list(miss_list);
+    for (auto& preq: prefetch_list) {
+        commit_list.push_back(&preq);
+    }
+    if (_commit_get_mac_list(commit_list) != STD_ERR_OK && !prefetch_list.empty()) {
+        /* Prefetch is best effort, retry with only the requested entries */
+        _commit_get_mac_list(miss_list);
+    }
+
+    for (auto req: commit_list) {
+        if ((req->rc == STD_ERR_OK) && (req->mac_addr[0] == '\0')) {
+            req->rc = STD_ERR(INTERFACE, FAIL, 0);
+        }
+        if (req->rc == STD_ERR_OK) {
+            std::string key;
+            _assigned_mac_key(req->if_type, req->if_name, req->vlan_id, key);
+            _assigned_mac_cache_add(key, req->mac_addr);
+        }
+    }
+    for (auto req: miss_list) {
+        if (req->rc != STD_ERR_OK) {
+            rc = req->rc;
+        }
+    }
+
+    return rc;
+}
+
+t_std_error nas_if_get_assigned_mac(const char *if_type,
+                                    const char *if_name,
+                                    hal_vlan_id_t vlan_id,
+                                    char *mac_addr, size_t mac_buf_size)
+{
+    if (mac_buf_size == 0) {
+        return STD_ERR_OK;
+    }
+    nas_if_mac_req_t req;
+    memset(&req, 0, sizeof(req));
+    req.if_type = if_type;
+    req.if_name = if_name;
+    req.vlan_id = vlan_id;
+
+    t_std_error rc = nas_if_get_assigned_mac_bulk(&req, 1);
+    if (rc != STD_ERR_OK) {
+        return STD_ERR(INTERFACE, FAIL, 0);
+    }
+    safestrncpy(mac_addr, req.mac_addr, mac_buf_size);
+
+    return STD_ERR_OK;
+}
+
 /*
  * Initialize the interface management module
  */
@@ -196,6 +384,10 @@ t_std_error hal_interface_init(void) {
     reg.number_of_objects = NUM_EVENTS;
     reg.objects = keys;
 
+    if (nas_int_ev_dispatch_init(0) != STD_ERR_OK) {
+        EV_LOGGING(INTERFACE,ERR,"NAS-IF-REG","OS events will be handled on the event thread");
+    }
+
     if (cps_api_event_thread_reg(&reg,nas_int_ev_handler_cb,NULL)!=cps_api_ret_code_OK) {
         return STD_ERR(INTERFACE,FAIL,0);
     }
@@ -38,6 +38,13 @@ std::unique_ptr<pf_table> pf_table_inst(nullptr);
 
 static int pf_sock_fd = -1;
 
+//Receive context of the in-bound packet in hand, built by the first socket redirect,
+//and the rule whose actions are running
+static thread_local bool pf_rx_ingress = false;
+static thread_local bool pf_rx_meta_valid = false;
+static thread_local nas_pkt_rx_meta_t pf_rx_meta;
+static thread_local nas_obj_id_t pf_rule_id = 0;
+
 //Filter Table class definitions
 nas_obj_id_t pf_table::pf_t_create_rule(pf_direction dir, pf_match_t& mat, pf_action_t& act,
                                         bool stop) {
@@ -146,6 +153,7 @@ bool pf_table::pf_t_in_pkt_hndlr(uint8_t *pkt, uint32_t pkt_len, pf_pkt_attr *p_
             match &= ref.pf_m_inv_fptr(m_tv.m_type, pkt, pkt_len, p_attr, m_tv);
         });
         if(match) {
+            pf_rule_id = pfr.pf_r_get_id();
             pfr.pf_r_get_action_params([&](pf_action_t& a_tv) {
                 const pf_action ref = pfr.pf_r_get_action_list();
                 action &= ref.trigger_action(pkt, pkt_len, p_attr, a_tv);
@@ -174,6 +182,7 @@ bool pf_table::pf_t_out_pkt_hndlr(uint8_t *pkt, uint32_t pkt_len, pf_pkt_attr *p
             match &= ref.pf_m_inv_fptr(m_tv.m_type, pkt, pkt_len, p_attr, m_tv);
         });
         if(match) {
+            pf_rule_id = pfr.pf_r_get_id();
             pfr.pf_r_get_action_params([&](pf_action_t& a_tv) {
                 const pf_action ref = pfr.pf_r_get_action_list();
                 action &= ref.trigger_action(pkt, pkt_len, p_attr, a_tv);
@@ -251,8 +260,19 @@ bool pf_action::pf_a_redirect_sock(uint8_t *pkt, uint32_t pkt_len, pf_pkt_attr *
                                    pf_action_t& a_tv) const {
 
     hal_ifindex_t rx_ifindex=0;
+    const nas_pkt_rx_meta_t *rx_meta = nullptr;
 
-    if (!nas_int_port_ifindex (p_attr->npu_id, p_attr->rx_port, &rx_ifindex)) {
+    if (pf_rx_ingress) {
+        if (!pf_rx_meta_valid) {
+            if (!nas_pkt_rx_meta_fill (pkt, pkt_len, p_attr, &pf_rx_meta)) {
+                EV_LOGGING (NAS_PKT_FILTER, DEBUG,"PKT-FIL","Matching index not found for %d:%d",
+                            p_attr->npu_id, p_attr->rx_port);
+            }
+            pf_rx_meta_valid = true;
+        }
+        rx_meta = &pf_rx_meta;
+        rx_ifindex = rx_meta->meta.rx_port;
+    } else if (!nas_int_port_ifindex (p_attr->npu_id, p_attr->rx_port, &rx_ifindex)) {
         EV_LOGGING (NAS_PKT_FILTER, DEBUG,"PKT-FIL","Matching index not found for %d:%d",
                     p_attr->npu_id, p_attr->rx_port);
     }
@@ -267,11 +287,22 @@ bool pf_action::pf_a_redirect_sock(uint8_t *pkt, uint32_t pkt_len, pf_pkt_attr *
     const uint32_t META_BUF_SIZE=1024;
     uint8_t meta_buf [META_BUF_SIZE];
 
+    nas_pkt_meta_fixed_t meta = {};
+    if (rx_meta != nullptr) {
+        meta = rx_meta->meta;
+    } else {
+        meta.rx_port = rx_ifindex;
+        meta.pkt_len = pkt_len;
+        meta.trap_id = p_attr->trap_id;
+        meta.fields = NAS_PKT_META_F_RX_PORT | NAS_PKT_META_F_PKT_LEN | NAS_PKT_META_F_TRAP_ID;
+    }
+    meta.rule_id = pf_rule_id;
+    meta.fields |= NAS_PKT_META_F_RULE_ID;
     nas_pkt_meta_attr_it_t it;
-    nas_pkt_meta_buf_init (meta_buf, sizeof(meta_buf), &it);
-    nas_pkt_meta_add_u32 (&it, NAS_PKT_META_RX_PORT, rx_ifindex);
-    nas_pkt_meta_add_u32 (&it, NAS_PKT_META_PKT_LEN, pkt_len);
-    nas_pkt_meta_add_u64 (&it, NAS_PKT_META_TRAP_ID, p_attr->trap_id);
+    nas_pkt_meta_fixed_encode (meta_buf, sizeof(meta_buf), &meta, &it);
+    if ((rx_meta != nullptr) && (rx_meta->rx_if_name[0] != '\0')) {
+        nas_pkt_meta_add_str (&it, NAS_PKT_META_RX_IF_NAME, rx_meta->rx_if_name);
+    }
 
     size_t meta_len = sizeof(meta_buf) - it.len;
     struct iovec sock_data[] = {{(char*)meta_buf, meta_len}, {pkt, pkt_len} };
@@ -366,7 +397,11 @@ bool nas_pf_egr_enabled () {
 }
 
 bool nas_pf_in_pkt_hndlr(uint8_t *pkt, uint32_t pkt_len, ndi_packet_attr_t *p_attr) {
-    return pf_table_inst->pf_t_in_pkt_hndlr(pkt, pkt_len, p_attr);
+    pf_rx_ingress = true;
+    pf_rx_meta_valid = false;
+    bool stop = pf_table_inst->pf_t_in_pkt_hndlr(pkt, pkt_len, p_attr);
+    pf_rx_ingress = false;
+    return stop;
 }
 
 bool nas_pf_out_pkt_hndlr(uint8_t *pkt, uint32_t pkt_len, ndi_packet_attr_t *p_attr) {
@@ -20,6 +20,11 @@
 
 #include "nas_packet_meta.h"
 
+#include <endian.h>
+#include <pthread.h>
+#include <stddef.h>
+#include <string.h>
+
 static const uint32_t META_SIGNATURE = 0xdeadbeef;
 
 /* Internal packet meta-data header */
@@ -101,3 +106,177 @@ bool nas_pkt_meta_add_u64 (nas_pkt_meta_attr_it_t *it, nas_pkt_meta_attr_type_t
     }
     return false;
 }
+
+bool nas_pkt_meta_add_bin (nas_pkt_meta_attr_it_t *it, nas_pkt_meta_attr_type_t type, const void *data, size_t len)
+{
+    size_t prev_len = it->len;
+    it->attr = std_tlv_add(it->attr, &it->len, type, len, data);
+    if (it->attr != NULL) {
+        nas_pkt_meta_hdr_int_t* meta = (nas_pkt_meta_hdr_int_t*) it->start;
+        meta->total_len += (prev_len - it->len);
+        return true;
+    }
+    return false;
+}
+
+bool nas_pkt_meta_add_str (nas_pkt_meta_attr_it_t *it, nas_pkt_meta_attr_type_t type, const char *str)
+{
+    return nas_pkt_meta_add_bin (it, type, str, strlen (str) + 1);
+}
+
+/* Fields of the fixed layout, in layout order, indexed by their NAS_PKT_META_F_* bit */
+static const struct {
+    nas_pkt_meta_attr_type_t type;
+    size_t                   size;
+    size_t                   off;
+} fixed_fields[] = {
+    {NAS_PKT_META_RX_PORT, sizeof(uint32_t), offsetof(nas_pkt_meta_fixed_t, rx_port)},
+    {NAS_PKT_META_TX_PORT, sizeof(uint32_t), offsetof(nas_pkt_meta_fixed_t, tx_port)},
+    {NAS_PKT_META_PKT_LEN, sizeof(uint32_t), offsetof(nas_pkt_meta_fixed_t, pkt_len)},
+    {NAS_PKT_META_SAMPLE_COUNT, sizeof(uint64_t), offsetof(nas_pkt_meta_fixed_t, sample_count)},
+    {NAS_PKT_META_TRAP_ID, sizeof(uint64_t), offsetof(nas_pkt_meta_fixed_t, trap_id)},
+    {NAS_PKT_META_RX_LAG, sizeof(uint32_t), offsetof(nas_pkt_meta_fixed_t, rx_lag)},
+    {NAS_PKT_META_RX_VLAN, sizeof(uint32_t), offsetof(nas_pkt_meta_fixed_t, rx_vlan)},
+    {NAS_PKT_META_VRF_ID, sizeof(uint32_t), offsetof(nas_pkt_meta_fixed_t, vrf_id)},
+    {NAS_PKT_META_RX_TIMESTAMP, sizeof(uint64_t), offsetof(nas_pkt_meta_fixed_t, rx_timestamp)},
+    {NAS_PKT_META_RULE_ID, sizeof(uint64_t), offsetof(nas_pkt_meta_fixed_t, rule_id)},
+};
+
+#define FIXED_FIELD_MAX  (sizeof(fixed_fields)/sizeof(fixed_fields[0]))
+#define FIXED_HDR_SIZE   64
+
+/* Prebuilt attribute header (type and length) of the layout attribute and of each
+ * field, so encoding only copies headers and stores values */
+static struct {
+    size_t  hdr_len;
+    uint8_t layout_hdr[FIXED_HDR_SIZE];
+    uint8_t field_hdr[FIXED_FIELD_MAX][FIXED_HDR_SIZE];
+} fixed_layout;
+
+static pthread_once_t fixed_layout_once = PTHREAD_ONCE_INIT;
+
+static void _fixed_hdr_init (uint8_t* hdr, nas_pkt_meta_attr_type_t type, size_t size)
+{
+    uint8_t tlv[FIXED_HDR_SIZE + sizeof(uint64_t)];
+    size_t len = sizeof(tlv);
+    uint64_t zero = 0;
+    std_tlv_add (tlv, &len, type, size, &zero);
+    memcpy (hdr, tlv, fixed_layout.hdr_len);
+}
+
+static void _fixed_layout_init (void)
+{
+    uint8_t tlv[FIXED_HDR_SIZE + sizeof(uint32_t)];
+    size_t len = sizeof(tlv);
+    std_tlv_add_u32 (tlv, &len, NAS_PKT_META_LAYOUT, 0);
+    fixed_layout.hdr_len = (uint8_t*)std_tlv_data (tlv) - tlv;
+
+    _fixed_hdr_init (fixed_layout.layout_hdr, NAS_PKT_META_LAYOUT, sizeof(uint32_t));
+    size_t ix;
+    for (ix = 0; ix < FIXED_FIELD_MAX; ++ix) {
+        _fixed_hdr_init (fixed_layout.field_hdr[ix], fixed_fields[ix].type, fixed_fields[ix].size);
+    }
+}
+
+/* Store a field value in the little endian order used by std_tlv */
+static inline void _fixed_store (uint8_t* dst, const uint8_t* src, size_t size)
+{
+    if (size == sizeof(uint64_t)) {
+        uint64_t v = htole64 (*(const uint64_t*)src);
+        memcpy (dst, &v, sizeof(v));
+    } else {
+        uint32_t v = htole32 (*(const uint32_t*)src);
+        memcpy (dst, &v, sizeof(v));
+    }
+}
+
+bool nas_pkt_meta_fixed_encode (uint8_t* buf, size_t buf_len, const nas_pkt_meta_fixed_t* meta,
+                                nas_pkt_meta_attr_it_t* pos)
+{
+    pthread_once (&fixed_layout_once, _fixed_layout_init);
+
+    size_t hdr_len = fixed_layout.hdr_len;
+    size_t len = sizeof(nas_pkt_meta_hdr_int_t) + hdr_len + sizeof(uint32_t);
+    uint32_t fields = meta->fields & ((1 << FIXED_FIELD_MAX) - 1);
+    size_t ix;
+    for (ix = 0; ix < FIXED_FIELD_MAX; ++ix) {
+        if (fields & (1 << ix)) len += hdr_len + fixed_fields[ix].size;
+    }
+    if (buf_len < len) {
+        pos->attr = NULL; pos->len = 0;
+        return false;
+    }
+
+    nas_pkt_meta_hdr_int_t* hdr = (nas_pkt_meta_hdr_int_t*) buf;
+    hdr->signature = META_SIGNATURE;
+    hdr->total_len = htole32 (len);
+
+    uint8_t* cur = hdr->attrs;
+    uint32_t layout = NAS_PKT_META_LAYOUT_V3 | (fields << NAS_PKT_META_LAYOUT_FIELDS_SHIFT);
+    memcpy (cur, fixed_layout.layout_hdr, hdr_len);
+    _fixed_store (cur + hdr_len, (const uint8_t*)&layout, sizeof(layout));
+    cur += hdr_len + sizeof(layout);
+
+    for (ix = 0; ix < FIXED_FIELD_MAX; ++ix) {
+        if (!(fields & (1 << ix))) continue;
+        memcpy (cur, fixed_layout.field_hdr[ix], hdr_len);
+        _fixed_store (cur + hdr_len, (const uint8_t*)meta + fixed_fields[ix].off, fixed_fields[ix].size);
+        cur += hdr_len + fixed_fields[ix].size;
+    }
+
+    pos->start = buf;
+    pos->attr = cur;
+    pos->len = buf_len - len;
+    return true;
+}
+
+static inline uint64_t _attr_data_u64 (nas_pkt_meta_attr_ptr_t attr)
+{
+    if (nas_pkt_meta_attr_len (attr) == sizeof(uint64_t)) return std_tlv_data_u64 (attr);
+    return nas_pkt_meta_attr_data_uint (attr);
+}
+
+bool nas_pkt_meta_fixed_decode (uint8_t* buf, nas_pkt_meta_fixed_t* meta)
+{
+    nas_pkt_meta_attr_it_t it;
+    memset (meta, 0, sizeof(*meta));
+    if (!nas_pkt_meta_it_begin (buf, &it)) return false;
+
+    pthread_once (&fixed_layout_once, _fixed_layout_init);
+    size_t hdr_len = fixed_layout.hdr_len;
+    uint8_t* cur = (uint8_t*)it.attr;
+    uint8_t* end = cur + it.len;
+    if ((it.len >= hdr_len + sizeof(uint32_t)) &&
+        (memcmp (cur, fixed_layout.layout_hdr, hdr_len) == 0) &&
+        ((std_tlv_data_u32 (cur) & NAS_PKT_META_LAYOUT_VERSION_MASK) == NAS_PKT_META_LAYOUT_V3)) {
+        uint32_t fields = std_tlv_data_u32 (cur) >> NAS_PKT_META_LAYOUT_FIELDS_SHIFT;
+        cur += hdr_len + sizeof(uint32_t);
+        size_t ix;
+        for (ix = 0; ix < FIXED_FIELD_MAX; ++ix) {
+            if (!(fields & (1 << ix))) continue;
+            size_t size = fixed_fields[ix].size;
+            if (cur + hdr_len + size > end) return false;
+            uint8_t* dst = (uint8_t*)meta + fixed_fields[ix].off;
+            if (size == sizeof(uint64_t)) *(uint64_t*)dst = std_tlv_data_u64 (cur);
+            else *(uint32_t*)dst = std_tlv_data_u32 (cur);
+            meta->fields |= (1 << ix);
+            cur += hdr_len + size;
+        }
+        return true;
+    }
+
+    /* Not in the fixed layout, walk the attributes */
+    for (; nas_pkt_meta_it_valid (&it); nas_pkt_meta_it_next (&it)) {
+        nas_pkt_meta_attr_type_t type = nas_pkt_meta_attr_type (it.attr);
+        size_t ix;
+        for (ix = 0; ix < FIXED_FIELD_MAX; ++ix) {
+            if (fixed_fields[ix].type != type) continue;
+            uint8_t* dst = (uint8_t*)meta + fixed_fields[ix].off;
+            if (fixed_fields[ix].size == sizeof(uint64_t)) *(uint64_t*)dst = _attr_data_u64 (it.attr);
+            else *(uint32_t*)dst = nas_pkt_meta_attr_data_uint (it.attr);
+            meta->fields |= (1 << ix);
+            break;
+        }
+    }
+    return true;
+}
@@ -33,6 +33,7 @@
 #include "nas_int_port.h"
 #include "nas_packet_meta.h"
 #include "std_socket_tools.h"
+#include "std_utils.h"
 
 #include "cps_class_map.h"
 #include "cps_api_operation.h"
@@ -52,6 +53,7 @@
 #include <stdlib.h>
 #include <errno.h>
 #include <pthread.h>
+#include <time.h>
 
 #define MAX_PKT_LEN        12000
 #define PKT_DBG_ERR        (1)
@@ -131,17 +133,56 @@ static void _sflow_sock_init ()
     }
 }
 
-static t_std_error _sflow_pkt_hdl (uint8_t *pkt, uint32_t pkt_len,
-                                   const ndi_packet_attr_t *p_attr)
+/* Fill the receive context of a packet handed to a meta-data consumer.
+ * A VLAN tag in the packet takes precedence over the untagged VLAN of the port.
+ * Returns false if the rx port has no interface.
+ */
+bool nas_pkt_rx_meta_fill (const uint8_t *pkt, uint32_t pkt_len,
+                           const ndi_packet_attr_t *p_attr, nas_pkt_rx_meta_t *rx_meta)
 {
-    hal_ifindex_t rx_ifindex,tx_ifindex = 0;
-
-    if (!nas_int_port_ifindex (p_attr->npu_id, p_attr->rx_port, &rx_ifindex)) {
-        EV_LOGGING (NAS_PKT_IO, DEBUG, "PKT-IO",
-                 "Interface invalid - no matching port %d:%d",
-                p_attr->npu_id, p_attr->rx_port);
-        return STD_ERR (INTERFACE, PARAM, 0);
+#define PKT_ETHTYPE_OFFSET  12
+#define PKT_VLAN_TCI_END    16
+#define PKT_VLAN_ID_MASK    0xfff
+
+    memset (rx_meta, 0, sizeof (*rx_meta));
+
+    struct timespec ts;
+    clock_gettime (CLOCK_REALTIME, &ts);
+    rx_meta->meta.rx_timestamp = (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+    rx_meta->meta.pkt_len = pkt_len;
+    rx_meta->meta.trap_id = p_attr->trap_id;
+    rx_meta->meta.fields = NAS_PKT_META_F_RX_TIMESTAMP | NAS_PKT_META_F_PKT_LEN |
+                           NAS_PKT_META_F_TRAP_ID;
+
+    nas_int_port_rx_info_t info;
+    bool found = nas_int_port_rx_info (p_attr->npu_id, p_attr->rx_port, &info);
+    if (found) {
+        rx_meta->meta.rx_port = info.ifindex;
+        rx_meta->meta.rx_lag = info.lag_ifindex;
+        rx_meta->meta.rx_vlan = info.untagged_vlan;
+        rx_meta->meta.vrf_id = info.vrf_id;
+        rx_meta->meta.fields |= NAS_PKT_META_F_RX_PORT | NAS_PKT_META_F_VRF_ID;
+        if (info.lag_ifindex != 0) rx_meta->meta.fields |= NAS_PKT_META_F_RX_LAG;
+        if (info.untagged_vlan != 0) rx_meta->meta.fields |= NAS_PKT_META_F_RX_VLAN;
+        safestrncpy (rx_meta->rx_if_name, info.if_name, sizeof (rx_meta->rx_if_name));
+    }
+
+    if (pkt_len >= PKT_VLAN_TCI_END) {
+        uint16_t ethtype = (pkt[PKT_ETHTYPE_OFFSET] << 8) | pkt[PKT_ETHTYPE_OFFSET + 1];
+        if ((ethtype == 0x8100) || (ethtype == 0x88a8)) {
+            rx_meta->meta.rx_vlan = ((pkt[PKT_ETHTYPE_OFFSET + 2] << 8) |
+                                     pkt[PKT_ETHTYPE_OFFSET + 3]) & PKT_VLAN_ID_MASK;
+            rx_meta->meta.fields |= NAS_PKT_META_F_RX_VLAN;
+        }
     }
+    return found;
+}
+
+static t_std_error _sflow_pkt_hdl (uint8_t *pkt, uint32_t pkt_len,
+                                   const ndi_packet_attr_t *p_attr,
+                                   const nas_pkt_rx_meta_t *rx_meta)
+{
+    hal_ifindex_t tx_ifindex = 0;
 
     if (!nas_int_port_ifindex (p_attr->npu_id, p_attr->tx_port, &tx_ifindex)) {
         EV_LOGGING (NAS_PKT_IO, DEBUG, "PKT-IO",
@@ -151,21 +192,24 @@ static t_std_error _sflow_pkt_hdl (uint8_t *pkt, uint32_t pkt_len,
 
     EV_LOGGING (NAS_PKT_IO, DEBUG,"PKT-IO","[RX] SFLOW Pkt received - length %d npu %d rx_ifindex %d"
               " tx_ifindex %d sample count %lu\r\n",
-              pkt_len, p_attr->npu_id, rx_ifindex,tx_ifindex,sample_count);
+              pkt_len, p_attr->npu_id, rx_meta->meta.rx_port,tx_ifindex,sample_count);
 
 #define META_BUF_SIZE  1024
     uint8_t meta_buf [META_BUF_SIZE];
 
-    nas_pkt_meta_attr_it_t it;
-    nas_pkt_meta_buf_init (meta_buf, sizeof(meta_buf), &it);
-    nas_pkt_meta_add_u32 (&it, NAS_PKT_META_RX_PORT, rx_ifindex);
-    nas_pkt_meta_add_u32 (&it, NAS_PKT_META_TX_PORT, tx_ifindex);
-
     /* Increment the sample count and add it as meta data and if it reaches the max value of uint64_t
      * it will start again from 0
      */
-    nas_pkt_meta_add_u64 (&it, NAS_PKT_META_SAMPLE_COUNT, sample_count++);
-    nas_pkt_meta_add_u32 (&it, NAS_PKT_META_PKT_LEN, pkt_len);
+    nas_pkt_meta_fixed_t meta = rx_meta->meta;
+    meta.tx_port = tx_ifindex;
+    meta.sample_count = sample_count++;
+    meta.fields = (meta.fields | NAS_PKT_META_F_TX_PORT | NAS_PKT_META_F_SAMPLE_COUNT) &
+                  ~NAS_PKT_META_F_TRAP_ID;
+    nas_pkt_meta_attr_it_t it;
+    nas_pkt_meta_fixed_encode (meta_buf, sizeof(meta_buf), &meta, &it);
+    if (rx_meta->rx_if_name[0] != '\0') {
+        nas_pkt_meta_add_str (&it, NAS_PKT_META_RX_IF_NAME, rx_meta->rx_if_name);
+    }
 
     // The length field in the iterator gives the remaining length left
     // after filling all meta data attributes
@@ -488,8 +532,18 @@ static t_std_error dn_hal_packet_rx(uint8_t *pkt, uint32_t len, ndi_packet_attr_
     if (PKT_DBG_DUMP(pkt_debug)) hal_packet_io_dump(pkt, len, PKT_DBG_DIR_IN);
     PKT_DEBUG("[RX] on front npu %d port %d len %d",p_attr->npu_id,p_attr->rx_port,len);
 
-    if (p_attr->trap_id == NDI_PACKET_TRAP_ID_SAMPLEPACKET)
-        return _sflow_pkt_hdl (pkt, len, p_attr);
+    /* The receive context is only built for packets that go to a meta-data consumer,
+     * the packet filter builds it when a rule redirects the packet to a socket */
+    if (p_attr->trap_id == NDI_PACKET_TRAP_ID_SAMPLEPACKET) {
+        nas_pkt_rx_meta_t rx_meta;
+        if (!nas_pkt_rx_meta_fill (pkt, len, p_attr, &rx_meta)) {
+            EV_LOGGING (NAS_PKT_IO, DEBUG, "PKT-IO",
+                     "Interface invalid - no matching port %d:%d",
+                    p_attr->npu_id, p_attr->rx_port);
+            return STD_ERR (INTERFACE, PARAM, 0);
+        }
+        return _sflow_pkt_hdl (pkt, len, p_attr, &rx_meta);
+    }
 
     if(nas_pf_ingr_enabled()) {
         bool stop = nas_pf_in_pkt_hndlr(pkt, len, p_attr);
@@ -52,6 +52,7 @@
 #include "interface/nas_interface.h"
 #include "interface/nas_interface_map.h"
 #include "interface/nas_interface_utils.h"
+#include "bridge/nas_interface_vlan_scale.h"
 
 #include "event_log.h"
 #include "std_utils.h"
@@ -64,6 +65,7 @@
 #include <inttypes.h>
 #include <unordered_map>
 #include <list>
+#include <vector>
 
 struct _npu_port_t {
     uint_t npu_id;
@@ -127,6 +129,186 @@ using NasLogicalPortMap = std::unordered_map<_npu_port_t, _port_cache, _npu_port
 static NasLogicalPortMap _logical_port_tbl;
 static std_rw_lock_t _logical_port_lock;
 
+/*
+ * Store of the OS attributes (name, MTU, MAC, admin state ...) of interfaces
+ * indexed by ifindex, so that interface gets are answered from memory instead
+ * of a netlink query per request. It is primed with the full OS interface
+ * list at init and kept in sync from the OS interface events. Entries are
+ * marked stale when NAS changes the interface and are then refreshed from OS
+ * on the next get.
+ */
+typedef struct _os_if_entry {
+    cps_api_object_t obj;
+    bool stale;
+} nas_os_if_entry_t;
+
+static std::unordered_map<hal_ifindex_t, nas_os_if_entry_t> _os_if_store;
+static bool _os_if_store_primed = false;
+static std_mutex_lock_create_static_init_fast(_os_if_store_lock);
+
+/* Must be called with _os_if_store_lock held */
+static void _os_if_store_erase(hal_ifindex_t if_index)
+{
+    auto it = _os_if_store.find(if_index);
+    if (it == _os_if_store.end()) return;
+    cps_api_object_delete(it->second.obj);
+    _os_if_store.erase(it);
+}
+
+/* Must be called with _os_if_store_lock held */
+static void _os_if_store_set(hal_ifindex_t if_index, cps_api_object_t os_if, bool merge)
+{
+    auto it = _os_if_store.find(if_index);
+    if (it != _os_if_store.end()) {
+        if (merge) {
+            cps_api_obj_tool_merge(it->second.obj, os_if);
+        } else {
+            cps_api_object_clone(it->second.obj, os_if);
+        }
+        it->second.stale = false;
+        return;
+    }
+    cps_api_object_t obj = cps_api_object_create();
+    if (obj == nullptr) return;
+    if (!cps_api_object_clone(obj, os_if)) {
+        cps_api_object_delete(obj);
+        return;
+    }
+    _os_if_store[if_index] = {obj, false};
+}
+
+static void nas_int_os_if_store_prime(cps_api_object_list_t os_if_list)
+{
+    std_mutex_simple_lock_guard l(&_os_if_store_lock);
+    size_t mx = cps_api_object_list_size(os_if_list);
+    for (size_t ix = 0; ix < mx; ++ix) {
+        cps_api_object_t os_if = cps_api_object_list_get(os_if_list, ix);
+        cps_api_object_attr_t ifix = cps_api_object_attr_get(os_if,
+                                        DELL_BASE_IF_CMN_IF_INTERFACES_INTERFACE_IF_INDEX);
+        if (ifix == nullptr) continue;
+        hal_ifindex_t if_index = cps_api_object_attr_data_u32(ifix);
+        /* events received meanwhile are more recent than the list */
+        if (_os_if_store.find(if_index) != _os_if_store.end()) continue;
+        _os_if_store_set(if_index, os_if, false);
+    }
+    _os_if_store_primed = true;
+}
+
+void nas_int_os_if_store_update(cps_api_object_t obj)
+{
+    cps_api_object_attr_t ifix = cps_api_object_attr_get(obj,
+                                    DELL_BASE_IF_CMN_IF_INTERFACES_INTERFACE_IF_INDEX);
+    if (ifix == nullptr) return;
+    hal_ifindex_t if_index = cps_api_object_attr_data_u32(ifix);
+    cps_api_operation_types_t op = cps_api_object_type_operation(cps_api_object_key(obj));
+
+    std_mutex_simple_lock_guard l(&_os_if_store_lock);
+    if (op == cps_api_oper_DELETE) {
+        _os_if_store_erase(if_index);
+    } else {
+        _os_if_store_set(if_index, obj, true);
+    }
+}
+
+static void nas_int_os_if_store_invalidate(hal_ifindex_t if_index)
+{
+    std_mutex_simple_lock_guard l(&_os_if_store_lock);
+    auto it = _os_if_store.find(if_index);
+    if (it != _os_if_store.end()) {
+        it->second.stale = true;
+    }
+}
+
+/* Must be called with _os_if_store_lock held */
+static bool _os_if_store_refresh(hal_ifindex_t if_index)
+{
+    cps_api_object_list_guard lg(cps_api_object_list_create());
+    cps_api_object_guard og(cps_api_object_create());
+    if (lg.get() == nullptr || og.get() == nullptr) {
+        return false;
+    }
+    cps_api_object_attr_add_u32(og.get(), DELL_BASE_IF_CMN_IF_INTERFACES_INTERFACE_IF_INDEX, if_index);
+    if (nas_os_get_interface(og.get(), lg.get()) != STD_ERR_OK) {
+        return false;
+    }
+    cps_api_object_t os_if = cps_api_object_list_get(lg.get(), 0);
+    if (cps_api_object_list_size(lg.get()) != 1 || os_if == nullptr) {
+        _os_if_store_erase(if_index);
+        return true;
+    }
+    _os_if_store_set(if_index, os_if, false);
+    return true;
+}
+
+/* Must be called with _os_if_store_lock held */
+static bool _os_if_store_append(hal_ifindex_t if_index, nas_os_if_entry_t& entry,
+                                cps_api_object_list_t list)
+{
+    if (entry.stale && !_os_if_store_refresh(if_index)) {
+        return false;
+    }
+    auto it = _os_if_store.find(if_index);
+    if (it == _os_if_store.end()) {
+        /* interface is gone from OS */
+        return true;
+    }
+    cps_api_object_t obj = cps_api_object_list_create_obj_and_append(list);
+    if (obj == nullptr) return false;
+    return cps_api_object_clone(obj, it->second.obj);
+}
+
+/*
+ * Fill the list with the OS attributes of interfaces matching the filter from
+ * the store. Returns false if the request can't be served from the store, in
+ * which case nothing was added to the list.
+ */
+static bool nas_int_os_if_store_get(hal_ifindex_t *if_index, const char *req_if_type,
+                                    cps_api_object_list_t list)
+{
+    std_mutex_simple_lock_guard l(&_os_if_store_lock);
+    if (!_os_if_store_primed) {
+        return false;
+    }
+
+    if (if_index != nullptr) {
+        auto it = _os_if_store.find(*if_index);
+        if (it == _os_if_store.end()) return false;
+        return _os_if_store_append(*if_index, it->second, list);
+    }
+
+    /* Enumeration is served only for a type filter, filter before cloning */
+    if (req_if_type == nullptr) {
+        return false;
+    }
+    std::vector<hal_ifindex_t> match;
+    char if_type[256];
+    for (auto& it: _os_if_store) {
+        interface_ctrl_t _port;
+        memset(&_port, 0, sizeof(_port));
+        _port.if_index = it.first;
+        _port.q_type = HAL_INTF_INFO_FROM_IF;
+        if (dn_hal_get_interface_info(&_port) != STD_ERR_OK) continue;
+        if (!nas_to_ietf_if_type_get(_port.int_type, if_type, sizeof(if_type))) continue;
+        if (strncmp(if_type, req_if_type, sizeof(if_type)) != 0) continue;
+        match.push_back(it.first);
+    }
+    size_t start = cps_api_object_list_size(list);
+    for (auto ifidx: match) {
+        auto it = _os_if_store.find(ifidx);
+        if (it == _os_if_store.end()) continue;
+        if (!_os_if_store_append(ifidx, it->second, list)) {
+            while (cps_api_object_list_size(list) > start) {
+                size_t last = cps_api_object_list_size(list) - 1;
+                cps_api_object_t obj = cps_api_object_list_get(list, last);
+                cps_api_object_list_remove(list, last);
+                cps_api_object_delete(obj);
+            }
+            return false;
+        }
+    }
+    return true;
+}
+
 static auto _error_string_map_table = new std::unordered_map<int, std::string>
 {
     /* For Error ID's in PRIV object, map SAI Error code to STD Error Codes
@@ -435,6 +617,8 @@ static cps_api_return_code_t if_get (void * context, cps_api_get_params_t * para
                                       DELL_BASE_IF_CMN_IF_INTERFACES_INTERFACE_IF_INDEX);
     cps_api_object_attr_t name = cps_api_get_key_data(filt,IF_INTERFACES_INTERFACE_NAME);
 
+    hal_ifindex_t req_if_index = 0;
+    bool have_if_index = false;
     if (ifix == nullptr && name != NULL) {
         interface_ctrl_t _port;
         if (!if_data_from_obj(obj_INTF, filt,_port)) {
@@ -443,11 +627,19 @@ static cps_api_return_code_t if_get (void * context, cps_api_get_params_t * para
         }
         cps_api_object_attr_add_u32(filt, DELL_BASE_IF_CMN_IF_INTERFACES_INTERFACE_IF_INDEX,
                                     _port.if_index);
+        req_if_index = _port.if_index;
+        have_if_index = true;
+    } else if (ifix != nullptr) {
+        req_if_index = cps_api_object_attr_data_u32(ifix);
+        have_if_index = true;
     }
 
-    if (nas_os_get_interface(filt,param->list)!=STD_ERR_OK) {
-        EV_LOGGING(INTERFACE, ERR, "NAS-INT-GET", "Failed to get interfaces from OS");
-        return cps_api_ret_code_ERR;
+    if (!nas_int_os_if_store_get(have_if_index ? &req_if_index : nullptr, req_if_type,
+                                 param->list)) {
+        if (nas_os_get_interface(filt,param->list)!=STD_ERR_OK) {
+            EV_LOGGING(INTERFACE, ERR, "NAS-INT-GET", "Failed to get interfaces from OS");
+            return cps_api_ret_code_ERR;
+        }
     }
     size_t mx = cps_api_object_list_size(param->list);
     char if_type[256];
@@ -1243,6 +1435,8 @@ static cps_api_return_code_t _if_delete(cps_api_object_t req_if, cps_api_object_
                    _port.if_name);
         return cps_api_ret_code_ERR;
     }
+    nas_int_os_if_store_invalidate(_port.if_index);
+    nas_vlan_scale_member_clear(std::string(_port.if_name));
 
     if (_port.port_mapped) {
         if(_logical_port_tbl_delete(_port.npu_id,_port.port_id) != STD_ERR_OK){
@@ -1376,6 +1570,7 @@ static cps_api_return_code_t _if_update(cps_api_object_t req_if, cps_api_object_
     if (!if_data_from_obj(obj_INTF, req_if,_port)) {
         return cps_api_ret_code_ERR;
     }
+    nas_int_os_if_store_invalidate(_port.if_index);
 
     bool connect = false;
     cps_api_object_attr_t npu_attr = cps_api_object_attr_get(req_if,BASE_IF_PHY_IF_INTERFACES_INTERFACE_NPU_ID);
@@ -1858,6 +2053,7 @@ static void resync_with_os() {
     if (nas_os_get_interface(og.get(),lg.get())!=STD_ERR_OK) {
         return ;
     }
+    nas_int_os_if_store_prime(lg.get());
 
     size_t ix = 0;
     size_t mx = cps_api_object_list_size(lg.get());
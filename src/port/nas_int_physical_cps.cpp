@@ -36,8 +36,10 @@
 #include "event_log.h"
 #include "nas_switch.h"
 #include "nas_interface_fc.h"
+#include "std_mutex_lock.h"
 
 #include <vector>
+#include <map>
 #include <unordered_map>
 
 struct _port_cache {
@@ -52,6 +54,21 @@ static NasPhyPortMap _phy_port;
 
 #define MAX_HWPORT_PER_PORT 10
 
+/*
+ * Index of valid (non CPU) physical ports, maintained from NDI port add/delete
+ * events so that gets resolve to the matching ports without scanning the
+ * whole NPU port space.  Ports are ordered by (npu, port) for enumeration.
+ */
+#define NAS_PHY_HWPORT_INVALID ((uint32_t)-1)
+
+using NasPhyPortKey = std::pair<npu_id_t, port_t>;
+using NasPhyPortIndex = std::map<NasPhyPortKey, uint32_t>;
+using NasHwPortIndex = std::unordered_map<uint32_t, NasPhyPortKey>;
+
+static NasPhyPortIndex _phy_port_idx;
+static NasHwPortIndex _hw_port_idx;
+static std_mutex_lock_create_static_init_fast(_phy_port_idx_lock);
+
 static  cps_api_return_code_t nas_fc_to_eth_speed(BASE_IF_SPEED_t speed, size_t hwp_count, BASE_IF_SPEED_t *npu_speed) {
     switch (speed) {
         case BASE_IF_SPEED_8GFC:
@@ -91,6 +108,104 @@ static bool get_hw_port(npu_id_t npu, port_t port, uint32_t& hwport) {
     return ndi_hwport_list_get(npu, port, &hwport) == STD_ERR_OK;
 }
 
+/* Must be called with _phy_port_idx_lock held */
+static void _phy_port_idx_add(npu_id_t npu, port_t port, uint32_t hwport) {
+    auto it = _phy_port_idx.find(NasPhyPortKey(npu, port));
+    if (it != _phy_port_idx.end()) {
+        if (it->second == hwport) return;
+        auto hw_it = _hw_port_idx.find(it->second);
+        if (hw_it != _hw_port_idx.end() && hw_it->second == it->first) {
+            _hw_port_idx.erase(hw_it);
+        }
+        it->second = hwport;
+    } else {
+        _phy_port_idx[NasPhyPortKey(npu, port)] = hwport;
+    }
+    if (hwport != NAS_PHY_HWPORT_INVALID) {
+        _hw_port_idx[hwport] = NasPhyPortKey(npu, port);
+    }
+}
+
+/* Must be called with _phy_port_idx_lock held */
+static void _phy_port_idx_del(npu_id_t npu, port_t port) {
+    auto it = _phy_port_idx.find(NasPhyPortKey(npu, port));
+    if (it == _phy_port_idx.end()) return;
+
+    auto hw_it = _hw_port_idx.find(it->second);
+    if (hw_it != _hw_port_idx.end() && hw_it->second == it->first) {
+        _hw_port_idx.erase(hw_it);
+    }
+    _phy_port_idx.erase(it);
+}
+
+static void nas_int_phy_port_idx_update(npu_id_t npu, port_t port, bool add) {
+    std_mutex_simple_lock_guard lg(&_phy_port_idx_lock);
+    if (!add) {
+        _phy_port_idx_del(npu, port);
+        return;
+    }
+    if (_is_cpu_port(npu, port)) return;
+
+    uint32_t hwport;
+    if (!get_hw_port(npu, port, hwport)) hwport = NAS_PHY_HWPORT_INVALID;
+    _phy_port_idx_add(npu, port, hwport);
+}
+
+/*
+ * Seed the index with the ports already present on the NPUs.  Called once at
+ * init after the NDI port event callback is registered; the lock is held for
+ * the whole scan so that events raised meanwhile are applied after it.
+ */
+static void nas_int_phy_port_idx_load(void) {
+    std_mutex_simple_lock_guard lg(&_phy_port_idx_lock);
+    npu_id_t npu_max = (npu_id_t)nas_switch_get_max_npus();
+    for (npu_id_t npu = 0; npu < npu_max; ++npu) {
+        unsigned int intf_max_ports = ndi_max_npu_port_get(npu);
+        for (port_t port = 0; port < intf_max_ports; ++port) {
+            if (!ndi_port_is_valid(npu, port) || _is_cpu_port(npu, port)) {
+                continue;
+            }
+            uint32_t hwport;
+            if (!get_hw_port(npu, port, hwport)) hwport = NAS_PHY_HWPORT_INVALID;
+            _phy_port_idx_add(npu, port, hwport);
+        }
+    }
+}
+
+/* Collect the indexed ports matching the optional npu/port/hwport filters */
+static void nas_int_phy_port_idx_match(cps_api_object_attr_t _npu, cps_api_object_attr_t _port,
+        cps_api_object_attr_t _hw_port, std::vector<NasPhyPortKey>& ports) {
+    std_mutex_simple_lock_guard lg(&_phy_port_idx_lock);
+
+    if (_hw_port != NULL) {
+        auto it = _hw_port_idx.find(cps_api_object_attr_data_u32(_hw_port));
+        if (it == _hw_port_idx.end()) return;
+        if (_npu != NULL && cps_api_object_attr_data_u32(_npu) != (uint32_t)it->second.first) return;
+        if (_port != NULL && cps_api_object_attr_data_u32(_port) != it->second.second) return;
+        ports.push_back(it->second);
+        return;
+    }
+
+    if (_npu != NULL && _port != NULL) {
+        NasPhyPortKey key((npu_id_t)cps_api_object_attr_data_u32(_npu),
+                          (port_t)cps_api_object_attr_data_u32(_port));
+        if (_phy_port_idx.find(key) != _phy_port_idx.end()) ports.push_back(key);
+        return;
+    }
+
+    auto it = _phy_port_idx.begin();
+    auto end = _phy_port_idx.end();
+    if (_npu != NULL) {
+        npu_id_t npu = (npu_id_t)cps_api_object_attr_data_u32(_npu);
+        it = _phy_port_idx.lower_bound(NasPhyPortKey(npu, 0));
+        end = _phy_port_idx.lower_bound(NasPhyPortKey(npu + 1, 0));
+    }
+    for ( ; it != end; ++it) {
+        if (_port != NULL && cps_api_object_attr_data_u32(_port) != it->first.second) continue;
+        ports.push_back(it->first);
+    }
+}
+
 static void init_phy_port_obj(npu_id_t npu, port_t port, cps_api_object_t obj) {
     cps_api_key_from_attr_with_qual(cps_api_object_key(obj),
             BASE_IF_PHY_PHYSICAL_OBJ,cps_api_qualifier_TARGET);
@@ -192,37 +307,18 @@ static cps_api_return_code_t _phy_int_get (void * context, cps_api_get_params_t
 
     cps_api_object_t filt = cps_api_object_list_get(param->filters,key_ix);
 
-    npu_id_t npu = 0;
-    npu_id_t npu_max = (npu_id_t)nas_switch_get_max_npus();
-
     cps_api_object_attr_t _npu = cps_api_get_key_data(filt,BASE_IF_PHY_PHYSICAL_NPU_ID);
     cps_api_object_attr_t _port = cps_api_get_key_data(filt,BASE_IF_PHY_PHYSICAL_PORT_ID);
     cps_api_object_attr_t _hw_port = cps_api_get_key_data(filt,BASE_IF_PHY_PHYSICAL_HARDWARE_PORT_ID);
 
-    for ( npu = 0; npu<  npu_max ; ++npu){
-        if (_npu!=NULL && cps_api_object_attr_data_u32(_npu)!=(uint32_t)npu) continue;
-
-        unsigned int intf_max_ports = ndi_max_npu_port_get(npu);
-        for (port_t port = 0; port < intf_max_ports ; ++port ) {
-            if (_port!=NULL && cps_api_object_attr_data_u32(_port)!=port) continue;
-
-            if (_hw_port!=NULL) {
-                uint32_t hwport;
-                if (get_hw_port(npu,port,hwport)) {
-                    if (cps_api_object_attr_data_u32(_hw_port)!=hwport) continue;
-                }
-            }
-
-            // skip invalid port or cpu port
-            if (!ndi_port_is_valid(npu, port) || _is_cpu_port(npu, port)) {
-                continue;
-            }
+    std::vector<NasPhyPortKey> ports;
+    nas_int_phy_port_idx_match(_npu, _port, _hw_port, ports);
 
-            cps_api_object_t o = cps_api_object_list_create_obj_and_append(param->list);
-            if (o==NULL) return cps_api_ret_code_ERR;
+    for (auto& key : ports) {
+        cps_api_object_t o = cps_api_object_list_create_obj_and_append(param->list);
+        if (o==NULL) return cps_api_ret_code_ERR;
 
-            make_phy_port_details(npu,port,o);
-        }
+        make_phy_port_details(key.first,key.second,o);
     }
     return cps_api_ret_code_OK;
 }
@@ -353,6 +449,8 @@ static cps_api_return_code_t _phy_create(cps_api_object_t cur, cps_api_object_t
     _phy_port[hwport].speed = speed;
     _phy_port[hwport].phy_mode = phy_mode;
 
+    nas_int_phy_port_idx_update(npu_id, phy_port_id, true);
+
     make_phy_port_details(npu_id, phy_port_id, cur);
 
     return cps_api_ret_code_OK;
@@ -400,6 +498,8 @@ static cps_api_return_code_t _phy_delete(cps_api_object_t cur, cps_api_object_t
         _phy_port.erase(it);
     }
 
+    nas_int_phy_port_idx_update(npu_id, port_id, false);
+
     return cps_api_ret_code_OK;
 }
 
@@ -430,6 +530,15 @@ static void _ndi_port_event_update_ (ndi_port_t  *ndi_port, ndi_port_event_t eve
 
     if (!(event == ndi_port_ADD || event==ndi_port_DELETE)) return ;
 
+    if (event == ndi_port_ADD) {
+        std_mutex_simple_lock_guard lg(&_phy_port_idx_lock);
+        if (!_is_cpu_port(ndi_port->npu_id, ndi_port->npu_port)) {
+            _phy_port_idx_add(ndi_port->npu_id, ndi_port->npu_port, hwport);
+        }
+    } else {
+        nas_int_phy_port_idx_update(ndi_port->npu_id, ndi_port->npu_port, false);
+    }
+
     cps_api_object_set_type_operation(cps_api_object_key(og.get()),event == ndi_port_ADD ?
         cps_api_oper_CREATE : cps_api_oper_DELETE );
 
@@ -464,6 +573,7 @@ t_std_error nas_int_cps_init(cps_api_operation_handle_t handle) {
         rc = ndi_port_event_cb_register(npu,_ndi_port_event_update_);
         if (rc!=STD_ERR_OK) return rc;
     }
+    nas_int_phy_port_idx_load();
 
     return nas_int_logical_init(handle);
 }
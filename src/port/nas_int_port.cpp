@@ -31,6 +31,8 @@
 #include "dell-base-if-phy.h"
 #include "nas_int_port.h"
 #include "nas_int_utils.h"
+#include "nas_int_com_utils.h"
+#include "interface/nas_interface_id.h"
 
 #include "swp_util_tap.h"
 
@@ -41,6 +43,7 @@
 #include "std_mutex_lock.h"
 #include "std_time_tools.h"
 #include "std_ip_utils.h"
+#include "std_utils.h"
 
 #include <vector>
 #include <stdio.h>
@@ -50,7 +53,10 @@
 #include <event2/event.h>
 #include <event2/thread.h>
 #include <signal.h>
+#include <sys/socket.h>
 #include <unordered_map>
+#include <algorithm>
+#include <chrono>
 
 
 
@@ -58,9 +64,12 @@
 /* num packets to read on fd event */
 #define NAS_PKT_COUNT_TO_READ 10
 /* num packets to read from nflog fd */
-#define NAS_NFLOG_PKT_COUNT_TO_READ 1
+#define NAS_NFLOG_PKT_COUNT_TO_READ 32
 /* invalid port id to indicate virtual interface */
 #define INVALID_PORT_ID    -1
+/* max attempts and max backoff for applying tap link state */
+#define NAS_TAP_LINK_MAX_RETRY     12
+#define NAS_TAP_LINK_MAX_BACKOFF_MS 2048
 
 //Lock for a interface structures
 static std_rw_lock_t ports_lock = PTHREAD_RWLOCK_INITIALIZER;
@@ -75,6 +84,8 @@ private:
     swp_util_tap_descr _dscr=nullptr;
     IF_INTERFACES_STATE_INTERFACE_OPER_STATUS_t _link =
             IF_INTERFACES_STATE_INTERFACE_OPER_STATUS_DOWN;
+    IF_INTERFACES_STATE_INTERFACE_OPER_STATUS_t _desired_link =
+            IF_INTERFACES_STATE_INTERFACE_OPER_STATUS_DOWN;
 public:
 
     virtual bool create(const char *name);
@@ -92,7 +103,12 @@ public:
         return _link;
     }
 
+    /* Record the desired link state, the tap is updated by the reconciler */
     virtual void set_link_state(IF_INTERFACES_STATE_INTERFACE_OPER_STATUS_t state);
+    /* Record and apply the desired link state on the calling thread */
+    virtual void sync_link_state(IF_INTERFACES_STATE_INTERFACE_OPER_STATUS_t state);
+    /* Apply the desired link state to the tap, return false to retry later */
+    virtual bool reconcile_link_state();
 
     hal_ifindex_t ifindex () const;
     bool valid() const { return _used; }
@@ -112,6 +128,8 @@ public:
     virtual void init() override {}
     virtual bool del() override {return true;}
     virtual void set_link_state(IF_INTERFACES_STATE_INTERFACE_OPER_STATUS_t state) override {}
+    virtual void sync_link_state(IF_INTERFACES_STATE_INTERFACE_OPER_STATUS_t state) override {}
+    virtual bool reconcile_link_state() override {return true;}
 };
 
 class NasPortList {
@@ -126,6 +144,10 @@ public:
     }
     void resize(size_t npus) {port_id_info_list.resize(npus);}
     void erase(std::string name) {port_name_info_map.erase(name);}
+    CNasPortDetails* find(const std::string& name) {
+        auto iter = port_name_info_map.find(name);
+        return iter == port_name_info_map.end() ? nullptr : &iter->second;
+    }
     CNasPortDetails* dummy_port() {return _dummy_port;}
     const CNasPortDetails& operator[](std::string name) const;
     CNasPortDetails& operator[](std::string name) {return port_name_info_map[name];}
@@ -171,14 +193,145 @@ typedef struct _nas_vif_pkt_tx_t {
     struct event *nas_nflog_fd_ev;     // nflog fd event struct
     int nas_nflog_fd;                  // fd for packet copy thru nflog
     _fd_to_event_info_map_t _tap_fd_to_event_info_map; //fd to event base info
+    struct event *nas_tap_link_ev;     // timer event for tap link reconciliation
 } nas_vif_pkt_tx_t;
 
 nas_vif_pkt_tx_t g_vif_pkt_tx; //global virtual interface packet tx information
 
 static int     nas_nflog_pkts_tx_to_ingress_pipeline = 0;
 static int     nas_nflog_pkts_tx_to_ingress_pipeline_dropped = 0;
-uint8_t        dest_ipv4_from_last_pkt[4];
-static struct timespec ts_last_pkt_sent = {0,0};
+
+/*
+ * ARP duplicate suppression for packets copied from kernel thru nflog.
+ * Kernel replicates an ARP request for every member port of the bridge, and
+ * all copies are injected to the ingress pipeline which floods to the same
+ * members again. Requests are rate limited per (ifindex, target ip) to
+ * NAS_ARP_SUPPR_MAX_PER_WINDOW within NAS_ARP_SUPPR_WINDOW_MS. Entries are
+ * aged out thru a timer wheel once idle for NAS_ARP_SUPPR_IDLE_MS, and the
+ * table is bounded; when full, requests to new targets are not suppressed.
+ */
+#define NAS_ARP_SUPPR_WINDOW_MS       1000
+#define NAS_ARP_SUPPR_MAX_PER_WINDOW  1
+#define NAS_ARP_SUPPR_IDLE_MS         5000
+#define NAS_ARP_SUPPR_TICK_MS         250
+#define NAS_ARP_SUPPR_WHEEL_SLOTS     32
+#define NAS_ARP_SUPPR_MAX_ENTRIES     4096
+
+class NasArpSuppressTable {
+private:
+    struct entry_t {
+        uint64_t window_start_ms;
+        uint64_t expire_tick;
+        uint32_t in_window;
+        uint32_t sent;
+        uint32_t suppressed;
+    };
+    std::unordered_map<uint64_t, entry_t> _entries;
+    std::vector<std::vector<uint64_t>> _wheel;
+    uint64_t _cur_tick = 0;
+    uint32_t _untracked = 0;
+    uint32_t _aged = 0;
+
+    static uint64_t make_key(hal_ifindex_t ifindex, const uint8_t *ip) {
+        uint32_t ipv4;
+        memcpy(&ipv4, ip, sizeof(ipv4));
+        return (((uint64_t)(uint32_t)ifindex) << 32) | ipv4;
+    }
+
+    void schedule(uint64_t key, entry_t& entry) {
+        uint64_t ticks = (NAS_ARP_SUPPR_IDLE_MS + NAS_ARP_SUPPR_TICK_MS - 1) /
+                         NAS_ARP_SUPPR_TICK_MS;
+        entry.expire_tick = _cur_tick + ticks;
+        _wheel[entry.expire_tick % NAS_ARP_SUPPR_WHEEL_SLOTS].push_back(key);
+    }
+
+    /* Age out entries of all slots passed since last advance */
+    void advance(uint64_t now_ms) {
+        uint64_t now_tick = now_ms / NAS_ARP_SUPPR_TICK_MS;
+        if (_cur_tick == 0 || now_tick < _cur_tick) {
+            _cur_tick = now_tick;
+            return;
+        }
+        uint64_t steps = now_tick - _cur_tick;
+        if (steps > NAS_ARP_SUPPR_WHEEL_SLOTS) {
+            steps = NAS_ARP_SUPPR_WHEEL_SLOTS;
+        }
+        for (uint64_t ix = 1; ix <= steps; ++ix) {
+            auto& slot = _wheel[(_cur_tick + ix) % NAS_ARP_SUPPR_WHEEL_SLOTS];
+            for (auto key: slot) {
+                auto it = _entries.find(key);
+                /* skip stale reference of an entry refreshed into later slot */
+                if (it == _entries.end() || it->second.expire_tick > now_tick) continue;
+                _entries.erase(it);
+                ++_aged;
+            }
+            slot.clear();
+        }
+        _cur_tick = now_tick;
+    }
+
+public:
+    NasArpSuppressTable() : _wheel(NAS_ARP_SUPPR_WHEEL_SLOTS) {}
+
+    /* Return true if the ARP request should be sent, false if suppressed */
+    bool allow(hal_ifindex_t ifindex, const uint8_t *target_ip, uint64_t now_ms) {
+        advance(now_ms);
+
+        uint64_t key = make_key(ifindex, target_ip);
+        auto it = _entries.find(key);
+        if (it == _entries.end()) {
+            if (_entries.size() >= NAS_ARP_SUPPR_MAX_ENTRIES) {
+                ++_untracked;
+                return true;
+            }
+            entry_t& entry = _entries[key];
+            entry.window_start_ms = now_ms;
+            entry.in_window = 1;
+            entry.sent = 1;
+            entry.suppressed = 0;
+            schedule(key, entry);
+            return true;
+        }
+
+        entry_t& entry = it->second;
+        schedule(key, entry);
+        if (now_ms - entry.window_start_ms >= NAS_ARP_SUPPR_WINDOW_MS) {
+            entry.window_start_ms = now_ms;
+            entry.in_window = 0;
+        }
+        if (entry.in_window >= NAS_ARP_SUPPR_MAX_PER_WINDOW) {
+            ++entry.suppressed;
+            return false;
+        }
+        ++entry.in_window;
+        ++entry.sent;
+        return true;
+    }
+
+    void clear() {
+        _entries.clear();
+        for (auto& slot: _wheel) slot.clear();
+        _untracked = 0;
+        _aged = 0;
+    }
+
+    void dump() const {
+        printf("\rARP suppression entries : %lu (max %d)\r\n",
+               (unsigned long)_entries.size(), NAS_ARP_SUPPR_MAX_ENTRIES);
+        printf("\rEntries aged out        : %u\r\n", _aged);
+        printf("\rUntracked (table full)  : %u\r\n", _untracked);
+        for (auto& it: _entries) {
+            uint32_t ipv4 = (uint32_t)(it.first & 0xffffffff);
+            const uint8_t *ip = (const uint8_t *)&ipv4;
+            printf("\rifindex %-6d target %d.%d.%d.%d sent %u suppressed %u\r\n",
+                   (int)(it.first >> 32), ip[0], ip[1], ip[2], ip[3],
+                   it.second.sent, it.second.suppressed);
+        }
+    }
+};
+
+static NasArpSuppressTable& _arp_suppr_tbl = *new NasArpSuppressTable();
+static std_mutex_lock_create_static_init_fast(arp_suppr_lock);
 
 typedef struct _arp_header {
     uint16_t htype;
@@ -196,6 +349,51 @@ typedef struct _arp_header {
 void process_packets (evutil_socket_t fd, short evt, void *arg);
 void process_nflog_packets (evutil_socket_t fd, short evt, void *arg);
 
+/*
+ * Tap link state reconciliation. Link changes only record the desired state
+ * and queue the tap here; the state is applied from a timer on the packet
+ * event loop, so that a busy kernel does not stall the oper state callback.
+ * Failed attempts are retried with an exponential backoff timer.
+ */
+typedef struct {
+    size_t retry;
+    uint64_t next_try_ms;
+} nas_tap_link_pending_t;
+
+static std::unordered_map<std::string, nas_tap_link_pending_t> _tap_link_pending;
+static std_mutex_lock_create_static_init_fast(tap_link_lock);
+
+static uint64_t nas_tap_link_now_ms()
+{
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000) + (ts.tv_nsec / 1000000);
+}
+
+/* Must be called with tap_link_lock held */
+static void nas_tap_link_timer_arm(uint64_t delay_ms)
+{
+    if (g_vif_pkt_tx.nas_tap_link_ev == NULL) {
+        /* picked up once the packet event loop is started */
+        return;
+    }
+    struct timeval tv;
+    tv.tv_sec = delay_ms / 1000;
+    tv.tv_usec = (delay_ms % 1000) * 1000;
+    event_add(g_vif_pkt_tx.nas_tap_link_ev, &tv);
+}
+
+static void nas_tap_link_request(const char *name)
+{
+    std_mutex_simple_lock_guard l(&tap_link_lock);
+    nas_tap_link_pending_t& pending = _tap_link_pending[name];
+    pending.retry = 0;
+    pending.next_try_ms = 0;
+    nas_tap_link_timer_arm(0);
+}
+
+static void nas_tap_link_reconcile_cb(evutil_socket_t fd, short evt, void *arg);
+
 /* Add the tap fd to event info map */
 t_std_error nas_add_fd_to_evt_info_map (int fd, struct event *fd_evt)
 {
@@ -326,31 +524,19 @@ static bool tap_link_up(swp_util_tap_descr tap, CNasPortDetails *npu) {
     tap_fd_deregister_from_evt (tap);
     tap_fd_close(tap);
 
-    size_t retry = 0;
-    const size_t MAX_RETRY = 12;
-    bool success = false;
-    for ( ; retry < MAX_RETRY ; ++retry ) {
-        if (swp_util_alloc_tap(tap,SWP_UTIL_TYPE_TAP)!=STD_ERR_OK) {
-            EV_LOGGING(INTERFACE,ERR,"INT-LINK",
-                    "Can not bring the link up %s had issues opening device (%lu)",
-                    swp_util_tap_descr_get_name(tap),retry);
-            std_usleep(MILLI_TO_MICRO((1<<retry)));
-            continue;
-        }
-        if (tap_fd_register_with_evt(tap, npu) != STD_ERR_OK) {
-            EV_LOGGING(INTERFACE,ERR,"INT-LINK",
-                    "Can not bring the link up %s had issues in registering device fd with event handler (%lu)",
-                    swp_util_tap_descr_get_name(tap),retry);
-            //on event reg failure, deregister fd from event poll for already registered fd's and retry
-            tap_fd_deregister_from_evt (tap);
-            tap_fd_close(tap);
-            std_usleep(MILLI_TO_MICRO((1<<retry)));
-            continue;
-        }
-        success = true;
-        break;
+    if (swp_util_alloc_tap(tap,SWP_UTIL_TYPE_TAP)!=STD_ERR_OK) {
+        EV_LOGGING(INTERFACE,ERR,"INT-LINK",
+                "Can not bring the link up %s had issues opening device",
+                swp_util_tap_descr_get_name(tap));
+        return false;
     }
-    if (!success) {
+    if (tap_fd_register_with_evt(tap, npu) != STD_ERR_OK) {
+        EV_LOGGING(INTERFACE,ERR,"INT-LINK",
+                "Can not bring the link up %s had issues in registering device fd with event handler",
+                swp_util_tap_descr_get_name(tap));
+        //on event reg failure, deregister fd from event poll for already registered fd's
+        tap_fd_deregister_from_evt (tap);
+        tap_fd_close(tap);
         return false;
     }
     EV_LOG(TRACE,INTERFACE,0,"INT-LINK", "Link up %s ",swp_util_tap_descr_get_name(tap));
@@ -390,7 +576,7 @@ CNasPortDetails::~CNasPortDetails() {
 bool CNasPortDetails::del() {
     _used = false;
     if (_dscr==nullptr) return true;
-    set_link_state(IF_INTERFACES_STATE_INTERFACE_OPER_STATUS_DOWN);
+    sync_link_state(IF_INTERFACES_STATE_INTERFACE_OPER_STATUS_DOWN);
 
     tap_delete(_dscr);
 
@@ -406,14 +592,26 @@ bool CNasPortDetails::create(const char *name) {
 }
 
 void CNasPortDetails::set_link_state(IF_INTERFACES_STATE_INTERFACE_OPER_STATUS_t state)  {
-    if (_dscr == nullptr || _link == state) return;
-    if (state == IF_INTERFACES_STATE_INTERFACE_OPER_STATUS_UP) {
-        if (tap_link_up(_dscr, this)) _link=state;
-    }
-    if (state == IF_INTERFACES_STATE_INTERFACE_OPER_STATUS_DOWN) {
+    if (_dscr == nullptr) return;
+    _desired_link = state;
+    nas_tap_link_request(swp_util_tap_descr_get_name(_dscr));
+}
+
+void CNasPortDetails::sync_link_state(IF_INTERFACES_STATE_INTERFACE_OPER_STATUS_t state)  {
+    if (_dscr == nullptr) return;
+    _desired_link = state;
+    reconcile_link_state();
+}
+
+bool CNasPortDetails::reconcile_link_state()  {
+    if (_dscr == nullptr || _link == _desired_link) return true;
+    if (_desired_link == IF_INTERFACES_STATE_INTERFACE_OPER_STATUS_UP) {
+        if (!tap_link_up(_dscr, this)) return false;
+    } else {
         tap_link_down(_dscr);
-        _link = state;
     }
+    _link = _desired_link;
+    return true;
 }
 
 hal_ifindex_t CNasPortDetails::ifindex() const{
@@ -422,6 +620,57 @@ hal_ifindex_t CNasPortDetails::ifindex() const{
 }
 
 
+/*
+ * Timer callback on the packet event loop applying the desired link state of
+ * all queued taps which are due.
+ */
+static void nas_tap_link_reconcile_cb(evutil_socket_t fd, short evt, void *arg)
+{
+    std::vector<std::string> due;
+    uint64_t now_ms = nas_tap_link_now_ms();
+    {
+        std_mutex_simple_lock_guard l(&tap_link_lock);
+        for (auto& it: _tap_link_pending) {
+            if (it.second.next_try_ms <= now_ms) due.push_back(it.first);
+        }
+    }
+
+    std_rw_lock_write_guard l(&ports_lock);
+    std_mutex_simple_lock_guard ll(&tap_link_lock);
+    for (auto& name: due) {
+        auto pending = _tap_link_pending.find(name);
+        if (pending == _tap_link_pending.end()) continue;
+        if (pending->second.next_try_ms > now_ms) {
+            /* re-queued by a new link change meanwhile */
+            continue;
+        }
+
+        CNasPortDetails *port = _ports.find(name);
+        if (port == nullptr || !port->valid() || port->reconcile_link_state()) {
+            _tap_link_pending.erase(pending);
+            continue;
+        }
+        if (++pending->second.retry >= NAS_TAP_LINK_MAX_RETRY) {
+            EV_LOGGING(INTERFACE,ERR,"INT-LINK",
+                    "Giving up link state update of %s after %lu attempts",
+                    name.c_str(), pending->second.retry);
+            _tap_link_pending.erase(pending);
+            continue;
+        }
+        uint64_t backoff = std::min<uint64_t>(1 << pending->second.retry,
+                                              NAS_TAP_LINK_MAX_BACKOFF_MS);
+        pending->second.next_try_ms = now_ms + backoff;
+    }
+
+    if (_tap_link_pending.empty()) return;
+
+    uint64_t next_try_ms = _tap_link_pending.begin()->second.next_try_ms;
+    for (auto& it: _tap_link_pending) {
+        next_try_ms = std::min(next_try_ms, it.second.next_try_ms);
+    }
+    nas_tap_link_timer_arm(next_try_ms > now_ms ? next_try_ms - now_ms : 0);
+}
+
 // Our signal handler function callback. Cleans up all the resources and
 // breaks the event loop.
 void nas_evt_signal_cb (evutil_socket_t sig_num, short evt, void *arg)
@@ -439,6 +688,12 @@ void nas_evt_signal_cb (evutil_socket_t sig_num, short evt, void *arg)
         event_del(nas_fd_ev);
         event_free(nas_fd_ev);
     }
+    {
+        std_mutex_simple_lock_guard l(&tap_link_lock);
+        event_del (g_vif_pkt_tx.nas_tap_link_ev);
+        event_free (g_vif_pkt_tx.nas_tap_link_ev);
+        g_vif_pkt_tx.nas_tap_link_ev = NULL;
+    }
     //@@TODO de-init nas_nflog_fd
     event_del (g_vif_pkt_tx.nas_nflog_fd_ev);
     event_free (g_vif_pkt_tx.nas_nflog_fd_ev);
@@ -450,9 +705,9 @@ void nas_evt_signal_cb (evutil_socket_t sig_num, short evt, void *arg)
 }
 
 int nas_process_payload_and_form_packet (uint8_t *pkt_buf,
-                                         nas_nflog_params_t *p_nas_nflog_params)
+                                         nas_nflog_params_t *p_nas_nflog_params,
+                                         uint64_t now_ms)
 {
-#define NSEC_PER_SEC 1000000000
     int               pkt_len = 0;
     uint16_t          vlan_id = 0;
     static const uint16_t          vlan_protocol = htons (0x8100);
@@ -461,8 +716,6 @@ int nas_process_payload_and_form_packet (uint8_t *pkt_buf,
     static const unsigned char     dest_mac[6] = {0xff, 0xff, 0xff, 0xff, 0xff, 0xff};
     interface_ctrl_t  intf_ctrl;
     arp_header_t      *p_arp_header = NULL;
-    struct timespec   ts_cur_pkt;
-    struct timespec   ts_diff;
 
 //@@TODO handle for ipv6 ND
 
@@ -493,36 +746,18 @@ int nas_process_payload_and_form_packet (uint8_t *pkt_buf,
         return -1;
     }
 
-    clock_gettime (CLOCK_MONOTONIC, &ts_cur_pkt);
-
-    ts_diff.tv_nsec = (ts_cur_pkt.tv_nsec - ts_last_pkt_sent.tv_nsec);
-    ts_diff.tv_sec = (ts_cur_pkt.tv_sec - ts_last_pkt_sent.tv_sec);
-
-    while (ts_diff.tv_nsec >= NSEC_PER_SEC)
-    {
-        ts_diff.tv_nsec -= NSEC_PER_SEC;
-        ++ts_diff.tv_sec;
-    }
-    while (ts_diff.tv_nsec < 0)
-    {
-        ts_diff.tv_nsec += NSEC_PER_SEC;
-        --ts_diff.tv_nsec;
-    }
-
-    /* For ARP requests, check the following and drop the packets by returning length as 0:
-     * 1) check if the target-ip of this ARP request and previous ARP request is same
-     * 2) check if the time elapsed between two ARP request packet for same destination
-     *    less than a second,
-     * if yes, then drop this packet as this could be a copy that Kernel replicated
-     * for other VLAN member ports in the bridge.
+    /* For ARP requests, drop the packet by returning length as 0 if a request
+     * for the same target on the same interface was sent within the suppression
+     * window, as this could be a copy that Kernel replicated for other VLAN
+     * member ports in the bridge.
      */
-    if ((memcmp (&dest_ipv4_from_last_pkt, &p_arp_header->target_ip, 4) == 0) &&
-        (ts_diff.tv_sec < 1))
     {
-        return 0;
+        std_mutex_simple_lock_guard l(&arp_suppr_lock);
+        if (!_arp_suppr_tbl.allow(p_nas_nflog_params->out_ifindex,
+                                  p_arp_header->target_ip, now_ms)) {
+            return 0;
+        }
     }
-    ts_last_pkt_sent = ts_cur_pkt;
-    memcpy (&dest_ipv4_from_last_pkt, &p_arp_header->target_ip, 4);
 
     memcpy ((pkt_buf + pkt_len), &dest_mac, 6);
     pkt_len += 6;
@@ -560,13 +795,18 @@ void process_nflog_packets (evutil_socket_t fd, short evt, void *arg)
     int pkt_len = 0;
     int pkt_count = 0;
     nas_nflog_params_t nflog_params;
+    struct timespec ts_now;
 
-    /* event is received in level-triggered mode,
-     * so read data as required and w/o starving other ports
+    /* one timestamp is good enough for the whole batch */
+    clock_gettime (CLOCK_MONOTONIC, &ts_now);
+    uint64_t now_ms = ((uint64_t)ts_now.tv_sec * 1000) + (ts_now.tv_nsec / 1000000);
+
+    /* event is received in level-triggered mode, so drain up to a batch
+     * of messages w/o blocking and w/o starving other ports
      */
     while (pkt_count < NAS_NFLOG_PKT_COUNT_TO_READ)
     {
-        pkt_len = read(fd, g_vif_pkt_tx.tx_buf, g_vif_pkt_tx.tx_buf_len);
+        pkt_len = recv(fd, g_vif_pkt_tx.tx_buf, g_vif_pkt_tx.tx_buf_len, MSG_DONTWAIT);
 
         if (pkt_len <=0)
         {
@@ -582,7 +822,7 @@ void process_nflog_packets (evutil_socket_t fd, short evt, void *arg)
                                     pkt_len, &nflog_params);
 
         pkt_len = nas_process_payload_and_form_packet ((uint8_t *) g_vif_pkt_tx.tx_buf,
-                                                       &nflog_params);
+                                                       &nflog_params, now_ms);
 
         /* send packet for transmission to ingress pipeline processing
          * to the registered callback function with registered packet buffer
@@ -664,6 +904,7 @@ t_std_error hal_virtual_interface_wait (hal_virt_pkt_transmit tx_fun,
     g_vif_pkt_tx.nas_signal_event = NULL;
     g_vif_pkt_tx.nas_nflog_fd_ev = NULL;
     g_vif_pkt_tx.nas_nflog_fd = -1;
+    g_vif_pkt_tx.nas_tap_link_ev = NULL;
 
     g_vif_pkt_tx.egress_tx_cb = tx_fun;
     g_vif_pkt_tx.tx_to_ingress_fun = tx_to_ingress_fun;
@@ -709,6 +950,24 @@ t_std_error hal_virtual_interface_wait (hal_virt_pkt_transmit tx_fun,
     }
 
 
+    /* initialize timer event for tap link state reconciliation and pick up
+     * link changes requested before the event loop was started
+     */
+    {
+        std_mutex_simple_lock_guard l(&tap_link_lock);
+        g_vif_pkt_tx.nas_tap_link_ev = evtimer_new(g_vif_pkt_tx.nas_evt_base,
+                                                   nas_tap_link_reconcile_cb, NULL);
+        if (!g_vif_pkt_tx.nas_tap_link_ev) {
+            EV_LOGGING(INTERFACE,ERR,"TAP-TX", "NAS tap link timer event create failed.");
+            event_del (g_vif_pkt_tx.nas_nflog_fd_ev);
+            event_free (g_vif_pkt_tx.nas_nflog_fd_ev);
+            return STD_ERR(INTERFACE,FAIL,0);
+        }
+        if (!_tap_link_pending.empty()) {
+            nas_tap_link_timer_arm(0);
+        }
+    }
+
     /* initialize event for sigint */
     g_vif_pkt_tx.nas_signal_event = event_new (g_vif_pkt_tx.nas_evt_base, SIGINT,
                     EV_SIGNAL | EV_PERSIST, nas_evt_signal_cb, (void *)&g_vif_pkt_tx);
@@ -803,6 +1062,86 @@ bool nas_int_port_ifindex (npu_id_t npu, port_t port, hal_ifindex_t *ifindex) {
     return true;
 }
 
+/*
+ * Receive context of the ports seen by a packet thread. An entry is reused while the
+ * port keeps its ifindex and no LAG or VLAN membership changed, and for at most
+ * NAS_INT_PORT_RX_INFO_MAX_AGE_MS so name, VRF and VLAN id updates are picked up.
+ */
+#define NAS_INT_PORT_RX_INFO_MAX_AGE_MS 1000
+
+struct nas_int_port_rx_cache_entry {
+    uint64_t                 master_gen;
+    std::chrono::steady_clock::time_point time_stamp;
+    nas_int_port_rx_info_t   info;
+};
+
+static thread_local std::unordered_map<uint64_t, nas_int_port_rx_cache_entry> _rx_info_cache;
+
+static void nas_int_port_rx_info_get (nas_int_port_rx_info_t *info) {
+    interface_ctrl_t intf_ctrl;
+    memset(&intf_ctrl, 0, sizeof(intf_ctrl));
+    intf_ctrl.q_type = HAL_INTF_INFO_FROM_IF;
+    intf_ctrl.if_index = info->ifindex;
+    if (dn_hal_get_interface_info(&intf_ctrl) == STD_ERR_OK) {
+        safestrncpy(info->if_name, intf_ctrl.if_name, sizeof(info->if_name));
+        info->vrf_id = intf_ctrl.vrf_id;
+    }
+
+    /* LAG membership is in the master table too, so the LAG lock is not needed */
+    nas_intf_master_find(info->ifindex, [info](const if_master_info_t &m_info) {
+        if (m_info.type == nas_int_type_LAG) {
+            info->lag_ifindex = m_info.m_if_idx;
+            return true;
+        }
+        return false;
+    });
+
+    hal_ifindex_t vlan_ifindex = 0;
+    nas_intf_master_find(info->lag_ifindex ? info->lag_ifindex : info->ifindex,
+                         [&vlan_ifindex](const if_master_info_t &m_info) {
+        if ((m_info.type == nas_int_type_VLAN) && (m_info.mode == NAS_PORT_UNTAGGED)) {
+            vlan_ifindex = m_info.m_if_idx;
+            return true;
+        }
+        return false;
+    });
+    if (vlan_ifindex != 0) {
+        memset(&intf_ctrl, 0, sizeof(intf_ctrl));
+        intf_ctrl.q_type = HAL_INTF_INFO_FROM_IF;
+        intf_ctrl.if_index = vlan_ifindex;
+        if (dn_hal_get_interface_info(&intf_ctrl) == STD_ERR_OK) {
+            info->untagged_vlan = intf_ctrl.vlan_id;
+        }
+    }
+}
+
+/*
+ * Collect the receive context of a port for the packet meta-data: name, VRF, LAG and
+ * untagged VLAN, so packet consumers do not have to look them up per packet.
+ */
+bool nas_int_port_rx_info (npu_id_t npu, port_t port, nas_int_port_rx_info_t *info) {
+    hal_ifindex_t ifindex;
+    if (!nas_int_port_ifindex(npu, port, &ifindex)) {
+        return false;
+    }
+
+    /* Read the generation first, a change made during the lookup below then
+     * invalidates the entry it fills */
+    uint64_t master_gen = nas_intf_master_gen();
+    auto now = std::chrono::steady_clock::now();
+    auto &entry = _rx_info_cache[((uint64_t)npu << 32) | (uint32_t)port];
+    if ((entry.info.ifindex != ifindex) || (entry.master_gen != master_gen) ||
+        (now - entry.time_stamp > std::chrono::milliseconds(NAS_INT_PORT_RX_INFO_MAX_AGE_MS))) {
+        memset(&entry.info, 0, sizeof(entry.info));
+        entry.info.ifindex = ifindex;
+        nas_int_port_rx_info_get(&entry.info);
+        entry.master_gen = master_gen;
+        entry.time_stamp = now;
+    }
+    *info = entry.info;
+    return true;
+}
+
 void nas_int_port_link_change(npu_id_t npu, port_t port,
                               IF_INTERFACES_STATE_INTERFACE_OPER_STATUS_t state) {
     std_rw_lock_write_guard l(&ports_lock);
@@ -901,6 +1240,7 @@ t_std_error nas_int_port_delete(const char *name) {
                        name);
             return STD_ERR(INTERFACE,FAIL,0);
         }
+        nas_intf_id_invalidate(name);
     }
 
     if (port_info.mapped()) {
@@ -950,12 +1290,18 @@ void nas_nflog_dbg_counters ()
            nas_nflog_pkts_tx_to_ingress_pipeline);
     printf("\rTotal flood packets dropped                   : %d\r\n",
            nas_nflog_pkts_tx_to_ingress_pipeline_dropped);
+
+    std_mutex_simple_lock_guard l(&arp_suppr_lock);
+    _arp_suppr_tbl.dump();
 }
 
 void nas_nflog_dbg_reset_counters ()
 {
     nas_nflog_pkts_tx_to_ingress_pipeline = 0;
     nas_nflog_pkts_tx_to_ingress_pipeline_dropped = 0;
+
+    std_mutex_simple_lock_guard l(&arp_suppr_lock);
+    _arp_suppr_tbl.clear();
 }
 
 static t_std_error update_if_reg_info(const char *name, npu_id_t npu, port_t port,
@@ -1002,6 +1348,8 @@ static t_std_error update_if_reg_info(const char *name, npu_id_t npu, port_t por
                    name);
         return STD_ERR(INTERFACE, FAIL, 0);
     }
+    /* NPU port changed, drop the cached port id of the interface */
+    nas_intf_id_invalidate(name);
 
     return STD_ERR_OK;
 }
@@ -1040,7 +1388,7 @@ t_std_error nas_int_update_npu_port(const char *name, npu_id_t npu, port_t port,
                         ndi_to_cps_oper_type(link_state.oper_status);
         _ports[npu][port]->set_link_state(state);
     } else {
-        _ports[npu][port]->set_link_state(IF_INTERFACES_STATE_INTERFACE_OPER_STATUS_DOWN);
+        _ports[npu][port]->sync_link_state(IF_INTERFACES_STATE_INTERFACE_OPER_STATUS_DOWN);
         _ports[name].init();
         _ports[npu][port] = _ports.dummy_port();
 
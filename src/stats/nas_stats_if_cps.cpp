@@ -200,6 +200,7 @@ static bool get_stats(hal_ifindex_t ifindex, cps_api_object_list_t list){
                           stat_values,max_port_stat_id) != STD_ERR_OK) {
         return false;
     }
+    nas_stats_shm_update(ifindex, intf_ctrl.if_name, stat_values, max_port_stat_id);
 
     for(unsigned int ix = 0 ; ix < max_port_stat_id ; ++ix ){
         cps_api_object_attr_add_u64(obj, if_stat_ids->at(ix), stat_values[ix]);
@@ -481,5 +482,12 @@ t_std_error nas_stats_if_init(cps_api_operation_handle_t handle) {
         return STD_ERR(INTERFACE,FAIL,0);
     }
 
+    if (nas_stats_shm_init(if_stat_ids->data(), if_stat_ids->size()) != STD_ERR_OK) {
+        EV_LOGGING (NAS_INT_STATS, ERR,"NAS-STATS-INIT", "Interface stats shared memory export not available");
+    }
+    if (nas_stats_stream_init(handle, if_stat_ids->data(), if_stat_ids->size()) != STD_ERR_OK) {
+        EV_LOGGING (NAS_INT_STATS, ERR,"NAS-STATS-INIT", "Interface stats streaming not available");
+    }
+
     return STD_ERR_OK;
 }
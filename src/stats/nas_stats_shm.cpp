@@ -0,0 +1,302 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+
+/*
+ * filename: nas_stats_shm.cpp
+ *
+ * Writer of the interface statistics shared memory table, see nas_stats_shm.h.
+ * The port counters are stored whenever a statistics get reads them and, if the
+ * sampler is configured in nas_stats_shm.xml, read for all ports every sampler
+ * interval, so readers never trigger NPU reads themselves.
+ * The sampler and statistics streaming read the port counters through the table,
+ * a port read by one of them recently enough is not read again by the other.
+ */
+
+#include "nas_stats.h"
+#include "nas_stats_shm.h"
+#include "hal_if_mapping.h"
+#include "nas_ndi_port.h"
+#include "nas_switch.h"
+#include "event_log.h"
+#include "std_mutex_lock.h"
+#include "std_utils.h"
+#include "std_config_node.h"
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <exception>
+
+#define NAS_STATS_SHM_CFG_FILE "/etc/opx/nas_stats_shm.xml"
+
+static nas_stats_shm_t *_shm = nullptr;
+static auto &_shm_slots = *new std::unordered_map<hal_ifindex_t, size_t>;
+static auto &_shm_free = *new std::vector<size_t>;
+static auto &_shm_ids = *new std::vector<ndi_stat_id_t>;
+static std_mutex_lock_create_static_init_fast(_shm_lock);
+static unsigned int _shm_interval_secs = NAS_STATS_SHM_DEF_INTERVAL_SECS;
+
+static uint64_t nas_stats_shm_now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/* Must be called with _shm_lock held */
+static void nas_stats_shm_entry_write(size_t ix, hal_ifindex_t ifindex, const char *if_name,
+                                      const uint64_t *values, size_t n)
+{
+    nas_stats_shm_entry_t *e = &_shm->entry[ix];
+    /* seq is odd only if a writer stopped in the middle of an update */
+    uint32_t seq = e->seq & ~1u;
+
+    __atomic_store_n(&e->seq, seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    __atomic_store_n(&e->if_index, ifindex, __ATOMIC_RELAXED);
+    safestrncpy(e->if_name, (if_name != nullptr) ? if_name : "", sizeof(e->if_name));
+    e->time_stamp = (ifindex != 0) ? nas_stats_shm_now() : 0;
+    if (values != nullptr) {
+        memcpy(e->cnt, values, n * sizeof(uint64_t));
+    } else {
+        memset(e->cnt, 0, sizeof(e->cnt));
+    }
+
+    __atomic_store_n(&e->seq, seq + 2, __ATOMIC_RELEASE);
+}
+
+/* Must be called with _shm_lock held */
+static bool nas_stats_shm_slot_get(hal_ifindex_t ifindex, size_t *ix)
+{
+    auto it = _shm_slots.find(ifindex);
+    if (it != _shm_slots.end()) {
+        *ix = it->second;
+        return true;
+    }
+    if (!_shm_free.empty()) {
+        *ix = _shm_free.back();
+        _shm_free.pop_back();
+    } else if (_shm->hdr.n_if < NAS_STATS_SHM_MAX_IF) {
+        *ix = _shm->hdr.n_if;
+        __atomic_store_n(&_shm->hdr.n_if, _shm->hdr.n_if + 1, __ATOMIC_RELEASE);
+    } else {
+        EV_LOGGING(NAS_INT_STATS, DEBUG, "NAS-STAT-SHM", "No free entry for interface %d", ifindex);
+        return false;
+    }
+    _shm_slots[ifindex] = *ix;
+    return true;
+}
+
+void nas_stats_shm_update(hal_ifindex_t ifindex, const char *if_name, const uint64_t *values, size_t n)
+{
+    std_mutex_simple_lock_guard lg(&_shm_lock);
+    if ((_shm == nullptr) || (ifindex == 0)) {
+        return;
+    }
+    size_t ix;
+    if (nas_stats_shm_slot_get(ifindex, &ix)) {
+        nas_stats_shm_entry_write(ix, ifindex, if_name, values, std::min<size_t>(n, _shm->hdr.n_cnt));
+    }
+}
+
+bool nas_stats_shm_port_read(hal_ifindex_t ifindex, const char *if_name, npu_id_t npu, npu_port_t port,
+                        const uint64_t *ids, uint64_t *values, size_t n, uint64_t max_age_ms)
+{
+    bool cached = false;
+    {
+        std_mutex_simple_lock_guard lg(&_shm_lock);
+        cached = (_shm != nullptr) && (n == _shm_ids.size()) &&
+                 std::equal(_shm_ids.begin(), _shm_ids.end(), ids);
+        if (cached) {
+            auto it = _shm_slots.find(ifindex);
+            if (it != _shm_slots.end()) {
+                const nas_stats_shm_entry_t *e = &_shm->entry[it->second];
+                if (nas_stats_shm_now() - e->time_stamp <= max_age_ms * 1000000ULL) {
+                    memcpy(values, e->cnt, n * sizeof(uint64_t));
+                    return true;
+                }
+            }
+        }
+    }
+    if (ndi_port_stats_get(npu, port, (ndi_stat_id_t *)ids, values, n) != STD_ERR_OK) {
+        return false;
+    }
+    if (cached) {
+        nas_stats_shm_update(ifindex, if_name, values, n);
+    }
+    return true;
+}
+
+/* Free the entries of the interfaces that were not seen, must be called with _shm_lock held */
+static void nas_stats_shm_release_unseen(const std::unordered_set<hal_ifindex_t> &seen)
+{
+    for (auto it = _shm_slots.begin(); it != _shm_slots.end(); ) {
+        if (seen.find(it->first) != seen.end()) {
+            ++it;
+            continue;
+        }
+        nas_stats_shm_entry_write(it->second, 0, nullptr, nullptr, 0);
+        _shm_free.push_back(it->second);
+        it = _shm_slots.erase(it);
+    }
+}
+
+static void nas_stats_shm_sampler(void)
+{
+    std::vector<uint64_t> values(_shm_ids.size());
+    std::unordered_set<hal_ifindex_t> seen;
+
+    while (true) {
+        std::this_thread::sleep_for(std::chrono::seconds(_shm_interval_secs));
+
+        seen.clear();
+        npu_id_t npu_max = (npu_id_t)nas_switch_get_max_npus();
+        for (npu_id_t npu = 0; npu < npu_max; ++npu) {
+            npu_port_t cpu_port = 0;
+            bool has_cpu_port = (ndi_cpu_port_get(npu, &cpu_port) == STD_ERR_OK);
+            unsigned int max_ports = ndi_max_npu_port_get(npu);
+
+            for (port_t port = 0; port < max_ports; ++port) {
+                if (!ndi_port_is_valid(npu, port) || (has_cpu_port && (port == cpu_port))) {
+                    continue;
+                }
+                interface_ctrl_t intf_ctrl;
+                memset(&intf_ctrl, 0, sizeof(interface_ctrl_t));
+                intf_ctrl.q_type = HAL_INTF_INFO_FROM_PORT;
+                intf_ctrl.npu_id = npu;
+                intf_ctrl.port_id = port;
+                if ((dn_hal_get_interface_info(&intf_ctrl) != STD_ERR_OK) ||
+                    (intf_ctrl.int_type != nas_int_type_PORT)) {
+                    continue;
+                }
+                /* A port streamed within the last half interval is not read again */
+                if (!nas_stats_shm_port_read(intf_ctrl.if_index, intf_ctrl.if_name, npu, port, &_shm_ids[0],
+                                        &values[0], values.size(), _shm_interval_secs * 1000 / 2)) {
+                    continue;
+                }
+                seen.insert(intf_ctrl.if_index);
+            }
+        }
+
+        std_mutex_simple_lock_guard lg(&_shm_lock);
+        nas_stats_shm_release_unseen(seen);
+    }
+}
+
+static unsigned int nas_stats_shm_interval_cfg(void)
+{
+    unsigned int interval = NAS_STATS_SHM_DEF_INTERVAL_SECS;
+
+    std_config_hdl_t _hdl = std_config_load(NAS_STATS_SHM_CFG_FILE);
+    if (_hdl == NULL) {
+        EV_LOGGING(NAS_INT_STATS, INFO, "NAS-STAT-SHM", "Config file not loaded, sampler interval %u",
+                   interval);
+        return interval;
+    }
+    std_config_node_t _node = std_config_get_root(_hdl);
+    if (_node != NULL) {
+        for (_node = std_config_get_child(_node); _node != NULL; _node = std_config_next_node(_node)) {
+            const char *_interval = std_config_attr_get(_node, "interval");
+            if (_interval != NULL) {
+                interval = strtoul(_interval, NULL, 0);
+                break;
+            }
+        }
+    }
+    std_config_unload(_hdl);
+    return interval;
+}
+
+t_std_error nas_stats_shm_init(const uint64_t *ids, size_t n_ids)
+{
+    if (n_ids == 0) {
+        return STD_ERR(INTERFACE, PARAM, 0);
+    }
+    int fd = shm_open(NAS_STATS_SHM_NAME, O_CREAT | O_RDWR, 0644);
+    if (fd < 0) {
+        EV_LOGGING(NAS_INT_STATS, ERR, "NAS-STAT-SHM", "Failed to open %s errno %d",
+                   NAS_STATS_SHM_NAME, errno);
+        return STD_ERR(INTERFACE, FAIL, errno);
+    }
+    if (ftruncate(fd, sizeof(nas_stats_shm_t)) != 0) {
+        EV_LOGGING(NAS_INT_STATS, ERR, "NAS-STAT-SHM", "Failed to size %s errno %d",
+                   NAS_STATS_SHM_NAME, errno);
+        close(fd);
+        return STD_ERR(INTERFACE, FAIL, errno);
+    }
+    void *p = mmap(NULL, sizeof(nas_stats_shm_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED) {
+        EV_LOGGING(NAS_INT_STATS, ERR, "NAS-STAT-SHM", "Failed to map %s errno %d",
+                   NAS_STATS_SHM_NAME, errno);
+        return STD_ERR(INTERFACE, FAIL, errno);
+    }
+
+    if (n_ids > NAS_STATS_SHM_MAX_CNT) {
+        EV_LOGGING(NAS_INT_STATS, ERR, "NAS-STAT-SHM", "Only %d of %lu counters exported",
+                   NAS_STATS_SHM_MAX_CNT, n_ids);
+        n_ids = NAS_STATS_SHM_MAX_CNT;
+    }
+
+    std_mutex_simple_lock_guard lg(&_shm_lock);
+    if (_shm != nullptr) {
+        munmap(p, sizeof(nas_stats_shm_t));
+        return STD_ERR_OK;
+    }
+    _shm = (nas_stats_shm_t *)p;
+
+    /* A table left by an earlier run is cleared, readers that still map it keep working */
+    __atomic_store_n(&_shm->hdr.magic, 0, __ATOMIC_RELEASE);
+    size_t n_if = std::min<size_t>(_shm->hdr.n_if, NAS_STATS_SHM_MAX_IF);
+    __atomic_store_n(&_shm->hdr.n_cnt, n_ids, __ATOMIC_RELEASE);
+    for (size_t ix = 0; ix < n_if; ++ix) {
+        nas_stats_shm_entry_write(ix, 0, nullptr, nullptr, 0);
+    }
+    _shm->hdr.version = NAS_STATS_SHM_VERSION;
+    _shm->hdr.max_if = NAS_STATS_SHM_MAX_IF;
+    _shm->hdr.max_cnt = NAS_STATS_SHM_MAX_CNT;
+    memset(_shm->hdr.cnt_ids, 0, sizeof(_shm->hdr.cnt_ids));
+    memcpy(_shm->hdr.cnt_ids, ids, n_ids * sizeof(uint64_t));
+    __atomic_store_n(&_shm->hdr.n_if, 0, __ATOMIC_RELEASE);
+    __atomic_store_n(&_shm->hdr.magic, NAS_STATS_SHM_MAGIC, __ATOMIC_RELEASE);
+    _shm_ids.assign(ids, ids + n_ids);
+
+    /* Without the sampler entries are only written by statistics gets and streaming */
+    _shm_interval_secs = nas_stats_shm_interval_cfg();
+    if (_shm_interval_secs > 0) {
+        try {
+            std::thread(nas_stats_shm_sampler).detach();
+        } catch (std::exception &e) {
+            EV_LOGGING(NAS_INT_STATS, ERR, "NAS-STAT-SHM", "Failed to start the sampler: %s", e.what());
+        }
+    }
+    EV_LOGGING(NAS_INT_STATS, INFO, "NAS-STAT-SHM", "Interface statistics exported in %s, %lu counters",
+               NAS_STATS_SHM_NAME, n_ids);
+    return STD_ERR_OK;
+}
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+
+/*
+ * filename: nas_stats_shm_reader.c
+ */
+
+#include "nas_stats_shm.h"
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sched.h>
+#include <string.h>
+
+#define NAS_STATS_SHM_READ_RETRIES 1000
+
+const nas_stats_shm_t *nas_stats_shm_open(void)
+{
+    int fd = shm_open(NAS_STATS_SHM_NAME, O_RDONLY, 0);
+    if (fd < 0) {
+        return NULL;
+    }
+    struct stat st;
+    if ((fstat(fd, &st) != 0) || ((size_t)st.st_size < sizeof(nas_stats_shm_t))) {
+        close(fd);
+        return NULL;
+    }
+    void *p = mmap(NULL, sizeof(nas_stats_shm_t), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED) {
+        return NULL;
+    }
+
+    const nas_stats_shm_t *shm = (const nas_stats_shm_t *)p;
+    if ((__atomic_load_n(&shm->hdr.magic, __ATOMIC_ACQUIRE) != NAS_STATS_SHM_MAGIC) ||
+        (shm->hdr.version != NAS_STATS_SHM_VERSION)) {
+        munmap(p, sizeof(nas_stats_shm_t));
+        return NULL;
+    }
+    return shm;
+}
+
+void nas_stats_shm_close(const nas_stats_shm_t *shm)
+{
+    if (shm != NULL) {
+        munmap((void *)shm, sizeof(nas_stats_shm_t));
+    }
+}
+
+size_t nas_stats_shm_counters(const nas_stats_shm_t *shm, const uint64_t **ids)
+{
+    *ids = shm->hdr.cnt_ids;
+    return __atomic_load_n(&shm->hdr.n_cnt, __ATOMIC_ACQUIRE);
+}
+
+size_t nas_stats_shm_entries(const nas_stats_shm_t *shm)
+{
+    return __atomic_load_n(&shm->hdr.n_if, __ATOMIC_ACQUIRE);
+}
+
+bool nas_stats_shm_read(const nas_stats_shm_t *shm, size_t ix, nas_stats_shm_entry_t *entry)
+{
+    if (ix >= NAS_STATS_SHM_MAX_IF) {
+        return false;
+    }
+    const nas_stats_shm_entry_t *e = &shm->entry[ix];
+    size_t len = offsetof(nas_stats_shm_entry_t, cnt) +
+                 __atomic_load_n(&shm->hdr.n_cnt, __ATOMIC_ACQUIRE) * sizeof(uint64_t);
+
+    size_t retry;
+    for (retry = 0; retry < NAS_STATS_SHM_READ_RETRIES; ++retry) {
+        uint32_t seq = __atomic_load_n(&e->seq, __ATOMIC_ACQUIRE);
+        if (seq & 1) {
+            sched_yield();
+            continue;
+        }
+        memcpy(entry, e, len);
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&e->seq, __ATOMIC_RELAXED) == seq) {
+            return entry->if_index != 0;
+        }
+    }
+    return false;
+}
+
+bool nas_stats_shm_read_if(const nas_stats_shm_t *shm, int32_t if_index, nas_stats_shm_entry_t *entry)
+{
+    size_t n_if = nas_stats_shm_entries(shm);
+    size_t ix;
+    for (ix = 0; ix < n_if; ++ix) {
+        if ((__atomic_load_n(&shm->entry[ix].if_index, __ATOMIC_RELAXED) == if_index) &&
+            nas_stats_shm_read(shm, ix, entry) && (entry->if_index == if_index)) {
+            return true;
+        }
+    }
+    return false;
+}
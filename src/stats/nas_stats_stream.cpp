@@ -0,0 +1,492 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+
+/*
+ * filename: nas_stats_stream.cpp
+ *
+ * Push based streaming of interface statistics. A subscription names interfaces,
+ * counters and an interval; every interval one CPS event carries the counter
+ * deltas of all its interfaces. The counters of an interface are read once per
+ * tick for all the subscriptions that are due, through the statistics shared
+ * memory table so the table sampler does not read them again. A counter delta that
+ * reaches the threshold of the counter raises a separate event for that interface.
+ *
+ * Both events use the same layout, the deltas of an interface are embedded under
+ * IF_INDEX.<ifindex> along with the interface name. Interval events have the SET
+ * operation, threshold events the ACTION operation and only the counters that
+ * reached their threshold.
+ *
+ * Subscriptions are also made over CPS, on the interface statistics object with the
+ * TARGET qualifier. CREATE subscribes and DELETE removes the subscription with the
+ * same attributes. The object names each interface with an IF_INTERFACES_STATE_INTERFACE_NAME
+ * instance, carries the interval in seconds in STATISTICS_TIME_STAMP and has an
+ * attribute for each counter to stream, its value being the threshold or 0. Without
+ * counter attributes all port counters are streamed.
+ */
+
+#include "dell-base-if.h"
+#include "dell-interface.h"
+#include "ietf-interfaces.h"
+#include "hal_if_mapping.h"
+
+#include "cps_api_events.h"
+#include "cps_api_object_key.h"
+#include "cps_class_map.h"
+#include "event_log.h"
+#include "nas_ndi_port.h"
+#include "nas_stats.h"
+#include "std_config_node.h"
+#include "std_mutex_lock.h"
+#include "std_utils.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <ctype.h>
+#include <algorithm>
+#include <exception>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <chrono>
+#include <unordered_map>
+#include <vector>
+
+#define NAS_STATS_STREAM_CFG_FILE   "/etc/opx/nas_stats_stream.xml"
+#define NAS_STATS_STREAM_TICK_SECS  1
+
+/* Operation of the interval events and of the threshold events */
+#define NAS_STATS_STREAM_EV_OP        cps_api_oper_SET
+#define NAS_STATS_STREAM_THRESH_EV_OP cps_api_oper_ACTION
+
+typedef struct {
+    std::vector<uint64_t> last;  /* counter values of the previous sample */
+    std::vector<bool>     above; /* counter delta was at or above its threshold */
+} nas_stats_stream_if_t;
+
+typedef struct {
+    std::vector<std::string> if_names;
+    std::vector<size_t>      cnt_ix;     /* index of each counter in the port counter list */
+    std::vector<uint64_t>    thresholds; /* delta per interval of each counter, 0 for none */
+    unsigned int             interval_secs;
+    uint64_t                 next_tick;
+    std::unordered_map<std::string, nas_stats_stream_if_t> ifs;
+} nas_stats_stream_state_t;
+
+typedef struct {
+    bool                  valid;
+    hal_ifindex_t         ifindex;
+    std::vector<uint64_t> values;
+} nas_stats_stream_sample_t;
+
+static auto &_stream_ids = *new std::vector<ndi_stat_id_t>;
+static auto &_stream_subs = *new std::map<uint32_t, nas_stats_stream_state_t>;
+static uint32_t _stream_next_id = 1;
+static uint64_t _stream_tick = 0;
+static bool _stream_running = false;
+static std_mutex_lock_create_static_init_fast(_stream_lock);
+
+static void nas_stats_stream_obj_init(cps_api_object_t obj, cps_api_operation_types_t op)
+{
+    cps_api_key_from_attr_with_qual(cps_api_object_key(obj),
+                                    DELL_BASE_IF_CMN_IF_INTERFACES_STATE_INTERFACE_STATISTICS_OBJ,
+                                    cps_api_qualifier_OBSERVED);
+    cps_api_object_set_type_operation(cps_api_object_key(obj), op);
+    cps_api_object_attr_add_u32(obj, DELL_BASE_IF_CMN_IF_INTERFACES_STATE_INTERFACE_STATISTICS_TIME_STAMP,
+                                time(NULL));
+}
+
+/* Read the counters of an interface once per tick, called with _stream_lock held */
+static const nas_stats_stream_sample_t &nas_stats_stream_sample(const std::string &name,
+                                std::unordered_map<std::string, nas_stats_stream_sample_t> &samples)
+{
+    auto it = samples.find(name);
+    if (it != samples.end()) {
+        return it->second;
+    }
+    nas_stats_stream_sample_t &s = samples[name];
+    s.valid = false;
+
+    interface_ctrl_t intf_ctrl;
+    memset(&intf_ctrl, 0, sizeof(interface_ctrl_t));
+    intf_ctrl.q_type = HAL_INTF_INFO_FROM_IF_NAME;
+    safestrncpy(intf_ctrl.if_name, name.c_str(), sizeof(intf_ctrl.if_name));
+    if ((dn_hal_get_interface_info(&intf_ctrl) != STD_ERR_OK) ||
+        (intf_ctrl.int_type != nas_int_type_PORT)) {
+        return s;
+    }
+    s.values.resize(_stream_ids.size());
+    /* Values the shared memory sampler read within the tick are used as they are */
+    if (!nas_stats_shm_port_read(intf_ctrl.if_index, name.c_str(), intf_ctrl.npu_id, intf_ctrl.port_id,
+                            &_stream_ids[0], &s.values[0], s.values.size(),
+                            NAS_STATS_STREAM_TICK_SECS * 1000)) {
+        return s;
+    }
+    s.ifindex = intf_ctrl.if_index;
+    s.valid = true;
+    return s;
+}
+
+static void nas_stats_stream_threshold_publish(hal_ifindex_t ifindex, const std::string &name,
+                                               uint64_t cnt_id, uint64_t delta)
+{
+    cps_api_object_guard og(cps_api_object_create());
+    if (!og.valid()) {
+        return;
+    }
+    nas_stats_stream_obj_init(og.get(), NAS_STATS_STREAM_THRESH_EV_OP);
+    cps_api_attr_id_t ids[3] = {IF_INTERFACES_STATE_INTERFACE_IF_INDEX, (cps_api_attr_id_t)ifindex,
+                                (cps_api_attr_id_t)cnt_id};
+    const int ids_len = sizeof(ids)/sizeof(ids[0]);
+    cps_api_object_e_add(og.get(), ids, ids_len, cps_api_object_ATTR_T_U64, &delta, sizeof(delta));
+    ids[2] = IF_INTERFACES_STATE_INTERFACE_NAME;
+    cps_api_object_e_add(og.get(), ids, ids_len, cps_api_object_ATTR_T_BIN, name.c_str(), name.size() + 1);
+
+    EV_LOGGING(NAS_INT_STATS, INFO, "NAS-STAT-STREAM", "Counter %lu of %s reached threshold, delta %lu",
+               cnt_id, name.c_str(), delta);
+    cps_api_event_thread_publish(og.get());
+}
+
+/* Publish the deltas of a subscription, the first sample of an interface is only its base line */
+static void nas_stats_stream_run_sub(nas_stats_stream_state_t &sub,
+                                     std::unordered_map<std::string, nas_stats_stream_sample_t> &samples)
+{
+    cps_api_object_guard og(cps_api_object_create());
+    if (!og.valid()) {
+        return;
+    }
+    nas_stats_stream_obj_init(og.get(), NAS_STATS_STREAM_EV_OP);
+
+    size_t n_if = 0;
+    for (auto &name : sub.if_names) {
+        const nas_stats_stream_sample_t &s = nas_stats_stream_sample(name, samples);
+        if (!s.valid) {
+            sub.ifs.erase(name);
+            continue;
+        }
+        nas_stats_stream_if_t &st = sub.ifs[name];
+        bool base_line = st.last.empty();
+        if (base_line) {
+            st.last.resize(sub.cnt_ix.size());
+            st.above.assign(sub.cnt_ix.size(), false);
+        }
+
+        cps_api_attr_id_t ids[3] = {IF_INTERFACES_STATE_INTERFACE_IF_INDEX, (cps_api_attr_id_t)s.ifindex, 0};
+        const int ids_len = sizeof(ids)/sizeof(ids[0]);
+        for (size_t ix = 0; ix < sub.cnt_ix.size(); ++ix) {
+            uint64_t val = s.values[sub.cnt_ix[ix]];
+            /* a counter below its previous value was cleared */
+            uint64_t delta = (val >= st.last[ix]) ? (val - st.last[ix]) : val;
+            st.last[ix] = val;
+            if (base_line) {
+                continue;
+            }
+            ids[2] = _stream_ids[sub.cnt_ix[ix]];
+            cps_api_object_e_add(og.get(), ids, ids_len, cps_api_object_ATTR_T_U64, &delta, sizeof(delta));
+
+            if (sub.thresholds[ix] == 0) {
+                continue;
+            }
+            bool above = (delta >= sub.thresholds[ix]);
+            if (above && !st.above[ix]) {
+                nas_stats_stream_threshold_publish(s.ifindex, name, _stream_ids[sub.cnt_ix[ix]], delta);
+            }
+            st.above[ix] = above;
+        }
+        if (!base_line) {
+            ids[2] = IF_INTERFACES_STATE_INTERFACE_NAME;
+            cps_api_object_e_add(og.get(), ids, ids_len, cps_api_object_ATTR_T_BIN,
+                                 name.c_str(), name.size() + 1);
+            ++n_if;
+        }
+    }
+    if (n_if != 0) {
+        cps_api_event_thread_publish(og.get());
+    }
+}
+
+static void nas_stats_stream_run(void)
+{
+    std::unordered_map<std::string, nas_stats_stream_sample_t> samples;
+    while (true) {
+        std::this_thread::sleep_for(std::chrono::seconds(NAS_STATS_STREAM_TICK_SECS));
+
+        std_mutex_simple_lock_guard lg(&_stream_lock);
+        ++_stream_tick;
+        samples.clear();
+        for (auto &it : _stream_subs) {
+            nas_stats_stream_state_t &sub = it.second;
+            if (_stream_tick < sub.next_tick) {
+                continue;
+            }
+            sub.next_tick = _stream_tick + sub.interval_secs;
+            nas_stats_stream_run_sub(sub, samples);
+        }
+    }
+}
+
+/* Subscription state of a request, called with _stream_lock held */
+static t_std_error nas_stats_stream_state_init(const nas_stats_stream_sub_t *sub,
+                                               nas_stats_stream_state_t &state)
+{
+    if ((sub == NULL) || (sub->if_names == NULL) || (sub->n_if == 0) || (sub->interval_secs == 0) ||
+        ((sub->n_cnt != 0) && (sub->cnt_ids == NULL))) {
+        return STD_ERR(INTERFACE, PARAM, 0);
+    }
+    if (_stream_ids.empty()) {
+        return STD_ERR(INTERFACE, FAIL, 0);
+    }
+    for (size_t ix = 0; ix < sub->n_if; ++ix) {
+        state.if_names.push_back(sub->if_names[ix]);
+    }
+    state.interval_secs = sub->interval_secs;
+
+    if (sub->n_cnt == 0) {
+        for (size_t ix = 0; ix < _stream_ids.size(); ++ix) {
+            state.cnt_ix.push_back(ix);
+        }
+    } else {
+        for (size_t ix = 0; ix < sub->n_cnt; ++ix) {
+            auto it = std::find(_stream_ids.begin(), _stream_ids.end(), sub->cnt_ids[ix]);
+            if (it == _stream_ids.end()) {
+                EV_LOGGING(NAS_INT_STATS, ERR, "NAS-STAT-STREAM", "Counter %lu is not a port counter",
+                           sub->cnt_ids[ix]);
+                return STD_ERR(INTERFACE, PARAM, 0);
+            }
+            state.cnt_ix.push_back(it - _stream_ids.begin());
+        }
+    }
+    state.thresholds.assign(state.cnt_ix.size(), 0);
+    if ((sub->thresholds != NULL) && (sub->n_cnt != 0)) {
+        state.thresholds.assign(sub->thresholds, sub->thresholds + sub->n_cnt);
+    }
+    return STD_ERR_OK;
+}
+
+/* Id of the subscription with the same request, called with _stream_lock held */
+static bool nas_stats_stream_find(const nas_stats_stream_state_t &state, uint32_t *sub_id)
+{
+    for (auto &it : _stream_subs) {
+        const nas_stats_stream_state_t &sub = it.second;
+        if ((sub.interval_secs == state.interval_secs) && (sub.if_names == state.if_names) &&
+            (sub.cnt_ix == state.cnt_ix) && (sub.thresholds == state.thresholds)) {
+            *sub_id = it.first;
+            return true;
+        }
+    }
+    return false;
+}
+
+t_std_error nas_stats_stream_subscribe(const nas_stats_stream_sub_t *sub, uint32_t *sub_id)
+{
+    nas_stats_stream_state_t state;
+
+    std_mutex_simple_lock_guard lg(&_stream_lock);
+    t_std_error rc = nas_stats_stream_state_init(sub, state);
+    if (rc != STD_ERR_OK) {
+        return rc;
+    }
+    /* The base line is taken at the next tick */
+    state.next_tick = _stream_tick + 1;
+
+    if (!_stream_running) {
+        try {
+            std::thread(nas_stats_stream_run).detach();
+        } catch (std::exception &e) {
+            EV_LOGGING(NAS_INT_STATS, ERR, "NAS-STAT-STREAM", "Failed to start streaming: %s", e.what());
+            return STD_ERR(INTERFACE, FAIL, 0);
+        }
+        _stream_running = true;
+    }
+    *sub_id = _stream_next_id++;
+    _stream_subs[*sub_id] = std::move(state);
+    EV_LOGGING(NAS_INT_STATS, INFO, "NAS-STAT-STREAM", "Subscription %u: %lu interfaces every %u secs",
+               *sub_id, sub->n_if, sub->interval_secs);
+    return STD_ERR_OK;
+}
+
+t_std_error nas_stats_stream_unsubscribe(uint32_t sub_id)
+{
+    std_mutex_simple_lock_guard lg(&_stream_lock);
+    if (_stream_subs.erase(sub_id) == 0) {
+        return STD_ERR(INTERFACE, PARAM, 0);
+    }
+    return STD_ERR_OK;
+}
+
+/* Subscribe or unsubscribe from a CPS request, see the file header for its attributes */
+static cps_api_return_code_t nas_stats_stream_cps_write(void *context, cps_api_transaction_params_t *param,
+                                                        size_t ix)
+{
+    cps_api_object_t obj = cps_api_object_list_get(param->change_list, ix);
+    if (obj == NULL) {
+        return cps_api_ret_code_ERR;
+    }
+    cps_api_operation_types_t op = cps_api_object_type_operation(cps_api_object_key(obj));
+    if ((op != cps_api_oper_CREATE) && (op != cps_api_oper_DELETE)) {
+        EV_LOGGING(NAS_INT_STATS, ERR, "NAS-STAT-STREAM", "Invalid operation %d for a subscription", op);
+        return (cps_api_return_code_t)STD_ERR(INTERFACE, PARAM, 0);
+    }
+
+    cps_api_object_attr_t interval_attr = cps_api_object_attr_get(obj,
+                                DELL_BASE_IF_CMN_IF_INTERFACES_STATE_INTERFACE_STATISTICS_TIME_STAMP);
+    std::vector<const char *> if_names;
+    std::vector<uint64_t> cnt_ids, thresholds;
+
+    cps_api_object_it_t it;
+    cps_api_object_it_begin(obj, &it);
+    for ( ; cps_api_object_it_valid(&it); cps_api_object_it_next(&it)) {
+        cps_api_attr_id_t id = cps_api_object_attr_id(it.attr);
+        if (id == IF_INTERFACES_STATE_INTERFACE_NAME) {
+            if_names.push_back((const char *)cps_api_object_attr_data_bin(it.attr));
+        } else if ((id != DELL_BASE_IF_CMN_IF_INTERFACES_STATE_INTERFACE_STATISTICS_TIME_STAMP) &&
+                   (cps_api_object_attr_len(it.attr) == sizeof(uint64_t))) {
+            cnt_ids.push_back(id);
+            thresholds.push_back(cps_api_object_attr_data_u64(it.attr));
+        }
+    }
+    if ((interval_attr == nullptr) || if_names.empty()) {
+        EV_LOGGING(NAS_INT_STATS, ERR, "NAS-STAT-STREAM", "Subscription without interval or interfaces");
+        return (cps_api_return_code_t)STD_ERR(INTERFACE, PARAM, 0);
+    }
+
+    nas_stats_stream_sub_t sub;
+    memset(&sub, 0, sizeof(sub));
+    sub.if_names = &if_names[0];
+    sub.n_if = if_names.size();
+    sub.cnt_ids = cnt_ids.empty() ? NULL : &cnt_ids[0];
+    sub.thresholds = thresholds.empty() ? NULL : &thresholds[0];
+    sub.n_cnt = cnt_ids.size();
+    sub.interval_secs = cps_api_object_attr_data_u32(interval_attr);
+
+    uint32_t sub_id = 0;
+    {
+        std_mutex_simple_lock_guard lg(&_stream_lock);
+        nas_stats_stream_state_t state;
+        t_std_error rc = nas_stats_stream_state_init(&sub, state);
+        if (rc != STD_ERR_OK) {
+            return (cps_api_return_code_t)rc;
+        }
+        bool found = nas_stats_stream_find(state, &sub_id);
+        if (op == cps_api_oper_DELETE) {
+            if (!found) {
+                return (cps_api_return_code_t)STD_ERR(INTERFACE, PARAM, 0);
+            }
+            _stream_subs.erase(sub_id);
+            EV_LOGGING(NAS_INT_STATS, INFO, "NAS-STAT-STREAM", "Subscription %u removed", sub_id);
+            return cps_api_ret_code_OK;
+        }
+        if (found) {
+            return cps_api_ret_code_OK;
+        }
+    }
+    return (cps_api_return_code_t)nas_stats_stream_subscribe(&sub, &sub_id);
+}
+
+static std::vector<std::string> nas_stats_stream_cfg_list(const char *str)
+{
+    std::vector<std::string> list;
+    if (str == NULL) {
+        return list;
+    }
+    std::stringstream ss(str);
+    std::string tok;
+    while (std::getline(ss, tok, ',')) {
+        tok.erase(std::remove_if(tok.begin(), tok.end(), ::isspace), tok.end());
+        if (!tok.empty()) {
+            list.push_back(tok);
+        }
+    }
+    return list;
+}
+
+/* Subscriptions from the config file, see scripts/nas_stats_stream.xml */
+static void nas_stats_stream_cfg_load(void)
+{
+    std_config_hdl_t _hdl = std_config_load(NAS_STATS_STREAM_CFG_FILE);
+    if (_hdl == NULL) {
+        return;
+    }
+    std_config_node_t _node = std_config_get_root(_hdl);
+    if (_node == NULL) {
+        std_config_unload(_hdl);
+        return;
+    }
+    for (_node = std_config_get_child(_node); _node != NULL; _node = std_config_next_node(_node)) {
+        const char *interval = std_config_attr_get(_node, "interval");
+        auto if_list = nas_stats_stream_cfg_list(std_config_attr_get(_node, "interfaces"));
+        auto cnt_list = nas_stats_stream_cfg_list(std_config_attr_get(_node, "counters"));
+        auto thr_list = nas_stats_stream_cfg_list(std_config_attr_get(_node, "thresholds"));
+        if ((interval == NULL) || if_list.empty()) {
+            continue;
+        }
+
+        std::vector<const char *> if_names;
+        for (auto &name : if_list) {
+            if_names.push_back(name.c_str());
+        }
+        std::vector<uint64_t> cnt_ids, thresholds;
+        for (size_t ix = 0; ix < cnt_list.size(); ++ix) {
+            cnt_ids.push_back(strtoull(cnt_list[ix].c_str(), NULL, 0));
+            thresholds.push_back((ix < thr_list.size()) ? strtoull(thr_list[ix].c_str(), NULL, 0) : 0);
+        }
+
+        nas_stats_stream_sub_t sub;
+        memset(&sub, 0, sizeof(sub));
+        sub.if_names = &if_names[0];
+        sub.n_if = if_names.size();
+        sub.cnt_ids = cnt_ids.empty() ? NULL : &cnt_ids[0];
+        sub.thresholds = thresholds.empty() ? NULL : &thresholds[0];
+        sub.n_cnt = cnt_ids.size();
+        sub.interval_secs = strtoul(interval, NULL, 0);
+
+        uint32_t sub_id;
+        if (nas_stats_stream_subscribe(&sub, &sub_id) != STD_ERR_OK) {
+            EV_LOGGING(NAS_INT_STATS, ERR, "NAS-STAT-STREAM", "Invalid subscription in %s",
+                       NAS_STATS_STREAM_CFG_FILE);
+        }
+    }
+    std_config_unload(_hdl);
+}
+
+t_std_error nas_stats_stream_init(cps_api_operation_handle_t handle, const uint64_t *ids, size_t n_ids)
+{
+    if (n_ids == 0) {
+        return STD_ERR(INTERFACE, PARAM, 0);
+    }
+    {
+        std_mutex_simple_lock_guard lg(&_stream_lock);
+        _stream_ids.assign(ids, ids + n_ids);
+    }
+    nas_stats_stream_cfg_load();
+
+    cps_api_registration_functions_t f;
+    memset(&f, 0, sizeof(f));
+    if (!cps_api_key_from_attr_with_qual(&f.key,
+                DELL_BASE_IF_CMN_IF_INTERFACES_STATE_INTERFACE_STATISTICS_OBJ,
+                cps_api_qualifier_TARGET)) {
+        return STD_ERR(INTERFACE, FAIL, 0);
+    }
+    f.handle = handle;
+    f._write_function = nas_stats_stream_cps_write;
+    if (cps_api_register(&f) != cps_api_ret_code_OK) {
+        EV_LOGGING(NAS_INT_STATS, ERR, "NAS-STAT-STREAM", "Failed to register the subscription handler");
+        return STD_ERR(INTERFACE, FAIL, 0);
+    }
+    return STD_ERR_OK;
+}
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "nas_packet_meta.h"
+#include <string.h>
+#include <gtest/gtest.h>
+
+static constexpr size_t BUF_SZ = 1024;
+
+TEST(meta_fixed_test, all_fields)
+{
+    uint8_t buf[BUF_SZ];
+    nas_pkt_meta_fixed_t meta = {};
+    meta.fields = NAS_PKT_META_F_RX_PORT | NAS_PKT_META_F_TX_PORT | NAS_PKT_META_F_PKT_LEN |
+                  NAS_PKT_META_F_SAMPLE_COUNT | NAS_PKT_META_F_TRAP_ID | NAS_PKT_META_F_RX_LAG |
+                  NAS_PKT_META_F_RX_VLAN | NAS_PKT_META_F_VRF_ID | NAS_PKT_META_F_RX_TIMESTAMP |
+                  NAS_PKT_META_F_RULE_ID;
+    meta.rx_port = 45;
+    meta.tx_port = 50;
+    meta.pkt_len = 4;
+    meta.sample_count = 0x100000001ULL;
+    meta.trap_id = 0x200000002ULL;
+    meta.rx_lag = 60;
+    meta.rx_vlan = 100;
+    meta.vrf_id = 1;
+    meta.rx_timestamp = 1500000000123456789ULL;
+    meta.rule_id = 0x300000003ULL;
+
+    nas_pkt_meta_attr_it_t pos;
+    ASSERT_TRUE(nas_pkt_meta_fixed_encode (buf, sizeof(buf), &meta, &pos));
+
+    nas_pkt_meta_fixed_t out;
+    ASSERT_TRUE(nas_pkt_meta_fixed_decode (buf, &out));
+    EXPECT_EQ(meta.fields, out.fields);
+    EXPECT_EQ(meta.rx_port, out.rx_port);
+    EXPECT_EQ(meta.tx_port, out.tx_port);
+    EXPECT_EQ(meta.pkt_len, out.pkt_len);
+    EXPECT_EQ(meta.sample_count, out.sample_count);
+    EXPECT_EQ(meta.trap_id, out.trap_id);
+    EXPECT_EQ(meta.rx_lag, out.rx_lag);
+    EXPECT_EQ(meta.rx_vlan, out.rx_vlan);
+    EXPECT_EQ(meta.vrf_id, out.vrf_id);
+    EXPECT_EQ(meta.rx_timestamp, out.rx_timestamp);
+    EXPECT_EQ(meta.rule_id, out.rule_id);
+}
+
+TEST(meta_fixed_test, only_set_fields)
+{
+    uint8_t buf[BUF_SZ];
+    nas_pkt_meta_fixed_t meta = {};
+    meta.fields = NAS_PKT_META_F_RX_PORT | NAS_PKT_META_F_PKT_LEN | NAS_PKT_META_F_RULE_ID;
+    meta.rx_port = 45;
+    meta.pkt_len = 4;
+    meta.tx_port = 50;      /* not flagged, must not be sent */
+    meta.rule_id = 7;
+
+    nas_pkt_meta_attr_it_t pos;
+    ASSERT_TRUE(nas_pkt_meta_fixed_encode (buf, sizeof(buf), &meta, &pos));
+    ASSERT_TRUE(nas_pkt_meta_add_str (&pos, NAS_PKT_META_RX_IF_NAME, "e101-001-0"));
+    uint8_t pkt[] = {0xbe, 0xef, 0xf0, 0x0d};
+    size_t meta_len = sizeof(buf) - pos.len;
+    memcpy (buf + meta_len, pkt, sizeof(pkt));
+
+    /* Consumers walking the attributes see only the fields that were set */
+    nas_pkt_meta_attr_it_t it;
+    size_t found = 0;
+    for (nas_pkt_meta_it_begin (buf, &it); nas_pkt_meta_it_valid (&it);
+         nas_pkt_meta_it_next (&it)) {
+        switch (nas_pkt_meta_attr_type (it.attr)) {
+            case NAS_PKT_META_LAYOUT: break;
+            case NAS_PKT_META_RX_PORT:
+                EXPECT_EQ(45, nas_pkt_meta_attr_data_uint (it.attr)); ++found; break;
+            case NAS_PKT_META_PKT_LEN:
+                EXPECT_EQ(4, nas_pkt_meta_attr_data_uint (it.attr)); ++found; break;
+            case NAS_PKT_META_RULE_ID:
+                EXPECT_EQ(7, nas_pkt_meta_attr_data_uint (it.attr)); ++found; break;
+            case NAS_PKT_META_RX_IF_NAME:
+                EXPECT_STREQ("e101-001-0", (char*)nas_pkt_meta_attr_data_bin (it.attr));
+                ++found; break;
+            default:
+                ADD_FAILURE() << "Unexpected attribute " << nas_pkt_meta_attr_type (it.attr);
+        }
+    }
+    EXPECT_EQ(4, found);
+    EXPECT_EQ(0, memcmp (nas_pkt_data_offset (buf), pkt, sizeof(pkt)));
+
+    nas_pkt_meta_fixed_t out;
+    ASSERT_TRUE(nas_pkt_meta_fixed_decode (buf, &out));
+    EXPECT_EQ(meta.fields, out.fields);
+    EXPECT_EQ(45, out.rx_port);
+    EXPECT_EQ(4, out.pkt_len);
+    EXPECT_EQ(7, out.rule_id);
+    EXPECT_EQ(0, out.tx_port);
+}
+
+TEST(meta_fixed_test, attribute_header)
+{
+    /* A header built attribute by attribute is decoded by walking it */
+    uint8_t buf[BUF_SZ];
+    nas_pkt_meta_attr_it_t it;
+    nas_pkt_meta_buf_init (buf, sizeof(buf), &it);
+    nas_pkt_meta_add_u32 (&it, NAS_PKT_META_RX_PORT, 45);
+    nas_pkt_meta_add_u32 (&it, NAS_PKT_META_TX_PORT, 50);
+    nas_pkt_meta_add_u64 (&it, NAS_PKT_META_SAMPLE_COUNT, 0);
+    nas_pkt_meta_add_u32 (&it, NAS_PKT_META_PKT_LEN, 4);
+
+    nas_pkt_meta_fixed_t out;
+    ASSERT_TRUE(nas_pkt_meta_fixed_decode (buf, &out));
+    EXPECT_EQ(NAS_PKT_META_F_RX_PORT | NAS_PKT_META_F_TX_PORT | NAS_PKT_META_F_SAMPLE_COUNT |
+              NAS_PKT_META_F_PKT_LEN, out.fields);
+    EXPECT_EQ(45, out.rx_port);
+    EXPECT_EQ(50, out.tx_port);
+    EXPECT_EQ(0, out.sample_count);
+    EXPECT_EQ(4, out.pkt_len);
+}
+
+TEST(meta_fixed_test, short_buffer)
+{
+    uint8_t buf[BUF_SZ];
+    nas_pkt_meta_fixed_t meta = {};
+    meta.fields = NAS_PKT_META_F_RX_PORT | NAS_PKT_META_F_RX_TIMESTAMP;
+
+    nas_pkt_meta_attr_it_t pos;
+    EXPECT_FALSE(nas_pkt_meta_fixed_encode (buf, 16, &meta, &pos));
+    EXPECT_TRUE(pos.attr == NULL);
+}
+
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/*
+ * filename: nas_stats_shm_ut.cpp
+ */
+
+#include "nas_stats_shm.h"
+#include <stdio.h>
+#include <string.h>
+#include <memory>
+#include <gtest/gtest.h>
+
+/* The reader only needs the table layout, so a table in local memory stands in
+ * for the shared memory one */
+static std::unique_ptr<nas_stats_shm_t> nas_stats_shm_test_table(void)
+{
+    std::unique_ptr<nas_stats_shm_t> shm(new nas_stats_shm_t);
+    memset(shm.get(), 0, sizeof(nas_stats_shm_t));
+    shm->hdr.magic = NAS_STATS_SHM_MAGIC;
+    shm->hdr.version = NAS_STATS_SHM_VERSION;
+    shm->hdr.max_if = NAS_STATS_SHM_MAX_IF;
+    shm->hdr.max_cnt = NAS_STATS_SHM_MAX_CNT;
+    shm->hdr.n_cnt = 2;
+    shm->hdr.cnt_ids[0] = 100;
+    shm->hdr.cnt_ids[1] = 101;
+
+    const int32_t if_index[] = {10, 0, 30};
+    for (size_t ix = 0; ix < sizeof(if_index)/sizeof(if_index[0]); ++ix) {
+        nas_stats_shm_entry_t *e = &shm->entry[ix];
+        e->seq = 2;
+        e->if_index = if_index[ix];
+        snprintf(e->if_name, sizeof(e->if_name), "e101-%03d-0", (int)ix + 1);
+        e->cnt[0] = if_index[ix] * 10;
+        e->cnt[1] = if_index[ix] * 10 + 1;
+        e->cnt[2] = 0xdead;     /* not in use, must not be copied */
+    }
+    shm->hdr.n_if = 3;
+    return shm;
+}
+
+TEST(stats_shm_test, counters)
+{
+    auto shm = nas_stats_shm_test_table();
+    const uint64_t *ids = nullptr;
+    ASSERT_EQ(2, nas_stats_shm_counters(shm.get(), &ids));
+    EXPECT_EQ(100, ids[0]);
+    EXPECT_EQ(101, ids[1]);
+    EXPECT_EQ(3, nas_stats_shm_entries(shm.get()));
+}
+
+TEST(stats_shm_test, read)
+{
+    auto shm = nas_stats_shm_test_table();
+    nas_stats_shm_entry_t entry;
+    memset(&entry, 0, sizeof(entry));
+
+    ASSERT_TRUE(nas_stats_shm_read(shm.get(), 0, &entry));
+    EXPECT_EQ(10, entry.if_index);
+    EXPECT_STREQ("e101-001-0", entry.if_name);
+    EXPECT_EQ(100, entry.cnt[0]);
+    EXPECT_EQ(101, entry.cnt[1]);
+    EXPECT_EQ(0, entry.cnt[2]);
+
+    /* Free entry, out of range index */
+    EXPECT_FALSE(nas_stats_shm_read(shm.get(), 1, &entry));
+    EXPECT_FALSE(nas_stats_shm_read(shm.get(), NAS_STATS_SHM_MAX_IF, &entry));
+
+    /* An entry left in the middle of an update is not returned */
+    shm->entry[2].seq = 3;
+    EXPECT_FALSE(nas_stats_shm_read(shm.get(), 2, &entry));
+    shm->entry[2].seq = 4;
+    EXPECT_TRUE(nas_stats_shm_read(shm.get(), 2, &entry));
+}
+
+TEST(stats_shm_test, read_if)
+{
+    auto shm = nas_stats_shm_test_table();
+    nas_stats_shm_entry_t entry;
+
+    ASSERT_TRUE(nas_stats_shm_read_if(shm.get(), 30, &entry));
+    EXPECT_EQ(30, entry.if_index);
+    EXPECT_STREQ("e101-003-0", entry.if_name);
+    EXPECT_EQ(300, entry.cnt[0]);
+    EXPECT_EQ(301, entry.cnt[1]);
+
+    EXPECT_FALSE(nas_stats_shm_read_if(shm.get(), 20, &entry));
+
+    /* Entries at and above the entry count are not scanned */
+    shm->hdr.n_if = 2;
+    EXPECT_FALSE(nas_stats_shm_read_if(shm.get(), 30, &entry));
+}
+
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+
+    return RUN_ALL_TESTS();
+}
@@ -42,6 +42,7 @@
 #include "nas_if_utils.h"
 #include "nas_int_base_if.h"
 
+#include <algorithm>
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
@@ -156,19 +157,10 @@ void nas_handle_bridge_mac(nas_bridge_t *b_node)
 
 static std::pair<bool, bool> nas_get_intf_packet_drop(hal_ifindex_t ifindex)
 {
-    int untagged_cnt = 0, tagged_cnt = 0;
-    auto master_cb = [&untagged_cnt, &tagged_cnt](if_master_info_t m_info) {
-        if (m_info.type != nas_int_type_VLAN) {
-            return;
-        }
-        if (m_info.mode == NAS_PORT_UNTAGGED || m_info.mode == NAS_PORT_HYBRID) {
-            untagged_cnt ++;
-        }
-        if (m_info.mode == NAS_PORT_TAGGED || m_info.mode == NAS_PORT_HYBRID) {
-            tagged_cnt ++;
-        }
-    };
-    nas_intf_master_callback(ifindex, master_cb);
+    /*  counts are kept by the master table, -1 if the interface has no masters */
+    auto untag_tag_cnt = nas_intf_untag_tag_count(ifindex);
+    int untagged_cnt = std::max(untag_tag_cnt.first, 0);
+    int tagged_cnt = std::max(untag_tag_cnt.second, 0);
     EV_LOGGING(INTERFACE, INFO, "NAS-Vlan", "Interface with ifindex %d is untagged member of %d bridges and \
 tagged member of %d bridges",
                ifindex, untagged_cnt, tagged_cnt);
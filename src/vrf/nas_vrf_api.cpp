@@ -33,9 +33,166 @@
 #include "std_utils.h"
 #include "nas_vrf_utils.h"
 #include "nas_int_com_utils.h"
+#include "std_mutex_lock.h"
+
+#include <string>
+#include <set>
+#include <vector>
+#include <unordered_map>
 
 static cps_api_event_service_handle_t         _handle;
 
+/*
+ * Interface to VRF binding index, kept from the bind/unbind publish so interface
+ * VRF gets and the interfaces of a VRF need a single router interface lookup.
+ * An interface deleted without unbind leaves its entry behind, so each entry is
+ * checked against the router interface it names before use and dropped once its
+ * ifindex resolves to another interface.
+ */
+typedef struct {
+    std::string   vrf_name;
+    std::string   rt_if_name;
+    hal_vrf_id_t  rt_vrf_id;
+    hal_ifindex_t rt_if_index;
+} nas_vrf_intf_bind_t;
+
+static std::unordered_map<std::string, nas_vrf_intf_bind_t> _vrf_intf_binds;
+static std::unordered_map<std::string, std::set<std::string>> _vrf_intf_members;
+static std_mutex_lock_create_static_init_fast(_vrf_bind_lock);
+
+static void nas_vrf_intf_bind_index_del(const std::string &if_name) {
+    auto it = _vrf_intf_binds.find(if_name);
+    if (it == _vrf_intf_binds.end()) return;
+
+    auto mit = _vrf_intf_members.find(it->second.vrf_name);
+    if (mit != _vrf_intf_members.end()) {
+        mit->second.erase(if_name);
+        if (mit->second.empty()) _vrf_intf_members.erase(mit);
+    }
+    _vrf_intf_binds.erase(it);
+}
+
+static void nas_vrf_intf_bind_index_update(const char *vrf_name, const char *if_name,
+                                           const nas_vrf_intf_bind_t *bind) {
+    std_mutex_simple_lock_guard lg(&_vrf_bind_lock);
+    nas_vrf_intf_bind_index_del(if_name);
+    if (bind != nullptr) {
+        _vrf_intf_binds[if_name] = *bind;
+        _vrf_intf_members[vrf_name].insert(if_name);
+    }
+}
+
+static void nas_vrf_intf_bind_index_vrf_del(const char *vrf_name) {
+    std_mutex_simple_lock_guard lg(&_vrf_bind_lock);
+    auto mit = _vrf_intf_members.find(vrf_name);
+    if (mit == _vrf_intf_members.end()) return;
+    for (auto &if_name : mit->second) {
+        _vrf_intf_binds.erase(if_name);
+    }
+    _vrf_intf_members.erase(mit);
+}
+
+/* Drop the entry of if_name if it is still the one found stale */
+static void nas_vrf_intf_bind_index_stale(const std::string &if_name, const nas_vrf_intf_bind_t &bind) {
+    std_mutex_simple_lock_guard lg(&_vrf_bind_lock);
+    auto it = _vrf_intf_binds.find(if_name);
+    if ((it == _vrf_intf_binds.end()) || (it->second.vrf_name != bind.vrf_name) ||
+        (it->second.rt_if_index != bind.rt_if_index)) {
+        return;
+    }
+    NAS_VRF_LOG_DEBUG("VRF-INTF-GET", "Stale VRF binding of %s dropped", if_name.c_str());
+    nas_vrf_intf_bind_index_del(if_name);
+}
+
+/*
+ * Look up the router interface of a binding. Fails if it does not resolve, which is also the
+ * case right after a bind until the router interface is registered from the OS event, or if
+ * the ifindex now belongs to another interface; only the latter sets replaced.
+ */
+static bool nas_vrf_intf_bind_rt_intf_get(const nas_vrf_intf_bind_t &bind, interface_ctrl_t &intf_ctrl,
+                                          bool *replaced) {
+    *replaced = false;
+    memset(&intf_ctrl, 0, sizeof(interface_ctrl_t));
+    intf_ctrl.q_type = HAL_INTF_INFO_FROM_IF;
+    intf_ctrl.vrf_id = bind.rt_vrf_id;
+    intf_ctrl.if_index = bind.rt_if_index;
+
+    if (dn_hal_get_interface_info(&intf_ctrl) != STD_ERR_OK) {
+        return false;
+    }
+    *replaced = (bind.rt_if_name != intf_ctrl.if_name);
+    return !*replaced;
+}
+
+static cps_api_return_code_t nas_vrf_intf_bind_add_obj(cps_api_object_list_t list, const std::string &if_name,
+                                                       const nas_vrf_intf_bind_t &bind,
+                                                       const interface_ctrl_t &rt_intf_ctrl) {
+    cps_api_object_t obj = cps_api_object_create();
+    if(obj == NULL){
+        NAS_VRF_LOG_ERR("VRF-INTF-GET", "Failed to allocate memory to cps object");
+        return cps_api_ret_code_ERR;
+    }
+
+    cps_api_key_t key;
+    cps_api_key_from_attr_with_qual(&key, NI_IF_INTERFACES_INTERFACE_OBJ,
+                                    cps_api_qualifier_TARGET);
+    cps_api_object_set_key(obj,&key);
+
+    cps_api_object_attr_add(obj,NI_IF_INTERFACES_INTERFACE_BIND_NI_NAME, bind.vrf_name.c_str(),
+                            bind.vrf_name.size()+1);
+    cps_api_object_attr_add(obj,IF_INTERFACES_INTERFACE_NAME, if_name.c_str(), if_name.size()+1);
+    cps_api_object_attr_add(obj, VRF_MGMT_NI_IF_INTERFACES_INTERFACE_IFNAME, bind.rt_if_name.c_str(),
+                            bind.rt_if_name.size()+1);
+    cps_api_object_attr_add_u32(obj,VRF_MGMT_NI_IF_INTERFACES_INTERFACE_IFINDEX, bind.rt_if_index);
+    cps_api_object_attr_add(obj, VRF_MGMT_NI_IF_INTERFACES_INTERFACE_MAC_ADDR, (const void *)rt_intf_ctrl.mac_addr,
+                            strlen(rt_intf_ctrl.mac_addr)+1);
+
+    if (!cps_api_object_list_append(list,obj)) {
+        cps_api_object_delete(obj);
+        NAS_VRF_LOG_ERR("VRF-INTF-GET", "Object append to list is failed for %s", if_name.c_str());
+        return cps_api_ret_code_ERR;
+    }
+    return cps_api_ret_code_OK;
+}
+
+/*
+ * This function provides the bound interfaces of a VRF, or of all VRFs if vrf_name is NULL.
+ * Only interfaces bound with the bind RPC are listed, ports that are in the default VRF
+ * without an explicit bind are not.
+ */
+cps_api_return_code_t nas_vrf_get_all_intf_info(cps_api_object_list_t list, const char *vrf_name) {
+    std::vector<std::pair<std::string, nas_vrf_intf_bind_t>> binds;
+    {
+        std_mutex_simple_lock_guard lg(&_vrf_bind_lock);
+        auto add_vrf = [&](const std::set<std::string> &members) {
+            for (auto &if_name : members) {
+                auto it = _vrf_intf_binds.find(if_name);
+                if (it != _vrf_intf_binds.end()) binds.push_back(*it);
+            }
+        };
+        if (vrf_name != nullptr) {
+            auto mit = _vrf_intf_members.find(vrf_name);
+            if (mit != _vrf_intf_members.end()) add_vrf(mit->second);
+        } else {
+            for (auto &members : _vrf_intf_members) add_vrf(members.second);
+        }
+    }
+
+    for (auto &bind : binds) {
+        interface_ctrl_t intf_ctrl;
+        bool replaced;
+        if (!nas_vrf_intf_bind_rt_intf_get(bind.second, intf_ctrl, &replaced)) {
+            /*  Not resolved yet is left for a later get, only a reused ifindex drops the entry */
+            if (replaced) nas_vrf_intf_bind_index_stale(bind.first, bind.second);
+            continue;
+        }
+        if (nas_vrf_intf_bind_add_obj(list, bind.first, bind.second, intf_ctrl) != cps_api_ret_code_OK) {
+            return cps_api_ret_code_ERR;
+        }
+    }
+    return cps_api_ret_code_OK;
+}
+
 t_std_error nas_vrf_create_publish_handle() {
     if (cps_api_event_client_connect(&_handle) != cps_api_ret_code_OK) {
         NAS_VRF_LOG_ERR("VRF-PUB", "Failed to create the handle for event publish!");
@@ -54,7 +211,28 @@ cps_api_return_code_t nas_vrf_publish_event(cps_api_object_t msg) {
 /* This function provides parent interface to router interface mapping */
 cps_api_return_code_t nas_vrf_get_intf_info(cps_api_object_list_t list, const char *vrf_name,
                                             const char *if_name) {
+    nas_vrf_intf_bind_t bind;
+    bool bound = false;
+    {
+        std_mutex_simple_lock_guard lg(&_vrf_bind_lock);
+        auto it = _vrf_intf_binds.find(if_name);
+        if (it != _vrf_intf_binds.end()) {
+            bind = it->second;
+            bound = true;
+        }
+    }
+
     interface_ctrl_t intf_ctrl;
+    if (bound) {
+        bool replaced;
+        if (nas_vrf_intf_bind_rt_intf_get(bind, intf_ctrl, &replaced)) {
+            if ((vrf_name != nullptr) && (bind.vrf_name != vrf_name)) {
+                return cps_api_ret_code_ERR;
+            }
+            return nas_vrf_intf_bind_add_obj(list, if_name, bind, intf_ctrl);
+        }
+        if (replaced) nas_vrf_intf_bind_index_stale(if_name, bind);
+    }
 
     memset(&intf_ctrl, 0, sizeof(interface_ctrl_t));
     intf_ctrl.q_type = HAL_INTF_INFO_FROM_IF_NAME;
@@ -212,25 +390,15 @@ bool nas_vrf_update_vrf_id(const char *vrf_name, bool is_add) {
     /* Dont create VRF object for out of band management VRF */
     if (strncmp(vrf_name, NAS_MGMT_VRF_NAME, sizeof(NAS_MGMT_VRF_NAME)) != 0) {
         if (is_add) {
-            ndi_vr_entry_t  vr_entry;
-            /* Create a virtual router entry and get vr_id (maps to fib vrf id) */
-            memset (&vr_entry, 0, sizeof (ndi_vr_entry_t));
-
-            nas_switch_wait_for_sys_base_mac(&vr_entry.src_mac);
-
-            /*
-             * Set system MAC address for the VRs
-             */
-            vr_entry.flags = NDI_VR_ATTR_SRC_MAC_ADDRESS;
-
-            if ((rc = ndi_route_vr_create(&vr_entry, &vrf_info.vrf_id))!= STD_ERR_OK) {
+            /* Get a virtual router entry (maps to fib vrf id), from the VR pool when available */
+            if ((rc = nas_vrf_vr_alloc(&vrf_info.vrf_id))!= STD_ERR_OK) {
                 NAS_VRF_LOG_ERR("VRF-ID", "VRF oid creation failed for VRF:%s", vrf_name);
                 return false;
             }
         } else {
             nas_obj_id_t ndi_vr_id = 0;
             if (nas_get_vrf_obj_id_from_vrf_name(vrf_name, &ndi_vr_id) == STD_ERR_OK) {
-                if ((rc = ndi_route_vr_delete(0, ndi_vr_id))!= STD_ERR_OK) {
+                if ((rc = nas_vrf_vr_free(ndi_vr_id))!= STD_ERR_OK) {
                     NAS_VRF_LOG_ERR("VRF-ID", "VRF oid deletion failed for VRF:%s VRFF id 0x%lx", vrf_name, ndi_vr_id);
                     return false;
                 }
@@ -238,9 +406,15 @@ bool nas_vrf_update_vrf_id(const char *vrf_name, bool is_add) {
             }
         }
     }
+    if (!is_add) {
+        nas_vrf_intf_bind_index_vrf_del(vrf_name);
+    }
     safestrncpy(vrf_info.vrf_name, vrf_name, sizeof(vrf_info.vrf_name));
     if (nas_update_vrf_info((is_add ? NAS_VRF_OP_ADD : NAS_VRF_OP_DEL), &vrf_info) != STD_ERR_OK) {
         NAS_VRF_LOG_ERR("VRF-ID-GET", "VRF oid update failed for VRF:%s is_add:%d", vrf_name, is_add);
+        if (is_add && vrf_info.vrf_id) {
+            nas_vrf_vr_free(vrf_info.vrf_id);
+        }
         return false;
     }
     return true;
@@ -405,7 +579,9 @@ static cps_api_return_code_t nas_vrf_publish_intf_bind(cps_api_object_t vrf_intf
     cps_api_object_attr_add(obj,NI_IF_INTERFACES_INTERFACE_BIND_NI_NAME, vrf_name, strlen(vrf_name)+1);
     cps_api_object_attr_add(obj,IF_INTERFACES_INTERFACE_NAME, if_name, strlen(if_name)+1);
 
-    if (op != BASE_CMN_OPERATION_TYPE_DELETE) {
+    if (op == BASE_CMN_OPERATION_TYPE_DELETE) {
+        nas_vrf_intf_bind_index_update(vrf_name, if_name, nullptr);
+    } else {
         cps_api_object_attr_t if_index_attr = cps_api_object_attr_get(vrf_intf_obj, VRF_MGMT_INTF_BIND_NI_OUTPUT_IFINDEX);
         const char *rt_if_name = (const char *)cps_api_object_get_data(vrf_intf_obj,
                                                                        VRF_MGMT_INTF_BIND_NI_OUTPUT_IFNAME);
@@ -422,6 +598,16 @@ static cps_api_return_code_t nas_vrf_publish_intf_bind(cps_api_object_t vrf_intf
                                     cps_api_object_attr_data_u32(if_index_attr));
         cps_api_object_attr_add(obj, VRF_MGMT_NI_IF_INTERFACES_INTERFACE_MAC_ADDR, (const void *)rt_mac_addr,
                                 strlen(rt_mac_addr)+1);
+
+        nas_vrf_intf_bind_t bind;
+        bind.vrf_name = vrf_name;
+        bind.rt_if_name = rt_if_name;
+        bind.rt_if_index = cps_api_object_attr_data_u32(if_index_attr);
+        if (nas_get_vrf_internal_id_from_vrf_name(vrf_name, &bind.rt_vrf_id) == STD_ERR_OK) {
+            nas_vrf_intf_bind_index_update(vrf_name, if_name, &bind);
+        } else {
+            nas_vrf_intf_bind_index_update(vrf_name, if_name, nullptr);
+        }
     }
     if (nas_vrf_publish_event(obj) != cps_api_ret_code_OK) {
         NAS_VRF_LOG_ERR("NAS-RT-CPS-SET", "VRF publish failed!");
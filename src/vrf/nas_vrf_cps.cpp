@@ -45,6 +45,12 @@ t_std_error nas_vrf_init(void) {
         return STD_ERR(ROUTE,FAIL,0);
     }
 
+    /* Start pre-creating the VR objects for the VRFs */
+    if (nas_vrf_vr_pool_init() != STD_ERR_OK) {
+        NAS_VRF_LOG_ERR("NAS-RT-CPS", "VR pool initialisation failed!");
+        return STD_ERR(ROUTE,FAIL,0);
+    }
+
     /* Create the default VRF oid */
     if (nas_vrf_update_vrf_id(NAS_DEFAULT_VRF_NAME, true) == false) {
         NAS_VRF_LOG_ERR("NAS-RT-CPS", "Default VRF initialisation failed!");
@@ -195,8 +201,8 @@ static cps_api_return_code_t nas_vrf_cps_vrf_intf_get_func (void *ctx,
     const char *if_name  = (const char *)cps_api_object_get_data(filt, IF_INTERFACES_INTERFACE_NAME);
 
     if (if_name == nullptr) {
-        NAS_VRF_LOG_DEBUG("NAS-RT-CPS","No If-name, VRF-Intf get failed!");
-        return cps_api_ret_code_ERR;
+        /* All interfaces explicitly bound to the VRF, or to any VRF */
+        return nas_vrf_get_all_intf_info(param->list, vrf_name);
     }
 
     if((rc = nas_vrf_get_intf_info(param->list, vrf_name, if_name)) != STD_ERR_OK){
@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+
+/*
+ * filename: nas_vrf_vr_pool.cpp
+ *
+ * Pool of virtual router objects created ahead of VRF creation. A background
+ * thread keeps the pool filled up to the configured depth and VRF create takes an
+ * entry from the pool. All the VRs carry only the system MAC as source MAC, so
+ * they are interchangeable while unused. A VR released on VRF delete may still
+ * hold routes or router interfaces, so it is deleted and never put back.
+ */
+
+#include "event_log.h"
+#include "nas_vrf.h"
+#include "nas_switch.h"
+#include "nas_ndi_router_interface.h"
+#include "std_config_node.h"
+#include "hal_shell.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <chrono>
+
+#define NAS_VRF_CFG_FILE "/etc/opx/nas_vrf_config.xml"
+#define NAS_VRF_VR_POOL_RETRY_SECS 5
+
+static auto &_vr_pool_mtx = *new std::mutex;
+static auto &_vr_pool_cv = *new std::condition_variable;
+static auto &_vr_pool = *new std::deque<nas_obj_id_t>;
+static nas_vrf_vr_pool_stats_t _vr_pool_stats;
+static bool _vr_pool_started = false;
+
+static t_std_error nas_vrf_vr_create(nas_obj_id_t *vr_id) {
+    ndi_vr_entry_t  vr_entry;
+    memset (&vr_entry, 0, sizeof (ndi_vr_entry_t));
+
+    nas_switch_wait_for_sys_base_mac(&vr_entry.src_mac);
+
+    /*
+     * Set system MAC address for the VRs
+     */
+    vr_entry.flags = NDI_VR_ATTR_SRC_MAC_ADDRESS;
+
+    return ndi_route_vr_create(&vr_entry, vr_id);
+}
+
+static void nas_vrf_vr_pool_refill(void) {
+    std::unique_lock<std::mutex> lk(_vr_pool_mtx);
+    while (true) {
+        _vr_pool_cv.wait(lk, [] { return _vr_pool.size() < _vr_pool_stats.depth; });
+
+        lk.unlock();
+        nas_obj_id_t vr_id = 0;
+        t_std_error rc = nas_vrf_vr_create(&vr_id);
+        lk.lock();
+
+        if (rc != STD_ERR_OK) {
+            /* Expected while the VR table is full, keep retrying quietly */
+            NAS_VRF_LOG_DEBUG("VR-POOL", "VR pool refill failed rc:%d, retry in %d secs",
+                            rc, NAS_VRF_VR_POOL_RETRY_SECS);
+            _vr_pool_cv.wait_for(lk, std::chrono::seconds(NAS_VRF_VR_POOL_RETRY_SECS));
+            continue;
+        }
+        _vr_pool.push_back(vr_id);
+        ++_vr_pool_stats.created;
+        NAS_VRF_LOG_DEBUG("VR-POOL", "VR id 0x%lx added to pool, available:%lu",
+                          vr_id, _vr_pool.size());
+    }
+}
+
+static size_t nas_vrf_vr_pool_depth_cfg(void) {
+    size_t depth = NAS_VRF_VR_POOL_DEF_DEPTH;
+
+    std_config_hdl_t _hdl = std_config_load(NAS_VRF_CFG_FILE);
+    if (_hdl == NULL) {
+        NAS_VRF_LOG_INFO("VR-POOL", "VRF config file not loaded, VR pool depth:%lu", depth);
+        return depth;
+    }
+    std_config_node_t _node = std_config_get_root(_hdl);
+    if (_node != NULL) {
+        for (_node = std_config_get_child(_node); _node != NULL; _node = std_config_next_node(_node)) {
+            const char *_depth = std_config_attr_get(_node, "depth");
+            if (_depth != NULL) {
+                depth = strtoul(_depth, NULL, 0);
+                break;
+            }
+        }
+    }
+    std_config_unload(_hdl);
+    return depth;
+}
+
+static void nas_vrf_vr_pool_dump(std_parsed_string_t handle) {
+    nas_vrf_vr_pool_stats_t stats;
+    nas_vrf_vr_pool_stats_get(&stats);
+
+    uint64_t total = stats.hits + stats.misses;
+    printf("VR pool depth       : %lu\n", stats.depth);
+    printf("VR pool available   : %lu\n", stats.available);
+    printf("VR pool hits        : %lu\n", stats.hits);
+    printf("VR pool misses      : %lu\n", stats.misses);
+    printf("VR pool hit rate    : %lu%%\n", total ? (stats.hits * 100) / total : 0);
+    printf("VR pool created     : %lu\n", stats.created);
+    printf("VR pool released    : %lu\n", stats.released);
+}
+
+t_std_error nas_vrf_vr_pool_init(void) {
+    std::lock_guard<std::mutex> lg(_vr_pool_mtx);
+    if (_vr_pool_started) return STD_ERR_OK;
+
+    _vr_pool_stats.depth = nas_vrf_vr_pool_depth_cfg();
+    _vr_pool_started = true;
+
+    hal_shell_cmd_add("nas-vrf-vr-pool", nas_vrf_vr_pool_dump,
+                      "Displays the VRF virtual router pool depth and hit rate");
+
+    if (_vr_pool_stats.depth == 0) {
+        NAS_VRF_LOG_INFO("VR-POOL", "VR pool disabled");
+        return STD_ERR_OK;
+    }
+    std::thread(nas_vrf_vr_pool_refill).detach();
+    NAS_VRF_LOG_INFO("VR-POOL", "VR pool started with depth:%lu", _vr_pool_stats.depth);
+    return STD_ERR_OK;
+}
+
+t_std_error nas_vrf_vr_alloc(nas_obj_id_t *vr_id) {
+    {
+        std::lock_guard<std::mutex> lg(_vr_pool_mtx);
+        if (!_vr_pool.empty()) {
+            *vr_id = _vr_pool.front();
+            _vr_pool.pop_front();
+            ++_vr_pool_stats.hits;
+            _vr_pool_cv.notify_one();
+            return STD_ERR_OK;
+        }
+        ++_vr_pool_stats.misses;
+        _vr_pool_cv.notify_one();
+    }
+    /* Pool is empty or disabled, create the VR inline */
+    return nas_vrf_vr_create(vr_id);
+}
+
+t_std_error nas_vrf_vr_free(nas_obj_id_t vr_id) {
+    {
+        std::lock_guard<std::mutex> lg(_vr_pool_mtx);
+        ++_vr_pool_stats.released;
+    }
+    return ndi_route_vr_delete(0, vr_id);
+}
+
+void nas_vrf_vr_pool_stats_get(nas_vrf_vr_pool_stats_t *stats) {
+    std::lock_guard<std::mutex> lg(_vr_pool_mtx);
+    *stats = _vr_pool_stats;
+    stats->available = _vr_pool.size();
+}